@@ -0,0 +1,230 @@
+/*
+Title: Acrobot music clock check
+Description: Runs MusicClock on the host at 1 ms steps. Show time must never
+go backwards in any of these.
+
+1. Tap: the band plays 5% faster than the reference, six taps one or two
+   beats apart each land up to 5 ms off a beat, in 2000 runs. Over the four
+   beats after the last tap's catch-up, the show must be within 10 ms of the
+   band's beats in 95% of the runs; over eight, within 7 ms in half of them.
+2. Nudge: +0.5 bpm does not move the show at the nudge, then it runs at the
+   nudged rate.
+3. Hold: the show stands still while held and goes on from where it stopped,
+   at the rate it had.
+4. Tempo map: a change to twice the tempo is crossed without a jump, the
+   nudge still applies after it, and begin() past the change starts at its
+   tempo.
+
+Anything wrong exits with 1.
+
+Usage: clockCheck
+*/
+
+#include <musicClock.h>
+
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+const int TAPS = 6;
+const int TAP_JITTER = 5; // ms, either way
+const int TAP_RUNS = 2000;
+const int CHECKED_BEATS = 8;
+
+int failures = 0;
+
+void check(bool ok, const char *what, double value)
+{
+  printf("%s %s: %.2f\n", ok ? "ok  " : "FAIL", what, value);
+  if (!ok)
+  {
+    failures++;
+  }
+}
+
+// steps the clock a ms at a time from `from` to `to`, false if show time
+// went backwards; last holds the show time at `to`
+bool run(MusicClock &clock, uint32_t from, uint32_t to, uint32_t &last)
+{
+  bool forward = true;
+  last = clock.toShow(from);
+  for (uint32_t t = from + 1; t <= to; t++)
+  {
+    uint32_t show = clock.toShow(t);
+    forward = forward && (int32_t)(show - last) >= 0;
+    last = show;
+  }
+  return forward;
+}
+
+// a fixed pseudo-random sequence, so every run and every host gives the
+// same results
+uint32_t seed = 36;
+int jitter()
+{
+  seed = seed * 1103515245 + 12345;
+  return (int)(seed >> 16) % (2 * TAP_JITTER + 1) - TAP_JITTER;
+}
+
+// one run of taps; worst[i] is the worst beat error, in band ms, over the
+// i + 1 beats after the last tap's catch-up
+void tapRun(double *worst, bool &forward, float &tempo)
+{
+  const float REFERENCE = 120; // a beat every 500 show ms
+  const double BAND_BEAT = 500 / 1.05;
+
+  MusicClock clock;
+  clock.setTempoMap(REFERENCE);
+  clock.begin(0);
+
+  // every second tap skips a beat
+  uint32_t last;
+  uint32_t now = 0;
+  int beat = 0;
+  for (int i = 0; i < TAPS; i++)
+  {
+    beat += 1 + i % 2;
+    uint32_t at = lround(beat * BAND_BEAT) + jitter();
+    forward = run(clock, now, at, last) && forward;
+    clock.tap(at);
+    now = at;
+  }
+
+  for (int i = 0; i < CHECKED_BEATS; i++)
+  {
+    int checked = beat + 2 + i;
+    uint32_t at = lround(checked * BAND_BEAT);
+    forward = run(clock, now, at, last) && forward;
+    now = at;
+    // show ms off the beat, as band ms
+    double error = fabs(last - checked * 500.0) / clock.getRate();
+    worst[i] = i && worst[i - 1] > error ? worst[i - 1] : error;
+  }
+  tempo = clock.getTempo();
+}
+
+void checkTap()
+{
+  std::vector<double> worst[CHECKED_BEATS];
+  bool forward = true;
+  double worstTempo = 0;
+  for (int i = 0; i < TAP_RUNS; i++)
+  {
+    double runWorst[CHECKED_BEATS];
+    float tempo;
+    tapRun(runWorst, forward, tempo);
+    for (int beat = 0; beat < CHECKED_BEATS; beat++)
+    {
+      worst[beat].push_back(runWorst[beat]);
+    }
+    worstTempo = std::max(worstTempo, fabs(tempo - 126.0));
+  }
+  for (std::vector<double> &runs : worst)
+  {
+    std::sort(runs.begin(), runs.end());
+  }
+
+  // the tempo is a fit through the taps, its error grows the further the
+  // show gets from them; the rest are only reported
+  const std::vector<double> &four = worst[3];
+  const std::vector<double> &eight = worst[CHECKED_BEATS - 1];
+  check(forward, "tap: show never goes backwards", 0);
+  check(four[TAP_RUNS * 95 / 100] < 10, "tap: 4 beats on, worst error in 95% of runs, ms",
+        four[TAP_RUNS * 95 / 100]);
+  check(eight[TAP_RUNS / 2] < 7, "tap: 8 beats on, worst error in half the runs, ms",
+        eight[TAP_RUNS / 2]);
+  printf("     tap: 8 beats on, worst error in 95%% of runs: %.2f, in all: %.2f ms\n",
+         eight[TAP_RUNS * 95 / 100], eight.back());
+  check(worstTempo < 1, "tap: worst tempo error against 126 bpm", worstTempo);
+}
+
+void checkNudge()
+{
+  MusicClock clock;
+  clock.setTempoMap(100);
+  clock.begin(1000);
+
+  uint32_t before, after;
+  bool forward = run(clock, 1000, 5000, before);
+  clock.nudge(0.5f, 5000);
+  uint32_t at = clock.toShow(5000);
+  forward = run(clock, 5000, 15000, after) && forward;
+
+  check(forward, "nudge: show never goes backwards", 0);
+  check(at == before, "nudge: jump at the nudge, ms", (int32_t)(at - before));
+  double expected = 10000 * 100.5 / 100;
+  check(fabs((after - at) - expected) <= 1, "nudge: error after 10 s, ms",
+        (double)(after - at) - expected);
+}
+
+void checkHold()
+{
+  MusicClock clock;
+  clock.setTempoMap(100);
+  clock.begin(0);
+  clock.nudge(5, 0);
+
+  uint32_t held, stood, released, after;
+  run(clock, 0, 2000, held);
+  clock.hold(2000, true);
+  bool still = run(clock, 2000, 3000, stood) && stood == held;
+  bool stopped = clock.toShow(3000) == held;
+  clock.hold(3000, false);
+  released = clock.toShow(3000);
+  bool forward = run(clock, 3000, 5000, after);
+
+  check(still && stopped, "hold: show moves while held, ms", (int32_t)(stood - held));
+  check(released == held, "hold: jump at the release, ms", (int32_t)(released - held));
+  check(forward, "hold: show never goes backwards", 0);
+  double expected = 2000 * 105.0 / 100;
+  check(fabs((after - released) - expected) <= 1, "hold: error 2 s after the release, ms",
+        (double)(after - released) - expected);
+}
+
+void checkTempoMap()
+{
+  // twice the tempo from 4 s into the music on
+  static const struct_tempo_change changes[] = {{4000, 120}};
+
+  MusicClock clock;
+  clock.setTempoMap(60, changes, 1);
+  clock.begin(0);
+
+  uint32_t crossing, after;
+  bool forward = run(clock, 0, 4000, crossing);
+  uint32_t next = clock.toShow(4001);
+  forward = run(clock, 4001, 5000, after) && forward;
+  check(forward, "tempo map: show never goes backwards", 0);
+  check(crossing == 4000, "tempo map: show at the change, ms", crossing);
+  check(next - crossing <= 2, "tempo map: step across the change, ms", next - crossing);
+  check(after == 6000, "tempo map: show 1 s after the change, ms", after);
+
+  // the nudge is a factor, it carries over the change
+  clock.setTempoMap(60, changes, 1);
+  clock.begin(0);
+  clock.nudge(6, 0);
+  run(clock, 0, 10000, after);
+  double expected = 4000 + (10000 - 4000 / 1.1) * 2.2;
+  check(fabs(after - expected) <= 2, "tempo map: error of the nudge across the change, ms",
+        after - expected);
+
+  // a seek past the change starts at its tempo
+  clock.setTempoMap(60, changes, 1);
+  clock.resetNudge();
+  clock.begin(0, 8000);
+  run(clock, 0, 1000, after);
+  check(after == 2000, "tempo map: show 1 s after a seek past the change, ms", after);
+}
+
+int main()
+{
+  checkTap();
+  checkNudge();
+  checkHold();
+  checkTempoMap();
+
+  printf("%d failures\n", failures);
+  return failures ? 1 : 0;
+}
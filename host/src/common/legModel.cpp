@@ -0,0 +1,125 @@
+#include "legModel.h"
+
+#include <math.h>
+
+static const double RADIANS = M_PI / 180;
+
+LegPid::LegPid() : now(0), pid(Robot::Pwm::RANGE, 1)
+{
+  pid.setTunings(0, 0, 0);
+  pid.start(Angle());
+}
+
+void LegPid::setTunings(double kP, double kI, double kD)
+{
+  pid.setTunings(kP, kI, kD);
+}
+
+int32_t LegPid::compute(double setpoint, double input)
+{
+  pid.compute(Angle::fromDegrees(setpoint), Angle::fromDegrees(input), now++);
+  return pid.getOutput();
+}
+
+void LegPid::reset(double input)
+{
+  // off and on again, with the integral from a zero output
+  pid.stop();
+  pid.start(Angle::fromDegrees(input));
+}
+
+LegPlant::LegPlant(const PlantParameters &parameters)
+    : parameters(parameters), position(180), velocity(0), current(0)
+{
+}
+
+void LegPlant::reset(double position, double velocity)
+{
+  this->position = position;
+  this->velocity = velocity;
+  current = 0;
+}
+
+void LegPlant::step(int16_t duty, double dt)
+{
+  // the motor's inductance is left out, current follows the voltage at once
+  double voltage = parameters.supply * duty / Robot::Pwm::RANGE;
+  current = (voltage - parameters.backEmf * velocity) / parameters.resistance;
+  current = fmin(fmax(current, -parameters.stallCurrent), parameters.stallCurrent);
+
+  // Nm per A equals V s per rad
+  double torque = parameters.backEmf / RADIANS * current;
+  double omega = velocity * RADIANS;
+  torque -= parameters.viscous * omega;
+
+  // static friction holds the joint until the torque exceeds it
+  if (omega == 0 && fabs(torque) <= parameters.coulomb)
+  {
+    return;
+  }
+  double friction = copysign(parameters.coulomb, omega != 0 ? omega : torque);
+  double newOmega = omega + (torque - friction) / parameters.inertia * dt;
+  if (omega != 0 && (newOmega > 0) != (omega > 0))
+  {
+    newOmega = 0; // friction stops it, it does not reverse it
+  }
+
+  velocity = newOmega / RADIANS;
+  position += velocity * dt;
+}
+
+double LegPlant::getPosition()
+{
+  return position;
+}
+
+double LegPlant::getMeasured()
+{
+  return floor(position / parameters.encoderStep) * parameters.encoderStep;
+}
+
+double LegPlant::getVelocity()
+{
+  return velocity;
+}
+
+double LegPlant::getCurrent()
+{
+  return current;
+}
+
+SetpointRange::SetpointRange(uint32_t window) : window(window)
+{
+}
+
+void SetpointRange::add(uint32_t t, double value)
+{
+  while (!low.empty() && low.back().second >= value)
+  {
+    low.pop_back();
+  }
+  while (!high.empty() && high.back().second <= value)
+  {
+    high.pop_back();
+  }
+  low.push_back({t, value});
+  high.push_back({t, value});
+  while (t - low.front().first > window)
+  {
+    low.pop_front();
+  }
+  while (t - high.front().first > window)
+  {
+    high.pop_front();
+  }
+}
+
+double SetpointRange::getLow()
+{
+  return low.front().second;
+}
+
+double SetpointRange::getHigh()
+{
+  return high.front().second;
+}
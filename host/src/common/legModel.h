@@ -0,0 +1,90 @@
+#ifndef LEG_MODEL_H
+#define LEG_MODEL_H
+
+#include <intPid.h>
+#include <motorController.h>
+#include <robotProfile.h>
+
+#include <deque>
+#include <stdint.h>
+#include <utility>
+
+// The leg's control path and a model of one joint, for simulating shows on
+// the host. LegPid and legDuty() do what the leg's MotorControllers do in
+// leg/src/main.cpp, the plant is a DC gearmotor driving the leg. The
+// constants are the leg's, from Robot in shared/Robot/robotProfile.h.
+
+// the leg's IntPid, set up as pidInit() does and run every sample. Setpoints
+// and inputs in degrees go to the nearest count, and the output comes back
+// as IntPid's, for legDuty().
+class LegPid
+{
+public:
+  LegPid();
+  void setTunings(double kP, double kI, double kD); // per second, like SetTunings
+  int32_t compute(double setpoint, double input);
+  void reset(double input);
+
+private:
+  uint32_t now; // ms, one sample per compute()
+  IntPid pid;
+};
+
+// deadbandDuty() for joint 0 (right) or 1 (left), as controlMotorPID() has it
+inline int16_t legDuty(int joint, int32_t output, int16_t lastDuty)
+{
+  return joint ? deadbandDuty<Robot::Pwm, Robot::LeftLeg>(output, lastDuty)
+               : deadbandDuty<Robot::Pwm, Robot::RightLeg>(output, lastDuty);
+}
+
+// rough figures for a 12 V gearmotor on the joint, measure before trusting
+// absolute currents
+struct PlantParameters
+{
+  double supply = 12;        // V
+  double resistance = 2;     // ohm
+  double backEmf = 0.03;     // V per deg/s at the joint, 400 deg/s no-load
+  double inertia = 0.02;     // kg m2 at the joint, leg and reflected rotor
+  double viscous = 0.05;     // Nm per rad/s
+  double coulomb = 1.6;      // Nm, the static friction the deadband was tuned against
+  double stallCurrent = 6;   // A, what the driver and motor take
+  double encoderStep = 360. / 4096; // AS5600 resolution
+};
+
+// one joint, positions in degrees
+class LegPlant
+{
+public:
+  LegPlant(const PlantParameters &parameters);
+  void reset(double position, double velocity = 0);
+  // applies duty for dt seconds
+  void step(int16_t duty, double dt);
+
+  double getPosition();
+  double getMeasured(); // as the encoder reads it
+  double getVelocity(); // deg/s
+  double getCurrent();  // A, signed
+
+private:
+  PlantParameters parameters;
+  double position;
+  double velocity;
+  double current;
+};
+
+// smallest and largest setpoint over the last window ms. A joint outside it,
+// ahead of the setpoint in the direction the setpoint last moved, overshoots.
+class SetpointRange
+{
+public:
+  explicit SetpointRange(uint32_t window);
+  void add(uint32_t t, double value);
+  double getLow();
+  double getHigh();
+
+private:
+  uint32_t window;
+  std::deque<std::pair<uint32_t, double>> low, high;
+};
+
+#endif
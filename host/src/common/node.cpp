@@ -0,0 +1,89 @@
+#include "node.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+static uint32_t bootMillis = 0;
+
+bool parseNodeOptions(int argc, char **argv, NodeOptions &options)
+{
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    const char *name = argv[i];
+    double value = atof(argv[i + 1]);
+    if (!strcmp(name, "--loss"))
+    {
+      options.impairments.lossPercent = value;
+    }
+    else if (!strcmp(name, "--latency"))
+    {
+      options.impairments.latencyMicros = value;
+    }
+    else if (!strcmp(name, "--jitter"))
+    {
+      options.impairments.jitterMicros = value;
+    }
+    else if (!strcmp(name, "--reorder"))
+    {
+      options.impairments.reorderPercent = value;
+    }
+    else if (!strcmp(name, "--seconds"))
+    {
+      options.seconds = value;
+    }
+    else if (!strcmp(name, "--seed"))
+    {
+      options.impairments.seed = value;
+    }
+    else
+    {
+      fprintf(stderr, "unknown option %s\n", name);
+      return false;
+    }
+  }
+  if (argc % 2 == 0)
+  {
+    fprintf(stderr, "option %s needs a value\n", argv[argc - 1]);
+    return false;
+  }
+  return true;
+}
+
+void setBoot(uint32_t boot)
+{
+  bootMillis = boot;
+}
+
+uint32_t millis()
+{
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count() -
+         bootMillis;
+}
+
+uint32_t micros()
+{
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count() -
+         bootMillis * 1000;
+}
+
+void idle()
+{
+  std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+void printStats(const char *name, const UdpStats &stats, double seconds)
+{
+  printf("%s: sent %llu (%.0f/s), dropped %llu, received %llu (%.0f/s, %.1f kB/s), "
+         "missing %llu, reordered %llu, latency avg %.0f us max %u us\n",
+         name, (unsigned long long)stats.sent, stats.sent / seconds,
+         (unsigned long long)stats.dropped, (unsigned long long)stats.received,
+         stats.received / seconds, stats.receivedBytes / seconds / 1000,
+         (unsigned long long)stats.missing, (unsigned long long)stats.reordered,
+         stats.received ? (double)stats.latencyMicrosTotal / stats.received : 0.,
+         stats.latencyMicrosMax);
+}
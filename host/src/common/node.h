@@ -0,0 +1,34 @@
+#ifndef NODE_H
+#define NODE_H
+
+#include <udpTransport.h>
+
+#include <stdint.h>
+
+// Shared plumbing for the legNode and remoteNode link simulations.
+
+const uint8_t LEG_MAC[] = {0x94, 0xE6, 0x86, 0x00, 0xE0, 0xD0};
+const uint8_t REMOTE_MAC[] = {0x34, 0x94, 0x54, 0xBE, 0xDB, 0x6C};
+
+struct NodeOptions
+{
+  UdpImpairments impairments;
+  uint32_t seconds = 10;
+};
+
+// --loss %, --latency us, --jitter us, --reorder %, --seconds s, --seed n
+bool parseNodeOptions(int argc, char **argv, NodeOptions &options);
+
+// Both nodes count from the machine's monotonic clock, as if switched on at
+// different times, so either can tell what the other's millis() reads.
+const uint32_t REMOTE_BOOT = 0; // ms
+const uint32_t LEG_BOOT = 2500;
+void setBoot(uint32_t boot);
+
+uint32_t millis();
+uint32_t micros();
+void idle(); // short sleep between loop() iterations
+
+void printStats(const char *name, const UdpStats &stats, double seconds);
+
+#endif
@@ -0,0 +1,35 @@
+#include "serialPort.h"
+
+#include <stdio.h>
+#include <termios.h>
+
+static speed_t toSpeed(long baud)
+{
+  switch (baud)
+  {
+  case 115200:
+    return B115200;
+  case 230400:
+    return B230400;
+  case 460800:
+    return B460800;
+  case 921600:
+    return B921600;
+  default:
+    fprintf(stderr, "unsupported baud %ld, using 921600\n", baud);
+    return B921600;
+  }
+}
+
+void setRaw(int fd, long baud)
+{
+  termios tty;
+  if (tcgetattr(fd, &tty) != 0)
+  {
+    return;
+  }
+  cfmakeraw(&tty);
+  cfsetispeed(&tty, toSpeed(baud));
+  cfsetospeed(&tty, toSpeed(baud));
+  tcsetattr(fd, TCSANOW, &tty);
+}
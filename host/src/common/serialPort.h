@@ -0,0 +1,10 @@
+#ifndef SERIAL_PORT_H
+#define SERIAL_PORT_H
+
+// USB serial to the leg or remote, for the tools that talk to real hardware.
+
+// puts fd in raw mode at baud (115200..921600), does nothing if fd is not a
+// tty, e.g. a capture file
+void setRaw(int fd, long baud);
+
+#endif
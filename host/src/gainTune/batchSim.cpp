@@ -0,0 +1,123 @@
+#include "batchSim.h"
+
+#include <math.h>
+
+static const float SAMPLE_SECONDS = 0.001f;
+static const float RADIANS = M_PI / 180;
+static const uint8_t SUBSTEPS = 4;
+static const float SETTLE_BAND = 2; // degrees
+
+BatchSim::BatchSim(const PlantParameters &parameters, uint8_t deadband)
+    : parameters(parameters), deadband(deadband)
+{
+}
+
+void BatchSim::resize(size_t count)
+{
+  for (std::vector<float> *field : {&squaredError, &overshoot, &energy, &kp, &ki, &kd, &outputSum,
+                                    &lastInput, &position, &velocity})
+  {
+    field->assign(count, 0);
+  }
+  lastUnsettled.assign(count, 0);
+  duty.assign(count, 0);
+}
+
+size_t BatchSim::size()
+{
+  return kp.size();
+}
+
+void BatchSim::setGains(size_t lane, float kP, float kI, float kD)
+{
+  kp[lane] = kP;
+  ki[lane] = kI * SAMPLE_SECONDS;
+  kd[lane] = kD / SAMPLE_SECONDS;
+}
+
+void BatchSim::reset(float position, float velocity, float lastInput, int16_t duty)
+{
+  for (size_t i = 0; i < size(); i++)
+  {
+    this->position[i] = position;
+    this->velocity[i] = velocity;
+    this->lastInput[i] = lastInput;
+    this->duty[i] = duty;
+    outputSum[i] = 0;
+    squaredError[i] = 0;
+    overshoot[i] = 0;
+    lastUnsettled[i] = 0;
+    energy[i] = 0;
+  }
+}
+
+void BatchSim::step(float setpoint, float low, float high, int8_t direction, uint32_t t)
+{
+  const float range = Robot::Pwm::RANGE;
+  const float encoderStep = parameters.encoderStep;
+  const float supply = parameters.supply;
+  const float resistance = parameters.resistance;
+  const float backEmf = parameters.backEmf;
+  const float torquePerAmp = parameters.backEmf / RADIANS;
+  const float viscous = parameters.viscous;
+  const float coulomb = parameters.coulomb;
+  const float stall = parameters.stallCurrent;
+  const float inertia = parameters.inertia;
+  const float dt = SAMPLE_SECONDS / SUBSTEPS;
+  const int32_t db = deadband;
+
+  float *kp = this->kp.data();
+  float *ki = this->ki.data();
+  float *kd = this->kd.data();
+  float *outputSum = this->outputSum.data();
+  float *lastInput = this->lastInput.data();
+  int32_t *duty = this->duty.data();
+  float *position = this->position.data();
+  float *velocity = this->velocity.data();
+  float *squaredError = this->squaredError.data();
+  float *overshoot = this->overshoot.data();
+  uint32_t *lastUnsettled = this->lastUnsettled.data();
+  float *energy = this->energy.data();
+
+  for (size_t i = 0; i < size(); i++)
+  {
+    // PID_v1 in float, IntPid rounds the setpoint to counts
+    float measured = floorf(position[i] / encoderStep) * encoderStep;
+    float error = setpoint - measured;
+    float dInput = measured - lastInput[i];
+    outputSum[i] = fminf(fmaxf(outputSum[i] + ki[i] * error, -range), range);
+    float output = fminf(fmaxf(kp[i] * error + outputSum[i] - kd[i] * dInput, -range), range);
+    lastInput[i] = measured;
+
+    // controlMotorPID(), map() on longs
+    int32_t x = (int32_t)output;
+    int32_t forward = x * (Robot::Pwm::RANGE - db) / Robot::Pwm::RANGE + db;
+    int32_t backward = -((-x) * (Robot::Pwm::RANGE - db) / Robot::Pwm::RANGE) - db;
+    int32_t d = output > 1 ? forward : output < -1 ? backward : output > -1 && output < 1 ? 0 : duty[i];
+    duty[i] = d;
+
+    float voltage = supply * d / range;
+    for (uint8_t s = 0; s < SUBSTEPS; s++)
+    {
+      float current = (voltage - backEmf * velocity[i]) / resistance;
+      current = fminf(fmaxf(current, -stall), stall);
+      float omega = velocity[i] * RADIANS;
+      float torque = torquePerAmp * current - viscous * omega;
+      bool moving = omega != 0;
+      bool stuck = !moving && fabsf(torque) <= coulomb;
+      float friction = copysignf(coulomb, moving ? omega : torque);
+      float newOmega = omega + (torque - friction) / inertia * dt;
+      bool reversed = moving && (newOmega > 0) != (omega > 0);
+      newOmega = stuck || reversed ? 0 : newOmega;
+      velocity[i] = newOmega / RADIANS;
+      position[i] += velocity[i] * dt;
+      energy[i] += current * current * resistance * dt;
+    }
+
+    float e = setpoint - position[i];
+    squaredError[i] += e * e;
+    float past = fminf(fmaxf(position[i] - high, low - position[i]), -e * direction);
+    overshoot[i] = fmaxf(overshoot[i], past);
+    lastUnsettled[i] = fabsf(e) > SETTLE_BAND ? t : lastUnsettled[i];
+  }
+}
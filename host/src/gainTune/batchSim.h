@@ -0,0 +1,49 @@
+#ifndef BATCH_SIM_H
+#define BATCH_SIM_H
+
+#include "../common/legModel.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Many copies of one joint, each with its own gains, stepped together. Every
+// field is an array over the candidates (structure of arrays), and step()
+// is one loop over them without calls, which the compiler vectorises.
+//
+// An approximation of LegPid, legDuty() and LegPlant: the PID is PID_v1's,
+// in float on the setpoint in degrees, where IntPid works in fixed point on
+// whole counts, so scores differ a little near the deadband. gainTune plays
+// the candidates it picks again through the real ones and reports those.
+class BatchSim
+{
+public:
+  BatchSim(const PlantParameters &parameters, uint8_t deadband);
+
+  void resize(size_t count);
+  size_t size();
+  void setGains(size_t lane, float kP, float kI, float kD); // per second
+  // every lane from the same state, and the scores back to zero
+  void reset(float position, float velocity, float lastInput, int16_t duty);
+
+  // one 1 ms PID sample towards setpoint. low..high is the setpoint's
+  // recent range and direction its last move, for the overshoot.
+  void step(float setpoint, float low, float high, int8_t direction, uint32_t t);
+
+  // totals since reset
+  std::vector<float> squaredError;
+  std::vector<float> overshoot;
+  std::vector<uint32_t> lastUnsettled; // last t more than the settle band off
+  std::vector<float> energy;           // J in the windings
+
+private:
+  PlantParameters parameters;
+  uint8_t deadband;
+
+  std::vector<float> kp, ki, kd;
+  std::vector<float> outputSum, lastInput;
+  std::vector<int32_t> duty;
+  std::vector<float> position, velocity;
+};
+
+#endif
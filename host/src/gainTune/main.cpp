@@ -0,0 +1,440 @@
+/*
+Title: Acrobot gain tuner
+Description: Searches PID gains for every phase of every timeline, a phase
+being the time from one keyframe to the next. The show is simulated once
+with the authored gains, with the leg model of common/legModel.h. Every
+phase is then replayed from the state the authored run reached at its start,
+for a grid of kP, kI and kD candidates. Phases run in parallel on a thread
+pool, and the candidates of a phase step together in a BatchSim, a float
+approximation of the leg's controller. The winners of each phase are then
+played again through LegPid, legDuty() and LegPlant, and those scores are
+the ones reported.
+
+Candidates are scored on RMS tracking error, overshoot, settling time and
+the energy spent in the windings, summed over both legs (rP drives both).
+Keyframes only carry kP, so the tuner recommends a kP per keyframe with
+kI = kD = 0, and separately the best full PID, for comparison.
+
+Usage: gainTune [image] [--move name] [--threads n] [-o table.csv]
+*/
+
+#include "../common/legModel.h"
+#include "batchSim.h"
+#include "threadPool.h"
+
+#include <sequences.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+const uint32_t SETTLE = 1000;          // ms after the last keyframe of a holding timeline
+const uint32_t OVERSHOOT_WINDOW = 500; // ms, as in showSim
+const uint32_t MIN_PHASE = 20;         // ms, shorter phases keep their gains
+const uint8_t SUBSTEPS = 4;            // as in BatchSim
+const double SETTLE_BAND = 2;          // degrees, as in BatchSim
+
+// score = rms + overshoot + settling * SETTLING_WEIGHT + energy * ENERGY_WEIGHT, per leg
+const float SETTLING_WEIGHT = 0.01; // per ms, 100 ms late weighs like 1 degree off
+const float ENERGY_WEIGHT = 0.5;    // per J
+
+const float KP_GRID[] = {0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.2, 1.4, 1.6, 1.8,
+                         2.0, 2.2, 2.5, 2.8, 3.0, 3.5, 4.0, 5.0, 6.0};
+const float KI_GRID[] = {0, 1, 2, 5, 10};
+const float KD_GRID[] = {0, 0.002, 0.005, 0.01, 0.02};
+
+struct Snapshot
+{
+  float position;
+  float velocity;
+  float lastInput;
+  int16_t duty;
+};
+
+// the authored run of one timeline, what the phases start from
+struct Trace
+{
+  int16_t index;
+  struct_timeline timeline;
+  uint32_t end;
+  std::vector<float> setpoint[2], low[2], high[2];
+  std::vector<int8_t> direction[2];
+  std::vector<Snapshot> start[2]; // per keyframe
+};
+
+struct Candidate
+{
+  float kP, kI, kD;
+};
+
+struct PhaseResult
+{
+  uint32_t from, to;
+  float authoredKp;
+  float authoredScore;
+  Candidate bestKp;
+  float bestKpScore;
+  Candidate bestPid;
+  float bestPidScore;
+  // the same three through the leg's own controller
+  float authoredReplay;
+  float bestKpReplay;
+  float bestPidReplay;
+};
+
+PlantParameters parameters;
+std::vector<Candidate> candidates;
+
+void trace(TimelineLibrary &library, Trace &trace)
+{
+  const struct_timeline &timeline = trace.timeline;
+  TimelinePlayer player(library);
+  player.start(trace.index, 0);
+  trace.end =
+      timeline.duration ? timeline.duration : timeline.keyframes[timeline.count - 1].time + SETTLE;
+
+  double setpoints[2] = {(double)timeline.keyframes[0].rTarget,
+                         (double)timeline.keyframes[0].lTarget};
+  double kP = timeline.keyframes[0].kP / 100.;
+  LegPlant plants[2] = {LegPlant(parameters), LegPlant(parameters)};
+  LegPid pids[2];
+  int16_t duties[2] = {0, 0};
+  SetpointRange ranges[2] = {SetpointRange(OVERSHOOT_WINDOW), SetpointRange(OVERSHOOT_WINDOW)};
+  double lastSetpoints[2] = {setpoints[0], setpoints[1]};
+  int8_t directions[2] = {0, 0};
+  for (int joint = 0; joint < 2; joint++)
+  {
+    plants[joint].reset(setpoints[joint]);
+    pids[joint].reset(plants[joint].getMeasured());
+    trace.start[joint].resize(timeline.count);
+  }
+
+  uint16_t keyframe = 0;
+  for (uint32_t t = 0; t < trace.end; t++)
+  {
+    struct_timeline_state state;
+    if (player.update(t, state))
+    {
+      setpoints[0] = state.rTarget;
+      setpoints[1] = state.lTarget;
+      kP = state.kP;
+    }
+
+    for (int joint = 0; joint < 2; joint++)
+    {
+      LegPlant &plant = plants[joint];
+      // the state a phase starting now starts from
+      for (uint16_t k = keyframe; k < timeline.count && timeline.keyframes[k].time <= t; k++)
+      {
+        trace.start[joint][k] = {(float)plant.getPosition(), (float)plant.getVelocity(),
+                                 (float)plant.getMeasured(), duties[joint]};
+      }
+
+      pids[joint].setTunings(kP, 0, 0);
+      int32_t output = pids[joint].compute(setpoints[joint], plant.getMeasured());
+      duties[joint] = legDuty(joint, output, duties[joint]);
+      for (uint8_t i = 0; i < SUBSTEPS; i++)
+      {
+        plant.step(duties[joint], 0.001 / SUBSTEPS);
+      }
+
+      if (setpoints[joint] != lastSetpoints[joint])
+      {
+        directions[joint] = setpoints[joint] > lastSetpoints[joint] ? 1 : -1;
+        lastSetpoints[joint] = setpoints[joint];
+      }
+      ranges[joint].add(t, setpoints[joint]);
+      trace.setpoint[joint].push_back(setpoints[joint]);
+      trace.low[joint].push_back(ranges[joint].getLow());
+      trace.high[joint].push_back(ranges[joint].getHigh());
+      trace.direction[joint].push_back(directions[joint]);
+    }
+    while (keyframe < timeline.count && timeline.keyframes[keyframe].time <= t)
+    {
+      keyframe++;
+    }
+  }
+}
+
+// one candidate over one phase through LegPid, legDuty() and LegPlant,
+// scored as tunePhase() scores the BatchSim lanes
+float replayPhase(const Trace &trace, uint16_t keyframe, uint32_t from, uint32_t to,
+                  const Candidate &candidate)
+{
+  float score = 0;
+  for (int joint = 0; joint < 2; joint++)
+  {
+    const Snapshot &start = trace.start[joint][keyframe];
+    LegPlant plant(parameters);
+    plant.reset(start.position, start.velocity);
+    LegPid pid;
+    pid.setTunings(candidate.kP, candidate.kI, candidate.kD);
+    pid.reset(start.lastInput);
+    int16_t duty = start.duty;
+
+    double squaredError = 0, overshoot = 0, energy = 0;
+    uint32_t lastUnsettled = 0;
+    for (uint32_t t = from; t < to; t++)
+    {
+      double setpoint = trace.setpoint[joint][t];
+      duty = legDuty(joint, pid.compute(setpoint, plant.getMeasured()), duty);
+      for (uint8_t i = 0; i < SUBSTEPS; i++)
+      {
+        plant.step(duty, 0.001 / SUBSTEPS);
+        double current = plant.getCurrent();
+        energy += current * current * parameters.resistance * 0.001 / SUBSTEPS;
+      }
+
+      double e = setpoint - plant.getPosition();
+      squaredError += e * e;
+      double past = fmin(fmax(plant.getPosition() - trace.high[joint][t],
+                              trace.low[joint][t] - plant.getPosition()),
+                         -e * trace.direction[joint][t]);
+      overshoot = fmax(overshoot, past);
+      lastUnsettled = fabs(e) > SETTLE_BAND ? t : lastUnsettled;
+    }
+
+    float settling = lastUnsettled > from ? lastUnsettled - from : 0;
+    score += sqrt(squaredError / (to - from)) + overshoot + settling * SETTLING_WEIGHT +
+             energy * ENERGY_WEIGHT;
+  }
+  return score;
+}
+
+// all candidates over one phase, lane 0 being the authored gains
+void tunePhase(const Trace &trace, uint16_t keyframe, uint32_t from, uint32_t to,
+               PhaseResult &result)
+{
+  float authoredKp = trace.timeline.keyframes[keyframe].kP / 100.f;
+  const uint8_t deadbands[2] = {Robot::RightLeg::DEADBAND, Robot::LeftLeg::DEADBAND};
+  std::vector<float> scores(candidates.size() + 1, 0);
+
+  for (int joint = 0; joint < 2; joint++)
+  {
+    BatchSim batch(parameters, deadbands[joint]);
+    batch.resize(candidates.size() + 1);
+    batch.setGains(0, authoredKp, 0, 0);
+    for (size_t c = 0; c < candidates.size(); c++)
+    {
+      batch.setGains(c + 1, candidates[c].kP, candidates[c].kI, candidates[c].kD);
+    }
+    const Snapshot &start = trace.start[joint][keyframe];
+    batch.reset(start.position, start.velocity, start.lastInput, start.duty);
+
+    for (uint32_t t = from; t < to; t++)
+    {
+      batch.step(trace.setpoint[joint][t], trace.low[joint][t], trace.high[joint][t],
+                 trace.direction[joint][t], t);
+    }
+
+    for (size_t lane = 0; lane < batch.size(); lane++)
+    {
+      float settling = batch.lastUnsettled[lane] > from ? batch.lastUnsettled[lane] - from : 0;
+      scores[lane] += sqrtf(batch.squaredError[lane] / (to - from)) + batch.overshoot[lane] +
+                      settling * SETTLING_WEIGHT + batch.energy[lane] * ENERGY_WEIGHT;
+    }
+  }
+
+  result = {from, to, authoredKp, scores[0], {authoredKp, 0, 0}, scores[0], {authoredKp, 0, 0},
+            scores[0], 0, 0, 0};
+  for (size_t c = 0; c < candidates.size(); c++)
+  {
+    float score = scores[c + 1];
+    if (score < result.bestPidScore)
+    {
+      result.bestPid = candidates[c];
+      result.bestPidScore = score;
+    }
+    if (!candidates[c].kI && !candidates[c].kD && score < result.bestKpScore)
+    {
+      result.bestKp = candidates[c];
+      result.bestKpScore = score;
+    }
+  }
+
+  result.authoredReplay = replayPhase(trace, keyframe, from, to, {authoredKp, 0, 0});
+  result.bestKpReplay = replayPhase(trace, keyframe, from, to, result.bestKp);
+  result.bestPidReplay = replayPhase(trace, keyframe, from, to, result.bestPid);
+}
+
+int main(int argc, char **argv)
+{
+  const char *imageName = nullptr;
+  const char *moveName = nullptr;
+  const char *outputName = nullptr;
+  unsigned threads = std::thread::hardware_concurrency();
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--move") == 0 && i + 1 < argc)
+    {
+      moveName = argv[++i];
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+    {
+      threads = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+    {
+      outputName = argv[++i];
+    }
+    else if (argv[i][0] != '-')
+    {
+      imageName = argv[i];
+    }
+    else
+    {
+      fprintf(stderr, "usage: gainTune [image] [--move name] [--threads n] [-o table.csv]\n");
+      return 2;
+    }
+  }
+
+  TimelineLibrary library(sequences, MOVE_COUNT);
+  std::vector<uint32_t> image; // words, the image must be aligned
+  if (imageName)
+  {
+    FILE *in = fopen(imageName, "rb");
+    if (!in)
+    {
+      perror(imageName);
+      return 1;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    image.resize((size + 3) / 4);
+    bool read = fread(image.data(), 1, size, in) == (size_t)size;
+    fclose(in);
+    if (!read || !library.load((const uint8_t *)image.data(), size))
+    {
+      fprintf(stderr, "%s: not a timeline image\n", imageName);
+      return 1;
+    }
+  }
+
+  for (float kP : KP_GRID)
+  {
+    for (float kI : KI_GRID)
+    {
+      for (float kD : KD_GRID)
+      {
+        candidates.push_back({kP, kI, kD});
+      }
+    }
+  }
+
+  auto started = std::chrono::steady_clock::now();
+  ThreadPool pool(threads);
+
+  // the authored runs, one job per timeline
+  std::vector<Trace> traces;
+  for (int16_t i = 0; i < library.getSize(); i++)
+  {
+    Trace trace;
+    trace.index = i;
+    library.get(i, trace.timeline);
+    if (trace.timeline.count && (!moveName || strcmp(moveName, trace.timeline.name) == 0))
+    {
+      traces.push_back(trace);
+    }
+  }
+  for (Trace &t : traces)
+  {
+    pool.submit([&library, &t] { trace(library, t); });
+  }
+  pool.wait();
+
+  // then one job per phase
+  std::vector<std::vector<PhaseResult>> results(traces.size());
+  uint64_t laneMillis = 0;
+  for (size_t i = 0; i < traces.size(); i++)
+  {
+    const struct_timeline &timeline = traces[i].timeline;
+    results[i].resize(timeline.count);
+    for (uint16_t k = 0; k < timeline.count; k++)
+    {
+      uint32_t from = timeline.keyframes[k].time;
+      uint32_t to = k + 1 < timeline.count ? timeline.keyframes[k + 1].time : traces[i].end;
+      to = std::min(to, traces[i].end);
+      results[i][k] = {from, to, timeline.keyframes[k].kP / 100.f, 0, {}, 0, {}, 0, 0, 0, 0};
+      if (to < from + MIN_PHASE)
+      {
+        continue;
+      }
+      laneMillis += (uint64_t)(to - from) * (candidates.size() + 1) * 2;
+      pool.submit([&traces, &results, i, k, from, to] {
+        tunePhase(traces[i], k, from, to, results[i][k]);
+      });
+    }
+  }
+  pool.wait();
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  FILE *out = nullptr;
+  if (outputName)
+  {
+    out = fopen(outputName, "w");
+    if (!out)
+    {
+      perror(outputName);
+      return 1;
+    }
+    fprintf(out, "timeline,keyframe,ms,authoredKp,authoredScore,kp,kpScore,pidKp,pidKi,pidKd,"
+                 "pidScore,authoredReplay,kpReplay,pidReplay\n");
+  }
+
+  // scores are the replayed ones, BatchSim's in brackets
+  float authoredTotal = 0, kpTotal = 0, pidTotal = 0;
+  float authoredBatch = 0, kpBatch = 0, pidBatch = 0;
+  printf("%-20s %8s %8s %15s %15s %15s   %s\n", "timeline", "kP x100", "tuned", "score", "tuned",
+         "pid", "best pid");
+  for (size_t i = 0; i < traces.size(); i++)
+  {
+    const struct_timeline &timeline = traces[i].timeline;
+    printf("%s\n", timeline.name);
+    for (uint16_t k = 0; k < timeline.count; k++)
+    {
+      const PhaseResult &r = results[i][k];
+      if (r.to < r.from + MIN_PHASE)
+      {
+        continue;
+      }
+      authoredTotal += r.authoredReplay;
+      kpTotal += r.bestKpReplay;
+      pidTotal += r.bestPidReplay;
+      authoredBatch += r.authoredScore;
+      kpBatch += r.bestKpScore;
+      pidBatch += r.bestPidScore;
+      // * = the largest kP of the grid, the best may lie beyond it
+      bool edge = r.bestKp.kP == KP_GRID[sizeof(KP_GRID) / sizeof(KP_GRID[0]) - 1];
+      printf("  %6u ms %8.0f %7.0f%c %6.1f (%6.1f) %6.1f (%6.1f) %6.1f (%6.1f)   %.1f %.0f %.3f\n",
+             r.from, r.authoredKp * 100, r.bestKp.kP * 100, edge ? '*' : ' ', r.authoredReplay,
+             r.authoredScore, r.bestKpReplay, r.bestKpScore, r.bestPidReplay, r.bestPidScore,
+             r.bestPid.kP, r.bestPid.kI, r.bestPid.kD);
+      if (out)
+      {
+        fprintf(out, "%s,%u,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%.2f,%.2f,%.2f,%.2f\n",
+                timeline.name, k, r.from, r.authoredKp, r.authoredScore, r.bestKp.kP,
+                r.bestKpScore, r.bestPid.kP, r.bestPid.kI, r.bestPid.kD, r.bestPidScore,
+                r.authoredReplay, r.bestKpReplay, r.bestPidReplay);
+      }
+    }
+  }
+  if (out)
+  {
+    fclose(out);
+  }
+
+  printf("* at the edge of the kP grid\n");
+  printf("score authored %.0f, tuned kP %.0f, tuned pid %.0f (batch %.0f, %.0f, %.0f)\n",
+         authoredTotal, kpTotal, pidTotal, authoredBatch, kpBatch, pidBatch);
+  printf("%zu candidates, %.1f M candidate-ms in %.2f s on %u threads, %.0f k candidate-ms/s per "
+         "thread\n",
+         candidates.size(), laneMillis / 1e6, seconds, pool.getThreads(),
+         laneMillis / seconds / pool.getThreads() / 1e3);
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(unsigned threads)
+{
+  for (unsigned i = 0; i < (threads ? threads : 1); i++)
+  {
+    workers.emplace_back(&ThreadPool::work, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  hasJob.notify_all();
+  for (std::thread &worker : workers)
+  {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> job)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(std::move(job));
+  }
+  hasJob.notify_one();
+}
+
+void ThreadPool::wait()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  idle.wait(lock, [this] { return jobs.empty() && !running; });
+}
+
+unsigned ThreadPool::getThreads()
+{
+  return workers.size();
+}
+
+void ThreadPool::work()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true)
+  {
+    hasJob.wait(lock, [this] { return stopping || !jobs.empty(); });
+    if (jobs.empty())
+    {
+      return; // stopping
+    }
+    std::function<void()> job = std::move(jobs.front());
+    jobs.pop_front();
+    running++;
+    lock.unlock();
+    job();
+    lock.lock();
+    running--;
+    if (jobs.empty() && !running)
+    {
+      idle.notify_all();
+    }
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of worker threads taking jobs from one queue.
+class ThreadPool
+{
+public:
+  explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  void submit(std::function<void()> job);
+  // returns once every submitted job has finished
+  void wait();
+  unsigned getThreads();
+
+private:
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> jobs;
+  std::mutex mutex;
+  std::condition_variable hasJob;
+  std::condition_variable idle;
+  unsigned running = 0;
+  bool stopping = false;
+
+  void work();
+};
+
+#endif
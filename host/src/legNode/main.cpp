@@ -0,0 +1,244 @@
+/*
+Title: Acrobot leg node
+Description: The leg's side of the radio link, as a Linux process over
+UdpTransport: the 200 ms receive timeout, 5 ms data frames and batched 1 kHz
+telemetry, at the firmware's sizes and rates. Uploads and playback commands
+go through the firmware's own ClockSync and TimelineReceiver, as LegPlayback
+drives them, and the error of every start against the remote's start time
+is reported. The rest of the leg is not: the motors are a first order lag
+towards the target. Start remoteNode next to it.
+
+Usage: legNode [--loss %] [--latency us] [--jitter us] [--reorder %] [--seconds s]
+*/
+
+#include "../common/node.h"
+
+#include <clockSync.h>
+#include <protocol.h>
+#include <telemetryFrame.h>
+#include <timelineReceiver.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+NodeOptions options;
+UdpTransport *transport;
+
+struct_leg_data dataOut;
+struct_remote_data dataIn;
+
+uint32_t lastReceiveTime = 0;
+bool connectionStatus = false;
+uint32_t disconnects = 0;
+uint32_t disconnectedMillis = 0;
+
+uint32_t dataTimer = 0;
+uint16_t telemetrySequence = 0;
+uint8_t telemetryFrame[TRANSPORT_MAX_DATA_LEN];
+
+const uint16_t PENDING_CAPACITY = 128;
+struct_telemetry_sample pendingSamples[PENDING_CAPACITY];
+uint16_t pendingCount = 0;
+
+uint32_t sampleTimer = 0;
+double rInput = 180, lInput = 180;
+
+ClockSync clockSync;
+TimelineReceiver receiver; // in degrees
+
+// the start command being waited for, and how far off the starts were
+bool startWanted = false;
+uint8_t startSequence = 0;
+uint32_t startExpected = 0; // the remote's start time, on our clock
+uint32_t lateCommands = 0;  // arrived after their start time
+std::vector<int32_t> startErrors;
+
+void watchStart(const uint8_t *data, int len)
+{
+  struct_playback playback;
+  if (data[0] != MSG_PLAYBACK || len < (int)sizeof(playback))
+  {
+    return;
+  }
+  memcpy(&playback, data, sizeof(playback));
+  if (playback.command != PLAYBACK_START || playback.sequence == startSequence)
+  {
+    return;
+  }
+  startSequence = playback.sequence;
+  startWanted = true;
+  // both clocks are known here, the leg only has ClockSync's estimate
+  startExpected = playback.startAt + REMOTE_BOOT - LEG_BOOT;
+  if ((int32_t)(millis() - startExpected) > 0)
+  {
+    lateCommands++;
+  }
+}
+
+void OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int len)
+{
+  // as the leg's: every header feeds the clock and the timeout
+  struct_remote_header header;
+  if (len < (int)sizeof(header))
+  {
+    return;
+  }
+  memcpy(&header, incomingData, sizeof(header));
+  clockSync.add(header.millis, millis());
+  lastReceiveTime = millis();
+  connectionStatus = true;
+
+  // poll() calls back on the loop's thread, so no queue as on the leg
+  if (header.type != MSG_CONTROL)
+  {
+    watchStart(incomingData, len);
+    receiver.receive(incomingData, len, clockSync);
+    return;
+  }
+  if (len < (int)sizeof(dataIn))
+  {
+    return;
+  }
+  memcpy(&dataIn, incomingData, sizeof(dataIn));
+}
+
+uint32_t lastCheck = 0;
+
+void checkReceiveTimeout()
+{
+  uint32_t now = millis();
+  if (now - lastReceiveTime > 200)
+  {
+    if (connectionStatus)
+    {
+      disconnects++;
+    }
+    connectionStatus = false;
+    disconnectedMillis += now - lastCheck;
+  }
+  lastCheck = now;
+}
+
+void updatePlant()
+{
+  // 1 kHz, like the PID sample time on the leg
+  if (micros() - sampleTimer < 1000)
+  {
+    return;
+  }
+  sampleTimer = micros();
+
+  double rTarget = connectionStatus ? dataIn.rTargetPositionDegrees : rInput;
+  double lTarget = connectionStatus ? dataIn.lTargetPositionDegrees : lInput;
+  struct_timeline_state current = {(float)rTarget, (float)lTarget, dataIn.rP};
+  struct_timeline_state state;
+  if (receiver.update(millis(), current, state))
+  {
+    rTarget = state.rTarget;
+    lTarget = state.lTarget;
+  }
+  if (startWanted && receiver.getPlaying() >= 0)
+  {
+    startWanted = false;
+    startErrors.push_back((int32_t)(millis() - startExpected));
+  }
+  double rLast = rInput, lLast = lInput;
+  rInput += (rTarget - rInput) * 0.02;
+  lInput += (lTarget - lInput) * 0.02;
+
+  struct_telemetry_sample s = {};
+  s.micros = sampleTimer;
+  s.loopMicros = 100;
+  s.joints[0] = {(int16_t)(rInput * 10), (int16_t)((rInput - rLast) * 1000), (int16_t)(rTarget * 10), 0, 0};
+  s.joints[1] = {(int16_t)(lInput * 10), (int16_t)((lInput - lLast) * 1000), (int16_t)(lTarget * 10), 0, 0};
+
+  if (pendingCount == PENDING_CAPACITY)
+  {
+    memmove(pendingSamples, pendingSamples + 1, sizeof(s) * (PENDING_CAPACITY - 1));
+    pendingCount--;
+  }
+  pendingSamples[pendingCount++] = s;
+}
+
+void sendData()
+{
+  if (millis() - dataTimer < 5)
+  {
+    return;
+  }
+  dataTimer = millis();
+
+  dataOut.rP = dataIn.rP;
+  dataOut.timelineCrc = receiver.getCrc();
+  dataOut.uploadNextChunk = receiver.getNextChunk();
+  dataOut.playingTimeline = receiver.getPlaying();
+  dataOut.profile.zone = PROFILE_NONE;
+  dataOut.rInput = rInput;
+  dataOut.lInput = lInput;
+
+  memcpy(telemetryFrame, &dataOut, sizeof(dataOut));
+  size_t len = sizeof(dataOut);
+
+  TelemetryEncoder encoder;
+  encoder.begin(telemetryFrame + len, sizeof(telemetryFrame) - len, telemetrySequence++);
+  uint16_t packed = 0;
+  while (packed < pendingCount && encoder.add(pendingSamples[packed]))
+  {
+    packed++;
+  }
+  memmove(pendingSamples, pendingSamples + packed, sizeof(pendingSamples[0]) * (pendingCount - packed));
+  pendingCount -= packed;
+  len += encoder.getSize();
+
+  transport->send(REMOTE_MAC, telemetryFrame, len);
+}
+
+int main(int argc, char **argv)
+{
+  if (!parseNodeOptions(argc, argv, options))
+  {
+    return 1;
+  }
+
+  setBoot(LEG_BOOT);
+  transport = new UdpTransport(LEG_MAC, options.impairments);
+  if (!transport->begin())
+  {
+    perror("legNode: bind");
+    return 1;
+  }
+  transport->onReceive(OnDataRecv);
+  transport->addPeer(REMOTE_MAC);
+
+  lastReceiveTime = lastCheck = millis();
+  uint32_t end = millis() + options.seconds * 1000;
+  while ((int32_t)(end - millis()) > 0)
+  {
+    transport->poll();
+    checkReceiveTimeout();
+    updatePlant();
+    sendData();
+    idle();
+  }
+
+  printStats("leg", transport->getStats(), options.seconds);
+  printf("leg: %u disconnects, %.2f s without remote\n", disconnects, disconnectedMillis / 1000.);
+  if (!startErrors.empty())
+  {
+    // positive = after the remote's start time
+    std::vector<int32_t> sorted = startErrors;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0;
+    for (int32_t e : sorted)
+    {
+      sum += e;
+    }
+    printf("leg: %zu starts, start error min %d ms, mean %.1f ms, p95 %d ms, max %d ms, "
+           "%u commands arrived late\n",
+           sorted.size(), sorted.front(), sum / sorted.size(), sorted[sorted.size() * 95 / 100],
+           sorted.back(), lateCommands);
+  }
+  return 0;
+}
@@ -0,0 +1,136 @@
+/*
+Title: Acrobot binary log decoder
+Description: Turns the COBS framed binary log written by the leg or remote
+over USB serial into CSV on stdout. Reads a capture file, a serial device
+(set to raw mode at the given baud) or stdin. With -p it prints only the
+loop profile records, a row per zone, and the leg's shed level, as the
+remote's 'l' command or the leg's jobs log them.
+
+Usage: logDecode [-p] [file-or-device] [baud]
+       logDecode /dev/ttyUSB0 921600 > log.csv
+       logDecode -p /dev/ttyUSB0
+*/
+
+#include "../common/serialPort.h"
+
+#include <binaryLog.h>
+#include <profileZones.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// a profile record as a row of the zone table, any other record is skipped
+void printProfile(const struct_log_record &r)
+{
+  const char *source;
+  const char *zone;
+  if (r.id == LOG_LEG_PROFILE || r.id == LOG_REMOTE_LEG_PROFILE)
+  {
+    source = r.id == LOG_LEG_PROFILE ? "leg" : "leg via remote";
+    zone = r.arg < LEG_ZONE_COUNT ? legZoneNames[r.arg] : "?";
+  }
+  else if (r.id == LOG_REMOTE_PROFILE)
+  {
+    source = "remote";
+    zone = r.arg < REMOTE_ZONE_COUNT ? remoteZoneNames[r.arg] : "?";
+  }
+  else if (r.id == LOG_LEG_LOAD || r.id == LOG_REMOTE_LEG_LOAD)
+  {
+    // the shed level goes with the leg's zones, in the first column
+    printf("%s,shedLevel,%u,,,\n", r.id == LOG_LEG_LOAD ? "leg" : "leg via remote", r.arg);
+    return;
+  }
+  else
+  {
+    return;
+  }
+  printf("%s,%s,%u,%u,%u,%u\n", source, zone, (unsigned)r.values[0], (unsigned)r.values[1],
+         (unsigned)r.values[2], (unsigned)r.values[3]);
+}
+
+int main(int argc, char **argv)
+{
+  bool profile = argc > 1 && strcmp(argv[1], "-p") == 0;
+  if (profile)
+  {
+    argc--;
+    argv++;
+  }
+
+  int fd = STDIN_FILENO;
+  if (argc > 1)
+  {
+    fd = open(argv[1], O_RDONLY | O_NOCTTY);
+    if (fd < 0)
+    {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+  setRaw(fd, argc > 2 ? atol(argv[2]) : 921600);
+
+  if (profile)
+  {
+    printf("source,zone,min,mean,max,p99\n"); // cycles at 240 MHz
+  }
+  else
+  {
+    printf("micros,id,name,arg,v0,v1,v2,v3\n");
+  }
+
+  uint8_t frame[256];
+  size_t frameLen = 0;
+  bool overflow = false;
+  unsigned long rejected = 0;
+
+  uint8_t buffer[4096];
+  ssize_t n;
+  while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+  {
+    for (ssize_t i = 0; i < n; i++)
+    {
+      if (buffer[i] != 0)
+      {
+        if (frameLen < sizeof(frame))
+        {
+          frame[frameLen++] = buffer[i];
+        }
+        else
+        {
+          overflow = true;
+        }
+        continue;
+      }
+
+      struct_log_record r;
+      if (!overflow && frameLen && decodeLogFrame(frame, frameLen, r))
+      {
+        if (profile)
+        {
+          printProfile(r);
+        }
+        else
+        {
+          printf("%u,%u,%s,%u,%d,%d,%d,%d\n", r.micros, r.id, logIdName(r.id), r.arg,
+                   r.values[0], r.values[1], r.values[2], r.values[3]);
+        }
+      }
+      else if (frameLen)
+      {
+        rejected++; // text or a partial frame at the start
+      }
+      frameLen = 0;
+      overflow = false;
+    }
+    fflush(stdout);
+  }
+
+  if (rejected)
+  {
+    fprintf(stderr, "skipped %lu non-log frames\n", rejected);
+  }
+  return 0;
+}
@@ -0,0 +1,191 @@
+/*
+Title: Acrobot motor check
+Description: Runs the leg's MotorController and deadbandDuty() on the host,
+with a RecordingPwm for a sink and a scripted position for a source.
+
+1. Mapping: deadbandDuty() for IntPid outputs across the whole range, in
+   steps of 1/256 PWM, against the map() calls controlMotorPID() used to
+   make, for both joints and a few last duties.
+2. Controller: a MotorController at a fixed target sees every position of
+   the turn. Every update() writes once, the duty deadbandDuty() makes of
+   the PID's output, and it pushes towards the target: backward (positive)
+   below it, forward above, nothing within a PWM.
+
+Anything wrong exits with 1.
+
+Last, a benchmark of update() per control tick, against the same work
+written out by hand with the duty going straight to memory. The two should
+be as fast as each other: the sink is resolved at compile time.
+
+Usage: motorCheck
+*/
+
+#include <angle.h>
+#include <intPid.h>
+#include <motorController.h>
+#include <recordingPwm.h>
+#include <robotProfile.h>
+
+#include <chrono>
+#include <stdio.h>
+
+const uint32_t BENCH_TICKS = 5000000;
+
+// the leg's profile, what MotorController runs with there
+typedef Robot::Pwm Pwm;
+typedef Robot::RightLeg RightLeg;
+typedef Robot::LeftLeg LeftLeg;
+
+struct ScriptedPosition
+{
+  Angle position;
+
+  Angle getPosition()
+  {
+    return position;
+  }
+};
+
+// a sink that only keeps the duty, for the benchmark
+struct NullPwm
+{
+  volatile int16_t duty;
+
+  void begin()
+  {
+  }
+  void write(int16_t duty)
+  {
+    this->duty = duty;
+  }
+};
+
+// Arduino's map(), on longs
+static long mapLong(long x, long inMin, long inMax, long outMin, long outMax)
+{
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// controlMotorPID() as it was written out
+static int16_t mappedDuty(int32_t output, uint8_t deadband, int16_t lastDuty)
+{
+  if (output > IntPid::ONE)
+  {
+    return mapLong(IntPid::toPwm(output), 0, Pwm::RANGE, deadband, Pwm::RANGE);
+  }
+  if (output < -IntPid::ONE)
+  {
+    return mapLong(IntPid::toPwm(output), 0, -Pwm::RANGE, -deadband, -Pwm::RANGE);
+  }
+  if (output > -IntPid::ONE && output < IntPid::ONE)
+  {
+    return 0;
+  }
+  return lastDuty;
+}
+
+template <typename Joint>
+static uint32_t checkMapping(uint32_t &checked)
+{
+  const int16_t lastDuties[] = {0, 100, -Pwm::RANGE};
+  const int32_t end = Pwm::RANGE * IntPid::ONE;
+  uint32_t wrong = 0;
+  for (int16_t lastDuty : lastDuties)
+  {
+    for (int32_t output = -end; output <= end; output += IntPid::ONE / 256)
+    {
+      for (int32_t nudge = -1; nudge <= 1; nudge++)
+      {
+        int16_t expected = mappedDuty(output + nudge, Joint::DEADBAND, lastDuty);
+        wrong += deadbandDuty<Pwm, Joint>(output + nudge, lastDuty) != expected;
+        checked++;
+      }
+    }
+  }
+  return wrong;
+}
+
+static int checkController()
+{
+  ScriptedPosition source;
+  MotorController<Robot, RightLeg, RecordingPwm, ScriptedPosition> controller(source);
+  RecordingPwm &sink = controller.getSink();
+  controller.begin();
+  const Angle target = Angle::fromWholeDegrees(180);
+  controller.setTarget(target);
+
+  uint32_t wrong = !sink.isBegun();
+  int16_t lastDuty = 0;
+  for (uint16_t count = 0; count < Angle::COUNTS; count++)
+  {
+    source.position = Angle::fromCounts(count);
+    size_t writes = sink.getCount();
+    controller.update(count);
+    int16_t duty = sink.getLast();
+    int32_t output = controller.getOutput();
+
+    wrong += sink.getCount() != writes + 1;
+    wrong += duty != controller.getDuty();
+    wrong += duty != deadbandDuty<Pwm, RightLeg>(output, lastDuty);
+    // kP alone, a PWM per degree: getCounts() apart
+    int32_t error = (int32_t)target.getCounts() - count;
+    bool within = error * 360 < Angle::COUNTS && error * 360 > -(int32_t)Angle::COUNTS;
+    wrong += within ? duty != 0 && output != IntPid::ONE && output != -IntPid::ONE
+                    : (error > 0) != (duty > 0) || duty == 0;
+    lastDuty = duty;
+  }
+  printf("controller: %u positions, %zu writes, %u wrong\n", Angle::COUNTS, sink.getCount(),
+         wrong);
+  return wrong > 0;
+}
+
+static void bench()
+{
+  using namespace std::chrono;
+  const Angle target = Angle::fromWholeDegrees(180);
+
+  ScriptedPosition source;
+  MotorController<Robot, RightLeg, NullPwm, ScriptedPosition> controller(source);
+  controller.setKp(1.4f);
+  controller.setKi(0.2f);
+  controller.setKd(0.01f);
+  controller.setTarget(target);
+  auto start = steady_clock::now();
+  for (uint32_t tick = 0; tick < BENCH_TICKS; tick++)
+  {
+    source.position = Angle::fromCounts(tick * 37);
+    controller.update(tick);
+  }
+  double templateNs = duration<double, std::nano>(steady_clock::now() - start).count() / BENCH_TICKS;
+
+  IntPid pid(Pwm::RANGE, 1);
+  pid.setTunings(1.4f, 0.2f, 0.01f);
+  pid.start(Angle());
+  volatile int16_t written;
+  int16_t duty = 0;
+  start = steady_clock::now();
+  for (uint32_t tick = 0; tick < BENCH_TICKS; tick++)
+  {
+    pid.compute(target, Angle::fromCounts(tick * 37), tick);
+    duty = deadbandDuty<Pwm, RightLeg>(pid.getOutput(), duty);
+    written = duty;
+  }
+  double handNs = duration<double, std::nano>(steady_clock::now() - start).count() / BENCH_TICKS;
+  (void)written;
+
+  printf("bench, ns per update() on this machine: MotorController %.1f, by hand %.1f\n",
+         templateNs, handNs);
+}
+
+int main()
+{
+  uint32_t checked = 0;
+  uint32_t wrong = checkMapping<RightLeg>(checked) + checkMapping<LeftLeg>(checked);
+  printf("mapping: %u outputs, %u wrong\n", checked, wrong);
+  int failed = wrong > 0;
+
+  failed |= checkController();
+
+  bench();
+  return failed ? 1 : 0;
+}
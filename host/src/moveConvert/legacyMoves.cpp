@@ -0,0 +1,2290 @@
+#include "legacyMoves.h"
+
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+moveList move = stop;
+uint32_t moveTimer = 0;
+double kP = 0;
+uint16_t rTargetPositionDegrees = 180;
+uint16_t lTargetPositionDegrees = 180;
+
+uint32_t legacyMillis = 0;
+int legacyRestart = -1;
+uint32_t legacyLastTime = 0;
+
+// stop reads the leg, it is not converted
+struct
+{
+  double rInput = 180;
+  double lInput = 180;
+} dataIn;
+
+static uint32_t millis()
+{
+  return legacyMillis;
+}
+
+static void startMove(moveList theMove)
+{
+  move = theMove;
+  moveTimer = millis();
+  legacyRestart = theMove;
+}
+
+// The old code compared (moveTimer + time) > millis(), true until the time had
+// passed, so every move jumped to its last block. This is the reading the
+// blocks were written for.
+static bool moveTimePassed(uint32_t time)
+{
+  legacyLastTime = max(legacyLastTime, time);
+  return millis() - moveTimer >= time;
+}
+
+static uint16_t withinLimits(uint16_t position)
+{
+  return min(max(position, forwardLimit), backwardLimit);
+}
+
+static void pBow(int16_t upperBodyDegrees = 45)
+{
+  rTargetPositionDegrees = withinLimits(180 - upperBodyDegrees);
+  lTargetPositionDegrees = withinLimits(180 - upperBodyDegrees);
+}
+
+static void pStand() { pBow(0); }
+
+static void pStepRight(int8_t degrees)
+{
+  rTargetPositionDegrees = withinLimits(180 - degrees);
+  lTargetPositionDegrees = withinLimits(180 + degrees);
+}
+
+static void pStepLeft(int8_t degrees)
+{
+  rTargetPositionDegrees = withinLimits(180 + degrees);
+  lTargetPositionDegrees = withinLimits(180 - degrees);
+}
+
+static void pKickRight(int8_t degrees)
+{
+  lTargetPositionDegrees = 180;
+  rTargetPositionDegrees = withinLimits(180 - degrees);
+}
+
+static void pKickLeft(int8_t degrees)
+{
+  rTargetPositionDegrees = 180;
+  lTargetPositionDegrees = withinLimits(180 - degrees);
+}
+
+// --------------------------------
+// verbatim from here on
+
+void updateMoves()
+{
+  if (move == relax)
+  {
+    kP = 0;
+  }
+
+  if (move == stop)
+  {
+    kP = 2;
+    lTargetPositionDegrees = dataIn.lInput;
+    rTargetPositionDegrees = dataIn.rInput;
+
+    // round to even
+    lTargetPositionDegrees = (lTargetPositionDegrees / 2) * 2;
+    rTargetPositionDegrees = (rTargetPositionDegrees / 2) * 2;
+  }
+
+  if (move == stand)
+  {
+    pStand();
+    kP = 0.6;
+    if (moveTimePassed(300))
+    {
+      kP = 1;
+    }
+    if (moveTimePassed(600))
+    {
+      kP = 1.5;
+    }
+    if (moveTimePassed(1000))
+    {
+      kP = 2;
+    }
+  }
+
+  if (move == walk)
+  {
+    kP = 1.4;
+    pStepRight(20);
+    if (moveTimePassed(800))
+    {
+      pStepLeft(20);
+    }
+    if (moveTimePassed(1600))
+    {
+      startMove(walk);
+    }
+  }
+
+  if (move == jump)
+  {
+    kP = 1.4;
+    pStand();
+
+    if (moveTimePassed(2000))
+    {
+      kP = 0.6;
+      pBow(45);
+    }
+    if (moveTimePassed(3000))
+    {
+      kP = 4;
+      pBow(-10);
+    }
+    if (moveTimePassed(3800))
+    {
+      kP = 2;
+      pBow(10);
+    }
+    if (moveTimePassed(6000))
+    {
+      kP = 0.8;
+      pStand();
+    }
+  }
+
+  if (move == flip)
+  {
+    kP = 1.4;
+    pStand();
+
+    if (moveTimePassed(2000))
+    {
+      kP = 1;
+      pBow(15);
+    }
+    if (moveTimePassed(3000))
+    {
+      kP = 2;
+      pStand();
+    }
+    if (moveTimePassed(3300))
+    {
+      kP = 3;
+      pKickRight(90);
+    }
+    if (moveTimePassed(3500))
+    {
+      kP = 2;
+      pStepRight(90);
+    }
+    if (moveTimePassed(4300))
+    {
+      kP = 1.5;
+      pBow(20);
+    }
+    if (moveTimePassed(5500))
+    {
+      kP = 1.5;
+      pStand();
+    }
+  }
+
+  if (move == pirouette)
+  {
+    kP = 1.4;
+    pStand();
+
+    if (moveTimePassed(2000))
+    {
+      kP = 3;
+      rTargetPositionDegrees = 200;
+      lTargetPositionDegrees = 170;
+    }
+    if (moveTimePassed(3000))
+    {
+      kP = 2;
+      pKickRight(90);
+    }
+    if (moveTimePassed(3450))
+    {
+      kP = 2;
+      pBow(10);
+    }
+    if (moveTimePassed(3800))
+    {
+      kP = 1.8;
+      pStand();
+    }
+  }
+
+  if (move == acroyogaSequence)
+  {
+    kP = 1.4;
+    pStand();
+
+    uint32_t moveTime = 0;
+
+    // fall to bird
+    if (moveTimePassed(moveTime += 3000))
+    {
+      kP = 1.8;
+      pBow(25);
+    }
+
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 1.2;
+      pBow(15);
+    }
+    if (moveTimePassed(moveTime += 2000))
+    {
+      kP = 2;
+      pStand();
+    }
+
+    // swimming
+    if (moveTimePassed(moveTime += 4500))
+    {
+      kP = 2;
+      pKickRight(-20);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 2;
+      pKickLeft(-20);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 2;
+      pKickRight(-20);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 2;
+      pKickLeft(-20);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 2;
+      pKickRight(-20);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 2;
+      pKickLeft(-20);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+
+    // cloth hanger
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 1.6;
+      pStand();
+    }
+    if (moveTimePassed(moveTime += 3000))
+    {
+      kP = 0.3;
+      pBow(90);
+    }
+    if (moveTimePassed(moveTime += 5000))
+    {
+      kP = 2;
+      pBow(76);
+    }
+
+    // kick naar bolkje
+
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 1.2;
+      pKickRight(90);
+    }
+    if (moveTimePassed(moveTime += 1500))
+    {
+      kP = 0.7;
+      pStepRight(75);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 1;
+      pStepRight(60);
+    }
+    if (moveTimePassed(moveTime += 500))
+    {
+      kP = 1.2;
+      pStepRight(50);
+    }
+    if (moveTimePassed(moveTime += 500))
+    {
+      kP = 1;
+      pStepRight(35);
+    }
+    if (moveTimePassed(moveTime += 500))
+    {
+      kP = 1.8;
+      pStepRight(10);
+    }
+
+    // swim in bolk
+
+    if (moveTimePassed(moveTime += 1500))
+    {
+      kP = 1;
+      pStepLeft(10);
+    }
+    if (moveTimePassed(moveTime += 1500))
+    {
+      kP = 1;
+      pStepRight(10);
+    }
+    if (moveTimePassed(moveTime += 800))
+    {
+      kP = 1.2;
+      pStepLeft(10);
+    }
+    if (moveTimePassed(moveTime += 800))
+    {
+      kP = 1.2;
+      pStepRight(10);
+    }
+
+    // to knees
+    if (moveTimePassed(moveTime += 4000))
+    {
+      kP = 1;
+      pStepLeft(10);
+    }
+
+    if (moveTimePassed(moveTime += 800))
+    {
+      kP = 0.5;
+      pStepLeft(45);
+    }
+    if (moveTimePassed(moveTime += 800))
+    {
+      kP = 0.5;
+      pStepLeft(75);
+    }
+    if (moveTimePassed(moveTime += 800))
+    {
+      kP = 0.7;
+      pStepLeft(90);
+    }
+    if (moveTimePassed(moveTime += 3000))
+    {
+      kP = 0.5;
+      pKickRight(90);
+    }
+    if (moveTimePassed(moveTime += 1500))
+    {
+      kP = 0.6;
+      pBow(90);
+    }
+
+    // back to bird
+
+    if (moveTimePassed(moveTime += 3000))
+    {
+      kP = 1.4;
+      pKickRight(45);
+    }
+    if (moveTimePassed(moveTime += 500))
+    {
+      kP = 1.4;
+      pKickRight(90);
+    }
+    if (moveTimePassed(moveTime += 2500))
+    {
+      kP = 1;
+      pStand();
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 2.2;
+      pStand();
+    }
+
+    // back to standing
+    if (moveTimePassed(moveTime += 6000))
+    {
+      kP = 2;
+      pBow(15);
+    }
+
+    if (moveTimePassed(moveTime += 10000))
+    {
+      kP = 2;
+      pBow(10);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 1.8;
+      pBow(5);
+    }
+    if (moveTimePassed(moveTime += 1000))
+    {
+      kP = 1.6;
+      pStand();
+    }
+
+    // current total time: 76s
+    // Serial.print("acroyoga sequence total time: ");
+    // Serial.println(moveTime);
+  }
+
+  // --------------------------------
+  // MARK: - TEXT SEQUENCE 0
+
+  if (move == textSequence0)
+  {
+    kP = 0.6;
+    pBow(45);
+
+    if (moveTimePassed(7600))
+    {
+      kP = 0.2;
+      pStand();
+    }
+
+    // raise left
+    if (moveTimePassed(9250))
+    {
+      kP = 0.4;
+      pKickLeft(90);
+    }
+    if (moveTimePassed(9550))
+    {
+      kP = 0.6;
+      pKickLeft(90);
+    }
+    if (moveTimePassed(9950))
+    {
+      kP = 1;
+      pKickLeft(90);
+    }
+
+    // swing excited
+    if (moveTimePassed(19750))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 120;
+    }
+    if (moveTimePassed(20550))
+    {
+      kP = 0.8;
+      rTargetPositionDegrees = 220;
+    }
+    if (moveTimePassed(21190))
+    {
+      kP = 0.8;
+      rTargetPositionDegrees = 120;
+    }
+
+    if (moveTimePassed(29800))
+    {
+      kP = 1.2;
+      rTargetPositionDegrees = 90;
+    }
+
+    // lower left
+
+    if (moveTimePassed(37680))
+    {
+      kP = 0.2;
+      lTargetPositionDegrees = 180;
+    }
+
+    // swing left
+
+    if (moveTimePassed(41760))
+    {
+      kP = 0.8;
+      lTargetPositionDegrees = 120;
+    }
+
+    if (moveTimePassed(42350))
+    {
+      kP = 0.8;
+      lTargetPositionDegrees = 220;
+    }
+    if (moveTimePassed(43250))
+    {
+      kP = 0.2;
+      lTargetPositionDegrees = 180;
+    }
+
+    // left back
+
+    if (moveTimePassed(50830))
+    {
+      kP = 0.7;
+      lTargetPositionDegrees = 235;
+    }
+
+    if (moveTimePassed(56360))
+    {
+      kP = 0.2;
+      pStepRight(15);
+    }
+
+    // hello people bow
+
+    if (moveTimePassed(59920))
+    {
+      kP = 0.7;
+      pBow(60);
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(textSequence1);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - TEXT SEQUENCE 1 (+10s)
+
+  if (move == textSequence1)
+  {
+    kP = 0.8;
+    pBow(60);
+
+    // hello people bows
+
+    if (moveTimePassed(1500))
+    {
+      kP = 1.6;
+      pBow(90);
+    }
+
+    if (moveTimePassed(2860))
+    {
+      kP = 0.2;
+      pBow(70);
+    }
+
+    if (moveTimePassed(3305))
+    {
+      kP = 1.8;
+      pBow(90);
+    }
+
+    if (moveTimePassed(4500))
+    {
+      kP = 0.2;
+      pBow(70);
+    }
+
+    if (moveTimePassed(4900))
+    {
+      kP = 1.8;
+      pBow(90);
+    }
+
+    if (moveTimePassed(6150))
+    {
+      kP = 0.2;
+      pBow(70);
+    }
+
+    if (moveTimePassed(7070))
+    {
+      kP = 1.8;
+      pBow(90);
+    }
+
+    if (moveTimePassed(8080))
+    {
+      kP = 0.2;
+      pBow(70);
+    }
+
+    if (moveTimePassed(8700))
+    {
+      kP = 1.8;
+      pBow(90);
+    }
+
+    if (moveTimePassed(9880))
+    {
+      kP = 0.2;
+      pBow(70);
+    }
+
+    if (moveTimePassed(10600))
+    {
+      kP = 1.8;
+      pBow(90);
+    }
+
+    if (moveTimePassed(12560))
+    {
+      kP = 0.2;
+      pBow(70);
+    }
+
+    if (moveTimePassed(13640))
+    {
+      kP = 1.8;
+      pBow(90);
+    }
+
+    if (moveTimePassed(14680))
+    {
+      kP = 0.2;
+      pBow(70);
+    }
+
+    // wiggle
+
+    if (moveTimePassed(15800))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 90;
+      lTargetPositionDegrees = 60;
+    }
+
+    if (moveTimePassed(16130))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 60;
+      lTargetPositionDegrees = 90;
+    }
+
+    if (moveTimePassed(16430))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 90;
+      lTargetPositionDegrees = 60;
+    }
+
+    if (moveTimePassed(17680))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 60;
+      lTargetPositionDegrees = 90;
+    }
+
+    if (moveTimePassed(17940))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 90;
+      lTargetPositionDegrees = 60;
+    }
+
+    if (moveTimePassed(18230))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 60;
+      lTargetPositionDegrees = 90;
+    }
+
+    if (moveTimePassed(19090))
+    {
+      kP = 1.2;
+      pBow(90);
+    }
+
+    if (moveTimePassed(21700))
+    {
+      kP = 0.4;
+      pBow(15);
+    }
+
+    // but wait
+
+    if (moveTimePassed(56770))
+    {
+      kP = 1.8;
+      pBow(45);
+    }
+
+    if (moveTimePassed(58070))
+    {
+      kP = 0.2;
+      pStand();
+    }
+
+    if (moveTimePassed(61000))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    if (moveTimePassed(70000))
+    {
+      startMove(musicSequence0);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 0 intro
+
+  if (move == musicSequence0)
+  {
+
+    // bow
+    kP = 1;
+    pBow(10);
+
+    if (moveTimePassed(2200))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    // raise leg, walk.
+
+    if (moveTimePassed(6300))
+    {
+      kP = 1;
+      pKickRight(45);
+    }
+
+    if (moveTimePassed(8670))
+    {
+      kP = 1.4;
+      pStepRight(15);
+    }
+
+    if (moveTimePassed(9570))
+    {
+      kP = 1.4;
+      pStepLeft(15);
+    }
+
+    if (moveTimePassed(10560))
+    {
+      kP = 1.4;
+      pStepRight(15);
+    }
+
+    if (moveTimePassed(11470))
+    {
+      kP = 1.6;
+      pStand();
+    }
+
+    // raise leg, walk.
+
+    if (moveTimePassed(14600))
+    {
+      kP = 1.2;
+      pKickLeft(55);
+    }
+
+    if (moveTimePassed(16550))
+    {
+      kP = 1.4;
+      pStepLeft(20);
+    }
+
+    if (moveTimePassed(17600))
+    {
+      kP = 1.4;
+      pStepRight(20);
+    }
+
+    if (moveTimePassed(18650))
+    {
+      kP = 1.4;
+      pStepLeft(20);
+    }
+
+    if (moveTimePassed(19600))
+    {
+      kP = 1.6;
+      pStand();
+    }
+
+    // breathe
+
+    if (moveTimePassed(20700))
+    {
+      kP = 0.8;
+      pBow(15);
+    }
+
+    if (moveTimePassed(22800))
+    {
+      kP = 1;
+      pBow(4);
+    }
+
+    // walk, pirouette
+
+    if (moveTimePassed(24800))
+    {
+      kP = 1.4;
+      pStepRight(20);
+    }
+
+    if (moveTimePassed(25900))
+    {
+      kP = 1.4;
+      pStepLeft(20);
+    }
+
+    if (moveTimePassed(26900))
+    {
+      kP = 1.4;
+      pStepRight(20);
+    }
+
+    if (moveTimePassed(27900))
+    {
+      kP = 1.4;
+      pStepLeft(20);
+    }
+
+    if (moveTimePassed(28900))
+    {
+      kP = 1.8;
+      pStand();
+    }
+    // pirouette
+
+    if (moveTimePassed(29900))
+    {
+      kP = 3;
+      rTargetPositionDegrees = 200;
+      lTargetPositionDegrees = 170;
+    }
+
+    if (moveTimePassed(30900))
+    {
+      kP = 2;
+      pKickRight(90);
+    }
+    if (moveTimePassed(31350))
+    {
+      kP = 2;
+      pBow(10);
+    }
+    if (moveTimePassed(31700))
+    {
+      kP = 1.8;
+      pStand();
+    }
+
+    // breathe
+    if (moveTimePassed(32870))
+    {
+      kP = 0.8;
+      pBow(15);
+    }
+    if (moveTimePassed(34950))
+    {
+      kP = 1;
+      pBow(4);
+    }
+
+    // jump
+
+    if (moveTimePassed(37150))
+    {
+      kP = 0.6;
+      pBow(45);
+    }
+    if (moveTimePassed(38280))
+    {
+      kP = 4;
+      pBow(-10);
+    }
+    if (moveTimePassed(39000))
+    {
+      kP = 2;
+      pBow(10);
+    }
+    if (moveTimePassed(40200))
+    {
+      kP = 0.8;
+      pStand();
+    }
+
+    // step step flip
+    if (moveTimePassed(43550))
+    {
+      kP = 1.4;
+      pStepRight(20);
+    }
+
+    if (moveTimePassed(44600))
+    {
+      kP = 1.6;
+      pStepLeft(10);
+    }
+
+    if (moveTimePassed(45900))
+    {
+      kP = 3;
+      rTargetPositionDegrees = 90;
+      lTargetPositionDegrees = 190;
+    }
+
+    if (moveTimePassed(46100))
+    {
+      kP = 2;
+      pStepRight(90);
+    }
+
+    if (moveTimePassed(46900))
+    {
+      kP = 1.5;
+      pBow(20);
+    }
+
+    if (moveTimePassed(49840))
+    {
+      kP = 0.8;
+      pStand();
+    }
+
+    // again step step flip
+
+    if (moveTimePassed(54090))
+    {
+      kP = 1.4;
+      pStepRight(20);
+    }
+
+    if (moveTimePassed(55120))
+    {
+      kP = 1.6;
+      pStepLeft(10);
+    }
+
+    if (moveTimePassed(56500))
+    {
+      kP = 3;
+      rTargetPositionDegrees = 90;
+      lTargetPositionDegrees = 190;
+    }
+
+    if (moveTimePassed(56700))
+    {
+      kP = 2;
+      pStepRight(90);
+    }
+
+    if (moveTimePassed(57500))
+    {
+      kP = 1.5;
+      pBow(20);
+    }
+
+    if (moveTimePassed(58500))
+    {
+      kP = 0.8;
+      pStand();
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(musicSequence1);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 1 yoga
+
+  if (move == musicSequence1)
+  {
+
+    kP = 0.8;
+    pStand();
+
+    // bow
+
+    if (moveTimePassed(600))
+    {
+      kP = 0.5;
+      pBow(45);
+    }
+
+    if (moveTimePassed(3160))
+    {
+      kP = 0.8;
+      pStand();
+    }
+
+    // snoek
+
+    // fall to bird
+    if (moveTimePassed(8200))
+    {
+      kP = 1.8;
+      pBow(25);
+    }
+
+    if (moveTimePassed(9200))
+    {
+      kP = 1.2;
+      pBow(15);
+    }
+    if (moveTimePassed(11200))
+    {
+      kP = 2;
+      pStand();
+    }
+
+    // swimming
+    if (moveTimePassed(12100))
+    {
+      kP = 2;
+      pKickRight(-20);
+    }
+    if (moveTimePassed(13000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(14000))
+    {
+      kP = 2;
+      pKickLeft(-20);
+    }
+    if (moveTimePassed(15000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(15985))
+    {
+      kP = 2;
+      pKickRight(-20);
+    }
+    if (moveTimePassed(17000))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(17890))
+    {
+      kP = 2;
+      pKickLeft(-20);
+    }
+    if (moveTimePassed(18900))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(19750))
+    {
+      kP = 2;
+      pKickRight(-20);
+    }
+    if (moveTimePassed(20800))
+    {
+      kP = 0.5;
+      pStand();
+    }
+    if (moveTimePassed(21665))
+    {
+      kP = 2;
+      pKickLeft(-20);
+    }
+    if (moveTimePassed(22650))
+    {
+      kP = 0.5;
+      pStand();
+    }
+
+    // cloth hanger
+    if (moveTimePassed(25240))
+    {
+      kP = 0.3;
+      pBow(90);
+    }
+    if (moveTimePassed(28800))
+    {
+      kP = 2;
+      pBow(76);
+    }
+
+    // kick naar bolkje
+
+    if (moveTimePassed(29860))
+    {
+      kP = 1.2;
+      pKickRight(90);
+    }
+    if (moveTimePassed(33270))
+    {
+      kP = 0.7;
+      pStepRight(75);
+    }
+    if (moveTimePassed(35460))
+    {
+      kP = 1;
+      pStepRight(60);
+    }
+    if (moveTimePassed(36000))
+    {
+      kP = 1.2;
+      pStepRight(50);
+    }
+    if (moveTimePassed(36500))
+    {
+      kP = 1;
+      pStepRight(35);
+    }
+    if (moveTimePassed(37000))
+    {
+      kP = 1.8;
+      pStepRight(10);
+    }
+
+    // swim in bolk
+
+    if (moveTimePassed(38500))
+    {
+      kP = 1;
+      pStepLeft(10);
+    }
+    if (moveTimePassed(40000))
+    {
+      kP = 1;
+      pStepRight(10);
+    }
+    if (moveTimePassed(40800))
+    {
+      kP = 1.2;
+      pStepLeft(10);
+    }
+    if (moveTimePassed(41600))
+    {
+      kP = 1.2;
+      pStepRight(10);
+    }
+
+    // to knees
+    if (moveTimePassed(43600))
+    {
+      kP = 1;
+      pStepLeft(10);
+    }
+
+    if (moveTimePassed(44400))
+    {
+      kP = 0.5;
+      pStepLeft(45);
+    }
+    if (moveTimePassed(45200))
+    {
+      kP = 0.5;
+      pStepLeft(75);
+    }
+    if (moveTimePassed(46000))
+    {
+      kP = 0.7;
+      pStepLeft(90);
+    }
+    if (moveTimePassed(48590))
+    {
+      kP = 0.5;
+      pKickRight(90);
+    }
+    if (moveTimePassed(52600))
+    {
+      kP = 0.6;
+      pBow(90);
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(musicSequence2);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 2 floor
+  if (move == musicSequence2)
+  {
+    kP = 0.6;
+    pBow(90);
+
+    // back to bird
+
+    if (moveTimePassed(450))
+    {
+      kP = 1.4;
+      pKickRight(45);
+    }
+    if (moveTimePassed(950))
+    {
+      kP = 1.4;
+      pKickRight(90);
+    }
+    if (moveTimePassed(4600))
+    {
+      kP = 1;
+      pStand();
+    }
+    if (moveTimePassed(9400))
+    {
+      kP = 2.2;
+      pStand();
+    }
+
+    // back to standing
+    if (moveTimePassed(11140))
+    {
+      kP = 2;
+      pBow(15);
+    }
+
+    if (moveTimePassed(19870))
+    {
+      kP = 2;
+      pBow(10);
+    }
+    if (moveTimePassed(22000))
+    {
+      kP = 1.8;
+      pBow(5);
+    }
+    if (moveTimePassed(24300))
+    {
+      kP = 1.6;
+      pStand();
+    }
+
+    // val naar achteren
+
+    if (moveTimePassed(32470))
+    {
+      kP = 1.6;
+      pBow(-15);
+    }
+
+    if (moveTimePassed(33470))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    if (moveTimePassed(38880))
+    {
+      kP = 1.6;
+      pKickRight(90);
+    }
+
+    if (moveTimePassed(39400))
+    {
+      kP = 2;
+      pKickRight(90);
+    }
+
+    if (moveTimePassed(43740))
+    {
+      kP = 1.2;
+      pKickRight(80);
+    }
+    if (moveTimePassed(43840))
+    {
+      kP = 1.2;
+      pKickRight(70);
+    }
+    if (moveTimePassed(43940))
+    {
+      kP = 1.0;
+      pKickRight(60);
+    }
+    if (moveTimePassed(44040))
+    {
+      kP = 1.0;
+      pKickRight(40);
+    }
+    if (moveTimePassed(44140))
+    {
+      kP = 1.0;
+      pKickRight(20);
+    }
+
+    if (moveTimePassed(44200))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    // zit
+
+    if (moveTimePassed(46870))
+    {
+      kP = 0.2;
+      pBow(45);
+    }
+
+    if (moveTimePassed(47250))
+    {
+      kP = 0.8;
+      pBow(90);
+    }
+
+    // lig
+
+    if (moveTimePassed(56370))
+    {
+      kP = 0.4;
+      pBow(25);
+    }
+    if (moveTimePassed(57370))
+    {
+      kP = 0.4;
+      pStand();
+    }
+
+    // rechts omhoog
+
+    if (moveTimePassed(59700))
+    {
+      kP = 0.6;
+      pKickRight(50);
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(musicSequence3);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 3 floor pt2
+
+  if (move == musicSequence3)
+  {
+    kP = 0.6;
+    pKickRight(50);
+
+    if (moveTimePassed(600))
+    {
+      kP = 0.85;
+      pKickRight(90);
+    }
+
+    // trap naar split
+
+    if (moveTimePassed(7600))
+    {
+      kP = 0.5;
+      rTargetPositionDegrees = 90;
+      lTargetPositionDegrees = 45;
+    }
+    if (moveTimePassed(8200))
+    {
+      kP = 0.5;
+      pBow(90);
+    }
+
+    if (moveTimePassed(8800))
+    {
+      kP = 0.6;
+      pStepLeft(80);
+    }
+    if (moveTimePassed(9800))
+    {
+      kP = 0.8;
+      pStepLeft(90);
+    }
+    if (moveTimePassed(10100))
+    {
+      kP = 1.2;
+      pStepLeft(90);
+    }
+
+    // split opduwen
+
+    if (moveTimePassed(17500))
+    {
+      kP = 3;
+      pStepLeft(45);
+    }
+
+    if (moveTimePassed(18000))
+    {
+      kP = 2;
+      pStepLeft(45);
+    }
+
+    if (moveTimePassed(20720))
+    {
+      kP = 0.6;
+      pStepLeft(90);
+    }
+    if (moveTimePassed(24430))
+    {
+      kP = 0.7;
+      pStepLeft(90);
+    }
+
+    // split wissel
+
+    if (moveTimePassed(31580))
+    {
+      kP = 0.5;
+      pKickLeft(90);
+    }
+
+    if (moveTimePassed(32580))
+    {
+      kP = 0.6;
+      pStepRight(80);
+    }
+
+    if (moveTimePassed(33100))
+    {
+      kP = 0.6;
+      pStepRight(90);
+    }
+
+    // naar rug
+
+    if (moveTimePassed(35650))
+    {
+      kP = 1;
+      pBow(30);
+    }
+
+    if (moveTimePassed(36200))
+    {
+      kP = 0.6;
+      rTargetPositionDegrees = 200;
+      lTargetPositionDegrees = 150;
+    }
+
+    if (moveTimePassed(37200))
+    {
+      kP = 1.2;
+      rTargetPositionDegrees = 180;
+      lTargetPositionDegrees = 170;
+    }
+
+    if (moveTimePassed(37500))
+    {
+      kP = 1.2;
+      pStand();
+    }
+
+    // rol naar zij
+
+    if (moveTimePassed(39700))
+    {
+      kP = 1.4;
+      pStepRight(25);
+    }
+
+    if (moveTimePassed(41550))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 120;
+      lTargetPositionDegrees = 210;
+    }
+
+    if (moveTimePassed(43700))
+    {
+      kP = 1.2;
+      rTargetPositionDegrees = 200;
+      lTargetPositionDegrees = 190;
+    }
+
+    if (moveTimePassed(44630))
+    {
+      kP = 1;
+      rTargetPositionDegrees = 130;
+      lTargetPositionDegrees = 200;
+    }
+
+    // buik
+    if (moveTimePassed(44630))
+    {
+      kP = 0.8;
+      pBow(-10);
+    }
+
+    // been omhoog
+
+    if (moveTimePassed(51950))
+    {
+      kP = 0.7;
+      pKickRight(-80);
+    }
+    if (moveTimePassed(54020))
+    {
+      kP = 0.8;
+      pBow(-80);
+    }
+    if (moveTimePassed(55020))
+    {
+      kP = 1.2;
+      pBow(-85);
+    }
+
+    // staan
+
+    if (moveTimePassed(58090))
+    {
+      kP = 0.5;
+      pStand();
+    }
+
+    if (moveTimePassed(59090))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(musicSequence4);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 4 standing acro
+
+  if (move == musicSequence4)
+  {
+    kP = 1.2;
+    pStand();
+
+    // walk
+    if (moveTimePassed(185))
+    {
+      kP = 1.4;
+      pStepRight(20);
+    }
+    if (moveTimePassed(1250))
+    {
+      pStepLeft(20);
+    }
+
+    if (moveTimePassed(2215))
+    {
+      pStepRight(20);
+    }
+    if (moveTimePassed(3265))
+    {
+      pStepLeft(20);
+    }
+
+    if (moveTimePassed(4305))
+    {
+      pStepRight(20);
+    }
+    if (moveTimePassed(5350))
+    {
+      pStepLeft(20);
+    }
+
+    if (moveTimePassed(6435))
+    {
+      kP = 1.7;
+      pStand();
+    }
+
+    // rug rol
+
+    if (moveTimePassed(9790))
+    {
+      kP = 0.8;
+      pBow(90);
+    }
+
+    if (moveTimePassed(11850))
+    {
+      kP = 1.3;
+      pBow(90);
+    }
+
+    if (moveTimePassed(15150))
+    {
+      kP = 0.6;
+      pStand();
+    }
+
+    // shoulder sit
+
+    if (moveTimePassed(21740))
+    {
+      kP = 0.8;
+      pBow(15);
+    }
+    if (moveTimePassed(22780))
+    {
+      kP = 0.8;
+      pBow(30);
+    }
+    if (moveTimePassed(24380))
+    {
+      kP = 1;
+      pBow(70);
+    }
+
+    // uitbouw
+
+    if (moveTimePassed(28780))
+    {
+      kP = 0.8;
+      pKickLeft(70);
+    }
+
+    if (moveTimePassed(30885))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    if (moveTimePassed(32120))
+    {
+      kP = 1;
+      pBow(-20);
+    }
+
+    if (moveTimePassed(35436))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    if (moveTimePassed(36975))
+    {
+      kP = 1;
+      lTargetPositionDegrees = 170;
+      rTargetPositionDegrees = 162;
+    }
+
+    if (moveTimePassed(37600))
+    {
+      kP = 1.8;
+      pStand();
+    }
+
+    // schouder snoek
+
+    if (moveTimePassed(40500))
+    {
+      kP = 1.8;
+      pKickRight(-14);
+    }
+
+    if (moveTimePassed(41100))
+    {
+      kP = 1.6;
+      pKickRight(80);
+    }
+
+    if (moveTimePassed(41400))
+    {
+      kP = 1.4;
+      pStepRight(90);
+    }
+
+    if (moveTimePassed(42100))
+    {
+      kP = 1.0;
+      pBow(30);
+    }
+
+    if (moveTimePassed(43000))
+    {
+      kP = 1.0;
+      pBow(-10);
+    }
+
+    // kopstand
+
+    if (moveTimePassed(48335))
+    {
+      kP = 0.2;
+      pBow(50);
+    }
+    if (moveTimePassed(48800))
+    {
+      kP = 0.5;
+      lTargetPositionDegrees = 110;
+      rTargetPositionDegrees = 90;
+    }
+
+    if (moveTimePassed(49999))
+    {
+      startMove(musicSequence5);
+      // jump in time, 50 second sequence to match with full act sound timing
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 5 fall
+
+  if (move == musicSequence5)
+  {
+
+    // starts going into headstand split
+
+    if (moveTimePassed(1925))
+    {
+      kP = 0.6;
+      lTargetPositionDegrees = 150;
+      rTargetPositionDegrees = 90;
+    }
+
+    if (moveTimePassed(3600))
+    {
+      kP = 0.6;
+      lTargetPositionDegrees = 275;
+      rTargetPositionDegrees = 90;
+    }
+
+    if (moveTimePassed(3900))
+    {
+      kP = 0.8;
+      lTargetPositionDegrees = 275;
+      rTargetPositionDegrees = 90;
+    }
+
+    if (moveTimePassed(10335))
+    {
+      kP = 1;
+      lTargetPositionDegrees = 267;
+      rTargetPositionDegrees = 120;
+    }
+
+    // coming down
+
+    if (moveTimePassed(14425))
+    {
+      kP = 0.8;
+      pBow(60);
+    }
+
+    if (moveTimePassed(15646))
+    {
+      kP = 1;
+      pBow(85);
+    }
+
+    if (moveTimePassed(16432))
+    {
+      kP = 0.4;
+      pStand();
+    }
+    if (moveTimePassed(17255))
+    {
+      kP = 1.2;
+      pStand();
+    }
+
+    // fall
+
+    if (moveTimePassed(19309))
+    {
+      kP = 0.6;
+      pBow(-10);
+    }
+    if (moveTimePassed(21050))
+    {
+      kP = 0.6;
+      pBow(10);
+    }
+    if (moveTimePassed(20709))
+    {
+      kP = 1.2;
+      pBow(10);
+    }
+
+    // I don't care 2
+
+    if (moveTimePassed(52500))
+    {
+      kP = 1.2;
+
+      lTargetPositionDegrees = 150;
+      rTargetPositionDegrees = 175;
+    }
+
+    if (moveTimePassed(53700))
+    {
+      kP = 1.2;
+
+      lTargetPositionDegrees = 205;
+      rTargetPositionDegrees = 170;
+    }
+    if (moveTimePassed(54100))
+    {
+      kP = 0.4;
+      lTargetPositionDegrees = 185;
+      rTargetPositionDegrees = 175;
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(musicSequence6);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 6 floor dialog
+
+  if (move == musicSequence6)
+  {
+
+    // I want to see them
+
+    if (moveTimePassed(2450))
+    {
+      kP = 0.9;
+      pBow(25);
+    }
+    if (moveTimePassed(4340))
+    {
+      kP = 0.9;
+      pBow(5);
+    }
+
+    if (moveTimePassed(8025))
+    {
+      kP = 0.9;
+      pKickRight(40);
+    }
+    if (moveTimePassed(8800))
+    {
+      kP = 0.8;
+      pStand();
+    }
+
+    if (moveTimePassed(14500))
+    {
+      kP = 1.5;
+      pKickRight(-10);
+    }
+    if (moveTimePassed(14930))
+    {
+      kP = 1.6;
+      pKickRight(40);
+    }
+    if (moveTimePassed(15280))
+    {
+      kP = 1.2;
+      pStepRight(12);
+    }
+
+    // hello people
+
+    if (moveTimePassed(22222))
+    {
+      kP = 1.4;
+      pStand();
+    }
+
+    if (moveTimePassed(29635))
+    {
+      kP = 1;
+      pKickRight(50);
+    }
+    if (moveTimePassed(31735))
+    {
+      kP = 1;
+      pStand();
+    }
+
+    // I'm ready
+
+    if (moveTimePassed(40575))
+    {
+      kP = 1;
+      pBow(15);
+    }
+    if (moveTimePassed(41600))
+    {
+      kP = 1.2;
+      pStand();
+    }
+
+    // finale
+
+    if (moveTimePassed(55485))
+    {
+      kP = 1.2;
+      pKickRight(30);
+    }
+
+    if (moveTimePassed(57240))
+    {
+      kP = 1.2;
+
+      lTargetPositionDegrees = 185;
+      rTargetPositionDegrees = 160;
+    }
+    if (moveTimePassed(59400))
+    {
+      kP = 1.2;
+
+      pBow(20);
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(musicSequence7);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 7 finale
+
+  if (move == musicSequence7)
+  {
+
+    kP = 1.2;
+
+    pBow(20);
+
+    if (moveTimePassed(1765))
+    {
+      kP = 1;
+
+      lTargetPositionDegrees = 100;
+      rTargetPositionDegrees = 160;
+    }
+
+    if (moveTimePassed(6360))
+    {
+      kP = 1.6;
+
+      lTargetPositionDegrees = 110;
+      rTargetPositionDegrees = 170;
+    }
+
+    if (moveTimePassed(7435))
+    {
+      kP = 1.2;
+
+      pStand();
+    }
+
+    if (moveTimePassed(13204))
+    {
+      kP = 1;
+
+      pKickLeft(10);
+    }
+
+    if (moveTimePassed(13510))
+    {
+      kP = 1;
+
+      pKickLeft(20);
+    }
+
+    if (moveTimePassed(13800))
+    {
+      kP = 1;
+
+      pKickLeft(30);
+    }
+
+    if (moveTimePassed(14085))
+    {
+      kP = 1;
+
+      pKickLeft(40);
+    }
+
+    if (moveTimePassed(14390))
+    {
+      kP = 1;
+
+      pKickLeft(50);
+    }
+
+    if (moveTimePassed(14650))
+    {
+      kP = 1;
+
+      pKickLeft(65);
+    }
+
+    if (moveTimePassed(14960))
+    {
+      kP = 1.2;
+
+      pKickLeft(90);
+    }
+
+    // stand
+
+    if (moveTimePassed(14960))
+    {
+      kP = 0.4;
+
+      pStand();
+    }
+
+    if (moveTimePassed(19460))
+    {
+      kP = 1.2;
+
+      pStand();
+    }
+
+    // bows
+
+    if (moveTimePassed(23188))
+    {
+      kP = 0.6;
+
+      pBow(80);
+    }
+
+    if (moveTimePassed(24741))
+    {
+      kP = 1.0;
+
+      pStand();
+    }
+
+    // walk
+
+    if (moveTimePassed(28740))
+    {
+      kP = 1.6;
+      pStepRight(15);
+    }
+    if (moveTimePassed(29245))
+    {
+      kP = 1.5;
+      pStepLeft(15);
+    }
+    if (moveTimePassed(29995))
+    {
+      kP = 1.5;
+      pStepRight(15);
+    }
+    if (moveTimePassed(30680))
+    {
+      kP = 1.7;
+      pStand();
+    }
+
+    if (moveTimePassed(32190))
+    {
+      kP = 0.6;
+
+      pBow(80);
+    }
+
+    if (moveTimePassed(33765))
+    {
+      kP = 1.2;
+
+      pStand();
+    }
+
+    // mini bow
+
+    if (moveTimePassed(35975))
+    {
+      kP = 0.8;
+
+      pBow(10);
+    }
+
+    if (moveTimePassed(37870))
+    {
+      kP = 0.8;
+
+      pBow(1);
+    }
+
+    // hug
+
+    if (moveTimePassed(37870))
+    {
+      kP = 2;
+
+      pBow(20);
+    }
+
+    if (moveTimePassed(37870))
+    {
+      kP = 1;
+
+      pStand();
+    }
+
+    // walk
+
+    if (moveTimePassed(49526))
+    {
+      kP = 1.5;
+      pStepRight(15);
+    }
+    if (moveTimePassed(50250))
+    {
+      kP = 1.5;
+      pStepLeft(15);
+    }
+    if (moveTimePassed(51025))
+    {
+      kP = 1.5;
+      pStepRight(15);
+    }
+    if (moveTimePassed(51740))
+    {
+      kP = 1.5;
+      pStepLeft(15);
+    }
+    if (moveTimePassed(52515))
+    {
+      kP = 1.5;
+      pStepRight(15);
+    }
+    if (moveTimePassed(53245))
+    {
+      kP = 1.5;
+      pStepLeft(15);
+    }
+    if (moveTimePassed(53960))
+    {
+      kP = 1.5;
+      pStepRight(15);
+    }
+    if (moveTimePassed(54690))
+    {
+      kP = 1.5;
+      pStand();
+    }
+
+    if (moveTimePassed(60000))
+    {
+      startMove(musicSequence8);
+    }
+  }
+
+  // --------------------------------
+  // MARK: - MUSIC SEQUENCE 8 toilet
+
+  if (move == musicSequence8)
+  {
+
+    kP = 1.2;
+    pStand();
+
+    if (moveTimePassed(8090))
+    {
+      kP = 1.5;
+      pKickRight(80);
+    }
+    if (moveTimePassed(8790))
+    {
+      kP = 1.5;
+      pKickLeft(80);
+    }
+    if (moveTimePassed(9480))
+    {
+      kP = 1.5;
+      pBow(80);
+    }
+
+    if (moveTimePassed(10320))
+    {
+      kP = 0.2;
+      pStand();
+    }
+
+    // splits
+
+    if (moveTimePassed(17500))
+    {
+      kP = 2;
+      pStepRight(80);
+    }
+    if (moveTimePassed(18400))
+    {
+      kP = 2;
+      pStepLeft(80);
+    }
+    if (moveTimePassed(19300))
+    {
+      kP = 2;
+      pStepRight(90);
+    }
+    if (moveTimePassed(20200))
+    {
+      kP = 2;
+      pStepLeft(90);
+    }
+
+    // forward backward
+
+    if (moveTimePassed(21475))
+    {
+      kP = 2;
+      pBow(80);
+    }
+    if (moveTimePassed(22200))
+    {
+      kP = 2;
+      pBow(-80);
+    }
+
+    if (moveTimePassed(22600))
+    {
+      kP = 2;
+      pBow(90);
+    }
+    if (moveTimePassed(23455))
+    {
+      kP = 2;
+      pBow(-80);
+    }
+    if (moveTimePassed(23725))
+    {
+      kP = 2;
+      pBow(90);
+    }
+
+    if (moveTimePassed(24900))
+    {
+      kP = 0.3;
+      pStand();
+    }
+  }
+}
+
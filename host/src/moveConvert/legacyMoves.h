@@ -0,0 +1,25 @@
+#ifndef LEGACY_MOVES_H
+#define LEGACY_MOVES_H
+
+#include <sequences.h>
+
+#include <stdint.h>
+
+// The updateMoves() if-chain as it was in remote/src/main.cpp before the
+// moves became timelines, kept verbatim in legacyMoves.cpp as the reference
+// moveConvert replays. It reads and writes these, like it did the remote's
+// globals.
+
+extern moveList move;
+extern uint32_t moveTimer;
+extern double kP;
+extern uint16_t rTargetPositionDegrees;
+extern uint16_t lTargetPositionDegrees;
+
+extern uint32_t legacyMillis;  // virtual clock
+extern int legacyRestart;      // move passed to startMove() from inside, -1 = none
+extern uint32_t legacyLastTime; // largest time asked of moveTimePassed()
+
+void updateMoves();
+
+#endif
@@ -0,0 +1,266 @@
+/*
+Title: Acrobot move converter
+Description: Replays every move of the old updateMoves() if-chain against a
+virtual clock at 1 ms steps, records each change of kP and the two targets,
+and writes the changes as keyframe timelines: the text format of showCompile,
+or with --cpp the tables of shared/Choreography/sequences.cpp. The report on
+stderr plays the keyframes back with the firmware's TimelinePlayer and
+compares them with the replay at every millisecond, and with the built-in
+sequences.
+
+Usage: moveConvert [--cpp] [-o file]
+*/
+
+#include "legacyMoves.h"
+
+#include <sequences.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+const uint32_t MAX_LENGTH = 400000; // ms, longer than any move
+const int UNSET = -1;
+
+// one millisecond of the replay: right, left, kP x100, UNSET if not written
+struct Sample
+{
+  int values[3];
+
+  bool isSet() const { return values[0] != UNSET; }
+  bool operator!=(const Sample &other) const { return memcmp(values, other.values, sizeof(values)) != 0; }
+};
+
+struct Converted
+{
+  std::vector<Sample> samples;
+  std::vector<struct_keyframe> keyframes;
+  uint32_t duration = 0;
+  int next = -1;
+};
+
+Converted replay(moveList theMove)
+{
+  Converted result;
+  legacyLastTime = 0;
+  Sample last = {{UNSET, UNSET, UNSET}};
+
+  for (uint32_t elapsed = 0; elapsed < MAX_LENGTH; elapsed++)
+  {
+    // fresh each tick, so a tick that writes nothing shows up as unset
+    move = theMove;
+    moveTimer = 1000000;
+    legacyMillis = moveTimer + elapsed;
+    legacyRestart = -1;
+    kP = -1;
+    rTargetPositionDegrees = lTargetPositionDegrees = UINT16_MAX;
+
+    updateMoves();
+
+    // restarted itself or the next move: that is where the timeline ends
+    if (legacyRestart >= 0 && elapsed > 0)
+    {
+      result.duration = elapsed;
+      result.next = legacyRestart;
+      break;
+    }
+
+    Sample sample = {{rTargetPositionDegrees == UINT16_MAX ? UNSET : rTargetPositionDegrees,
+                      lTargetPositionDegrees == UINT16_MAX ? UNSET : lTargetPositionDegrees,
+                      kP < 0 ? UNSET : (int)(kP * 100 + 0.5)}};
+    if (sample.isSet() && (sample.values[1] == UNSET || sample.values[2] == UNSET))
+    {
+      fprintf(stderr, "warning: %s writes only part of the state at %u ms\n",
+              sequences[theMove].name, elapsed);
+    }
+
+    if (sample.isSet() && sample != last)
+    {
+      result.keyframes.push_back({elapsed, (uint16_t)sample.values[0], (uint16_t)sample.values[1],
+                                  (uint16_t)sample.values[2], INTERP_STEP, 0});
+      last = sample;
+    }
+    result.samples.push_back(sample);
+
+    // nothing changes after the last time it asks for
+    if (elapsed > legacyLastTime + 2)
+    {
+      break;
+    }
+  }
+  return result;
+}
+
+// plays a timeline with the firmware's player and finds the first millisecond
+// that differs from the samples, -1 if none
+long compare(const struct_timeline &timeline, const std::vector<Sample> &samples)
+{
+  struct_timeline alone = timeline;
+  alone.next = -1; // the replay stops where the next move starts
+  alone.duration = 0;
+  TimelineLibrary library(&alone, 1);
+  TimelinePlayer player(library);
+  player.start(0, 0);
+
+  for (uint32_t t = 0; t < samples.size(); t++)
+  {
+    struct_timeline_state state;
+    Sample played = {{UNSET, UNSET, UNSET}};
+    if (player.update(t, state))
+    {
+      // rounded like the remote does
+      played = {{(int)(state.rTarget + 0.5f), (int)(state.lTarget + 0.5f), (int)(state.kP * 100 + 0.5f)}};
+    }
+    if (played != samples[t])
+    {
+      return t;
+    }
+  }
+  return -1;
+}
+
+void writeShow(FILE *out, const std::vector<Converted> &moves)
+{
+  // the old code sets some targets directly, past the limits its helpers clamp to
+  int low = forwardLimit, high = backwardLimit;
+  for (const Converted &converted : moves)
+  {
+    for (const struct_keyframe &k : converted.keyframes)
+    {
+      low = std::min(low, (int)std::min(k.rTarget, k.lTarget));
+      high = std::max(high, (int)std::max(k.rTarget, k.lTarget));
+    }
+  }
+
+  fprintf(out, "# converted from the old updateMoves() by moveConvert\n\n");
+  fprintf(out, "limits %d %d%s\n", low, high,
+          low < forwardLimit || high > backwardLimit ? " # widened to fit the old moves" : "");
+
+  for (int m = stand; m < MOVE_COUNT; m++)
+  {
+    const Converted &converted = moves[m];
+    if (converted.keyframes.empty())
+    {
+      continue;
+    }
+    fprintf(out, "\ntimeline %s", sequences[m].name);
+    if (converted.duration)
+    {
+      fprintf(out, " duration %u next %s", converted.duration, sequences[converted.next].name);
+    }
+    fprintf(out, "\n");
+    for (const struct_keyframe &k : converted.keyframes)
+    {
+      fprintf(out, "  at %u pose %u %u kp %g step\n", k.time, k.rTarget, k.lTarget, k.kP / 100.);
+    }
+    fprintf(out, "end\n");
+  }
+}
+
+void writeCpp(FILE *out, const std::vector<Converted> &moves)
+{
+  for (int m = stand; m < MOVE_COUNT; m++)
+  {
+    const Converted &converted = moves[m];
+    if (converted.keyframes.empty())
+    {
+      continue;
+    }
+    fprintf(out, "// --------------------------------\n// MARK: - %s\n\n", sequences[m].name);
+    fprintf(out, "const struct_keyframe %sKeyframes[] = {\n", sequences[m].name);
+    fprintf(out, "    // time, right, left, kP x100, interpolation\n");
+    for (const struct_keyframe &k : converted.keyframes)
+    {
+      fprintf(out, "    {%u, %u, %u, %u, INTERP_STEP},\n", k.time, k.rTarget, k.lTarget, k.kP);
+    }
+    fprintf(out, "};\n\n");
+  }
+
+  fprintf(out, "const struct_timeline sequences[MOVE_COUNT] = {\n");
+  for (int m = 0; m < MOVE_COUNT; m++)
+  {
+    const Converted &converted = moves[m];
+    const char *name = sequences[m].name;
+    if (converted.keyframes.empty())
+    {
+      fprintf(out, "    {\"%s\", nullptr, 0, 0, -1},\n", name);
+      continue;
+    }
+    fprintf(out, "    {\"%s\", %sKeyframes, KEYFRAME_COUNT(%sKeyframes), %u, %s},\n", name, name,
+            name, converted.duration, converted.next >= 0 ? sequences[converted.next].name : "-1");
+  }
+  fprintf(out, "};\n");
+}
+
+int main(int argc, char **argv)
+{
+  bool cpp = false;
+  const char *output = nullptr;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--cpp") == 0)
+    {
+      cpp = true;
+    }
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+    {
+      output = argv[++i];
+    }
+    else
+    {
+      fprintf(stderr, "usage: moveConvert [--cpp] [-o file]\n");
+      return 2;
+    }
+  }
+
+  // stop and relax follow the leg live, they are not timelines
+  std::vector<Converted> moves(MOVE_COUNT);
+  for (int m = stand; m < MOVE_COUNT; m++)
+  {
+    moves[m] = replay((moveList)m);
+  }
+
+  fprintf(stderr, "%-18s %8s %9s %10s %-10s %s\n", "move", "ms", "keyframes", "replay", "built-in",
+          "next");
+  int failures = 0;
+  for (int m = stand; m < MOVE_COUNT; m++)
+  {
+    const Converted &converted = moves[m];
+    struct_timeline timeline = {sequences[m].name, converted.keyframes.data(),
+                                (uint16_t)converted.keyframes.size(), converted.duration,
+                                (int16_t)converted.next};
+
+    long replayDiff = compare(timeline, converted.samples);
+    long builtinDiff = compare(sequences[m], converted.samples);
+    failures += replayDiff >= 0;
+
+    char replayText[24], builtinText[24];
+    snprintf(replayText, sizeof(replayText), replayDiff < 0 ? "identical" : "at %ld ms", replayDiff);
+    snprintf(builtinText, sizeof(builtinText), builtinDiff < 0 ? "identical" : "at %ld ms", builtinDiff);
+    fprintf(stderr, "%-18s %8zu %9zu %10s %-10s %s\n", sequences[m].name, converted.samples.size(),
+            converted.keyframes.size(), replayText, builtinText,
+            converted.next >= 0 ? sequences[converted.next].name : "-");
+  }
+
+  FILE *out = output ? fopen(output, "w") : stdout;
+  if (!out)
+  {
+    perror(output);
+    return 1;
+  }
+  if (cpp)
+  {
+    writeCpp(out, moves);
+  }
+  else
+  {
+    writeShow(out, moves);
+  }
+  if (output)
+  {
+    fclose(out);
+  }
+  return failures ? 1 : 0;
+}
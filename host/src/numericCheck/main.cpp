@@ -0,0 +1,476 @@
+/*
+Title: Acrobot numeric check
+Description: Holds the leg's control path against the double one it started
+with: updatePositions() with fmod() against the wrapped count and against
+Angle, and PID_v1 in double against FloatPid and IntPid.
+
+1. Positions: every raw encoder reading of both joints, old against new.
+2. Angles: Angle's wrapping sums, differences and comparisons for every pair
+   of counts, and its conversions, against plain integer and double math.
+3. Same inputs: every built-in timeline (or those of a show image) plays
+   through the double path and the model joints of common/legModel.h. At
+   every 1 ms sample a FloatPid and an IntPid get the same setpoint and
+   input, and their outputs and motor duties are compared. IntPid's are in
+   counts, so it is held against a second double PID given them in degrees.
+   An output within the tolerance of +-1 may land on the other side of the
+   deadband, those are only counted.
+4. Closed loop: the float and the integer path drive joints of their own,
+   and their positions are compared with those of the double path.
+
+Both PID passes run with the timelines' kP alone, as the remote sends it, and
+again with an integral and a derivative term. Anything past the tolerances
+below exits with 1.
+
+Last, a benchmark of the three paths per control tick. The host has a double
+precision FPU, so the difference there is mostly fmod(). The ESP32 numbers
+come from the leg's env:bench (leg/src/NumericBench.h).
+
+Usage: numericCheck [image]
+*/
+
+#include "../common/legModel.h"
+
+#include <angle.h>
+#include <floatPid.h>
+#include <intPid.h>
+#include <sequences.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+const uint32_t SETTLE = 1000;          // ms after the last keyframe of a holding timeline
+const uint8_t SUBSTEPS = 4;            // plant steps per 1 ms PID sample
+const double MAX_OUTPUT_ERROR = 0.01;  // PWM, from the same inputs
+const int16_t MAX_DUTY_ERROR = 1;      // map() truncates, an output on a boundary can go either way
+const double MAX_TRACKING_ERROR = 1;   // degrees, between the closed loops
+const uint32_t BENCH_TICKS = 2000000;
+
+struct Gains
+{
+  const char *name;
+  double kI;
+  double kD;
+};
+
+const Gains GAINS[] = {{"kP", 0, 0}, {"kP kI kD", 1, 0.02}};
+
+// updatePositions() as it was
+static double positionDouble(uint16_t raw, uint16_t neutral, bool left)
+{
+  double degrees = fmod(((raw + neutral) / 4096.) * 360, 360);
+  return left ? 360 - degrees : degrees;
+}
+
+// and as it is
+static float positionFloat(uint16_t raw, uint16_t neutral, bool left)
+{
+  float degrees = ((raw + neutral) % 4096) * (360.f / 4096);
+  return left ? 360 - degrees : degrees;
+}
+
+// and in counts
+static Angle positionAngle(uint16_t raw, uint16_t neutral, bool left)
+{
+  return left ? Angle::fromCounts(-(raw + neutral)) : Angle::fromCounts(raw + neutral);
+}
+
+// what the encoder reads for a joint at degrees
+static uint16_t rawReading(double degrees, uint16_t neutral, bool left)
+{
+  int32_t count = (int32_t)floor(degrees / 360 * 4096);
+  count = left ? -count : count;
+  return (((count - neutral) % 4096) + 4096) % 4096;
+}
+
+// PID_v1 as the leg ran it, in double: DIRECT, proportional on error, 1 ms
+// samples, a sample per compute()
+class DoublePid
+{
+public:
+  DoublePid() : kp(0), ki(0), kd(0), outputSum(0), lastInput(0)
+  {
+  }
+
+  void setTunings(double kP, double kI, double kD)
+  {
+    kp = kP;
+    ki = kI * 0.001;
+    kd = kD / 0.001;
+  }
+
+  double compute(double setpoint, double input)
+  {
+    double error = setpoint - input;
+    double dInput = input - lastInput;
+    outputSum = fmin(fmax(outputSum + ki * error, -Robot::Pwm::RANGE), Robot::Pwm::RANGE);
+    double output = kp * error + outputSum - kd * dInput;
+    lastInput = input;
+    return fmin(fmax(output, -Robot::Pwm::RANGE), Robot::Pwm::RANGE);
+  }
+
+  void reset(double input)
+  {
+    outputSum = 0;
+    lastInput = input;
+  }
+
+private:
+  double kp, ki, kd;
+  double outputSum;
+  double lastInput;
+};
+
+// a FloatPid set up as pidInit() does
+struct FloatJoint
+{
+  float setpoint = 0, input = 0, output = 0;
+  FloatPid pid;
+
+  FloatJoint(float start) : input(start), pid(&input, &output, &setpoint, 0, 0, 0)
+  {
+    pid.setOutputLimits(-Robot::Pwm::RANGE, Robot::Pwm::RANGE);
+    pid.setSampleTime(1);
+    pid.start();
+  }
+  FloatJoint(const FloatJoint &) = delete; // the pid points into it
+};
+
+// an IntPid set up as pidInit() does
+struct IntJoint
+{
+  IntPid pid;
+
+  IntJoint(Angle start) : pid(Robot::Pwm::RANGE, 1)
+  {
+    pid.start(start);
+  }
+
+  double compute(Angle setpoint, Angle input, uint32_t now)
+  {
+    pid.compute(setpoint, input, now);
+    return (double)pid.getOutput() / IntPid::ONE;
+  }
+};
+
+// a floating point output as IntPid has it, for legDuty(); truncating
+// keeps the PWM the map() on longs made of it
+static int32_t fixedOutput(double output)
+{
+  return (int32_t)(output * IntPid::ONE);
+}
+
+// of one path against the double one
+struct Result
+{
+  double outputError = 0;
+  int16_t dutyError = 0;
+  uint32_t deadbandFlips = 0;
+  double trackingError = 0;
+  uint32_t samples = 0;
+
+  void compare(double expected, double output, int16_t expectedDuty, int16_t duty)
+  {
+    outputError = fmax(outputError, fabs(expected - output));
+    int16_t error = abs(expectedDuty - duty);
+    if (error > MAX_DUTY_ERROR && fabs(fabs(expected) - 1) <= MAX_OUTPUT_ERROR)
+    {
+      deadbandFlips++;
+    }
+    else
+    {
+      dutyError = std::max(dutyError, error);
+    }
+    samples++;
+  }
+
+  bool print(const char *gains, const char *path)
+  {
+    bool bad = outputError > MAX_OUTPUT_ERROR || dutyError > MAX_DUTY_ERROR ||
+               trackingError > MAX_TRACKING_ERROR;
+    printf("%s, %s: %u samples, max output error %.6f, max duty error %d (%u flips at the "
+           "deadband), max tracking error %.4f degrees%s\n",
+           gains, path, samples, outputError, dutyError, deadbandFlips, trackingError,
+           bad ? "  FAILED" : "");
+    return bad;
+  }
+};
+
+PlantParameters parameters;
+
+static void check(TimelineLibrary &library, int16_t index, const Gains &gains, Result &floats,
+                  Result &ints)
+{
+  struct_timeline timeline;
+  library.get(index, timeline);
+  if (!timeline.count)
+  {
+    return;
+  }
+  TimelinePlayer player(library);
+  player.start(index, 0);
+  uint32_t end =
+      timeline.duration ? timeline.duration : timeline.keyframes[timeline.count - 1].time + SETTLE;
+
+  const uint16_t neutrals[2] = {Robot::RightLeg::NEUTRAL, Robot::LeftLeg::NEUTRAL};
+  double setpoints[2] = {(double)timeline.keyframes[0].rTarget,
+                         (double)timeline.keyframes[0].lTarget};
+  float kP = timeline.keyframes[0].kP / 100.f; // as it goes over the air
+  LegPlant doublePlants[2] = {LegPlant(parameters), LegPlant(parameters)};
+  LegPlant floatPlants[2] = {LegPlant(parameters), LegPlant(parameters)};
+  LegPlant intPlants[2] = {LegPlant(parameters), LegPlant(parameters)};
+  DoublePid doublePids[2], countPids[2];
+  float starts[2];
+  Angle angleStarts[2];
+  int16_t doubleDuties[2] = {0, 0}, countDuties[2] = {0, 0};
+  int16_t sameDuties[2] = {0, 0}, closedDuties[2] = {0, 0};
+  int16_t sameIntDuties[2] = {0, 0}, closedIntDuties[2] = {0, 0};
+  for (int joint = 0; joint < 2; joint++)
+  {
+    doublePlants[joint].reset(setpoints[joint]);
+    floatPlants[joint].reset(setpoints[joint]);
+    intPlants[joint].reset(setpoints[joint]);
+    bool left = joint == 1;
+    uint16_t raw = rawReading(doublePlants[joint].getPosition(), neutrals[joint], left);
+    doublePids[joint].reset(positionDouble(raw, neutrals[joint], left));
+    starts[joint] = positionFloat(raw, neutrals[joint], left);
+    angleStarts[joint] = positionAngle(raw, neutrals[joint], left);
+    countPids[joint].reset(angleStarts[joint].toDegrees());
+  }
+  FloatJoint same[2] = {FloatJoint(starts[0]), FloatJoint(starts[1])};
+  FloatJoint closed[2] = {FloatJoint(starts[0]), FloatJoint(starts[1])};
+  IntJoint sameInt[2] = {IntJoint(angleStarts[0]), IntJoint(angleStarts[1])};
+  IntJoint closedInt[2] = {IntJoint(angleStarts[0]), IntJoint(angleStarts[1])};
+
+  for (uint32_t t = 0; t < end; t++)
+  {
+    struct_timeline_state state;
+    if (player.update(t, state))
+    {
+      setpoints[0] = state.rTarget;
+      setpoints[1] = state.lTarget;
+      kP = state.kP;
+    }
+
+    for (int joint = 0; joint < 2; joint++)
+    {
+      bool left = joint == 1;
+      uint16_t neutral = neutrals[joint];
+
+      uint16_t raw = rawReading(doublePlants[joint].getPosition(), neutral, left);
+      double input = positionDouble(raw, neutral, left);
+      doublePids[joint].setTunings(kP, gains.kI, gains.kD);
+      double output = doublePids[joint].compute(setpoints[joint], input);
+      doubleDuties[joint] = legDuty(joint, fixedOutput(output), doubleDuties[joint]);
+
+      FloatJoint &s = same[joint];
+      s.setpoint = setpoints[joint];
+      s.input = positionFloat(raw, neutral, left);
+      s.pid.setTunings(kP, gains.kI, gains.kD);
+      s.pid.compute(t);
+      sameDuties[joint] = legDuty(joint, fixedOutput(s.output), sameDuties[joint]);
+      floats.compare(output, s.output, doubleDuties[joint], sameDuties[joint]);
+
+      // the setpoint to the nearest count and a reading of 0 for 360, as
+      // updatePID() and updatePositions() have them
+      Angle setpoint = Angle::fromDegrees(setpoints[joint]);
+      Angle angle = positionAngle(raw, neutral, left);
+      countPids[joint].setTunings(kP, gains.kI, gains.kD);
+      double countOutput = countPids[joint].compute(setpoint.toDegrees(), angle.toDegrees());
+      countDuties[joint] = legDuty(joint, fixedOutput(countOutput), countDuties[joint]);
+      sameInt[joint].pid.setTunings(kP, gains.kI, gains.kD);
+      double intOutput = sameInt[joint].compute(setpoint, angle, t);
+      sameIntDuties[joint] = legDuty(joint, sameInt[joint].pid.getOutput(), sameIntDuties[joint]);
+      ints.compare(countOutput, intOutput, countDuties[joint], sameIntDuties[joint]);
+
+      FloatJoint &c = closed[joint];
+      c.setpoint = setpoints[joint];
+      c.input = positionFloat(rawReading(floatPlants[joint].getPosition(), neutral, left), neutral,
+                              left);
+      c.pid.setTunings(kP, gains.kI, gains.kD);
+      c.pid.compute(t);
+      closedDuties[joint] = legDuty(joint, fixedOutput(c.output), closedDuties[joint]);
+
+      Angle closedAngle =
+          positionAngle(rawReading(intPlants[joint].getPosition(), neutral, left), neutral, left);
+      closedInt[joint].pid.setTunings(kP, gains.kI, gains.kD);
+      closedInt[joint].compute(setpoint, closedAngle, t);
+      closedIntDuties[joint] =
+          legDuty(joint, closedInt[joint].pid.getOutput(), closedIntDuties[joint]);
+
+      for (uint8_t i = 0; i < SUBSTEPS; i++)
+      {
+        doublePlants[joint].step(doubleDuties[joint], 0.001 / SUBSTEPS);
+        floatPlants[joint].step(closedDuties[joint], 0.001 / SUBSTEPS);
+        intPlants[joint].step(closedIntDuties[joint], 0.001 / SUBSTEPS);
+      }
+
+      double position = doublePlants[joint].getPosition();
+      floats.trackingError =
+          fmax(floats.trackingError, fabs(position - floatPlants[joint].getPosition()));
+      ints.trackingError =
+          fmax(ints.trackingError, fabs(position - intPlants[joint].getPosition()));
+    }
+  }
+}
+
+static int checkPositions()
+{
+  // the left joint at the top reads 360 in double and float, 0 as an Angle
+  double worst = 0, worstAngle = 0;
+  for (uint16_t raw = 0; raw < 4096; raw++)
+  {
+    for (bool left : {false, true})
+    {
+      uint16_t neutral = left ? Robot::LeftLeg::NEUTRAL : Robot::RightLeg::NEUTRAL;
+      double expected = positionDouble(raw, neutral, left);
+      worst = fmax(worst, fabs(expected - positionFloat(raw, neutral, left)));
+      double angle = positionAngle(raw, neutral, left).toDegrees();
+      worstAngle = fmax(worstAngle, fabs(remainder(expected - angle, 360)));
+    }
+  }
+  printf("positions: 8192 readings, max error %g degrees in float, %g as an Angle\n", worst,
+         worstAngle);
+  return worst > 0 || worstAngle > 0;
+}
+
+static int checkAngles()
+{
+  uint32_t wrong = 0;
+  for (int32_t a = 0; a < Angle::COUNTS; a++)
+  {
+    Angle angleA = Angle::fromCounts(a);
+    for (int32_t b = 0; b < Angle::COUNTS; b++)
+    {
+      Angle angleB = Angle::fromCounts(b);
+      int32_t shortest = ((a - b) % 4096 + 4096 + 2048) % 4096 - 2048;
+      wrong += angleA - angleB != shortest;
+      wrong += (angleA + b).getCounts() != (a + b) % 4096;
+      wrong += (angleA - b).getCounts() != (a - b + 4096) % 4096;
+      wrong += (angleA < angleB) != (shortest < 0) || (angleA > angleB) != (shortest > 0);
+      wrong += (angleA == angleB) != (a == b) || (angleA != angleB) != (a != b);
+    }
+
+    double degrees = a * 360. / 4096;
+    wrong += Angle::fromDegrees(degrees).getCounts() != a;
+    wrong += Angle::fromDegrees(degrees - 360).getCounts() != a;
+    wrong += Angle::fromDegrees(degrees + 0.4 * 360 / 4096).getCounts() != a;
+    wrong += Angle::fromDegrees(degrees - 0.4 * 360 / 4096).getCounts() != a;
+    wrong += angleA.toDegrees() != (float)degrees;
+    wrong += angleA.toTenths() != lround(degrees * 10);
+  }
+  for (uint16_t degrees = 0; degrees <= 360; degrees++)
+  {
+    wrong += Angle::fromWholeDegrees(degrees).getCounts() != lround(degrees * 4096. / 360) % 4096;
+  }
+  printf("angles: %u counts, every pair and conversion, %u wrong\n", Angle::COUNTS, wrong);
+  return wrong > 0;
+}
+
+// the arithmetic of one control tick, both joints, as NumericBench does it
+static void bench()
+{
+  using namespace std::chrono;
+  DoublePid doublePids[2];
+  FloatJoint floatJoints[2] = {FloatJoint(180), FloatJoint(180)};
+  IntJoint intJoints[2] = {IntJoint(Angle::fromWholeDegrees(180)),
+                           IntJoint(Angle::fromWholeDegrees(180))};
+  const uint16_t neutrals[2] = {Robot::RightLeg::NEUTRAL, Robot::LeftLeg::NEUTRAL};
+  volatile long sink = 0;
+
+  auto start = steady_clock::now();
+  for (uint32_t tick = 0; tick < BENCH_TICKS; tick++)
+  {
+    uint16_t raw = (tick * 37) % 4096;
+    for (int joint = 0; joint < 2; joint++)
+    {
+      doublePids[joint].setTunings(1.4, 0.2, 0.01);
+      double output = doublePids[joint].compute(180, positionDouble(raw, neutrals[joint], joint));
+      sink = legDuty(joint, fixedOutput(output), 0);
+    }
+  }
+  double doubleNs = duration<double, std::nano>(steady_clock::now() - start).count() / BENCH_TICKS;
+
+  start = steady_clock::now();
+  for (uint32_t tick = 0; tick < BENCH_TICKS; tick++)
+  {
+    uint16_t raw = (tick * 37) % 4096;
+    for (int joint = 0; joint < 2; joint++)
+    {
+      FloatJoint &j = floatJoints[joint];
+      j.setpoint = 180;
+      j.input = positionFloat(raw, neutrals[joint], joint);
+      j.pid.setTunings(1.4f, 0.2f, 0.01f);
+      j.pid.compute(tick);
+      sink = legDuty(joint, fixedOutput(j.output), 0);
+    }
+  }
+  double floatNs = duration<double, std::nano>(steady_clock::now() - start).count() / BENCH_TICKS;
+
+  start = steady_clock::now();
+  for (uint32_t tick = 0; tick < BENCH_TICKS; tick++)
+  {
+    uint16_t raw = (tick * 37) % 4096;
+    for (int joint = 0; joint < 2; joint++)
+    {
+      IntPid &pid = intJoints[joint].pid;
+      pid.setTunings(1.4f, 0.2f, 0.01f);
+      pid.compute(Angle::fromWholeDegrees(180), positionAngle(raw, neutrals[joint], joint), tick);
+      sink = legDuty(joint, pid.getOutput(), 0);
+    }
+  }
+  double intNs = duration<double, std::nano>(steady_clock::now() - start).count() / BENCH_TICKS;
+  (void)sink;
+
+  printf("bench, ns per control tick on this machine: double %.1f, float %.1f, integer %.1f\n",
+         doubleNs, floatNs, intNs);
+}
+
+int main(int argc, char **argv)
+{
+  // the built-in sequences, or a compiled show
+  TimelineLibrary library(sequences, MOVE_COUNT);
+  std::vector<uint32_t> image; // words, the image must be aligned
+  if (argc > 1)
+  {
+    FILE *in = fopen(argv[1], "rb");
+    if (!in)
+    {
+      perror(argv[1]);
+      return 1;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    image.resize((size + 3) / 4);
+    bool read = fread(image.data(), 1, size, in) == (size_t)size;
+    fclose(in);
+    if (!read || !library.load((const uint8_t *)image.data(), size))
+    {
+      fprintf(stderr, "%s: not a timeline image\n", argv[1]);
+      return 1;
+    }
+  }
+
+  int failed = checkPositions();
+  failed |= checkAngles();
+
+  for (const Gains &gains : GAINS)
+  {
+    Result floats, ints;
+    for (int16_t i = 0; i < library.getSize(); i++)
+    {
+      check(library, i, gains, floats, ints);
+    }
+    failed |= floats.print(gains.name, "float");
+    failed |= ints.print(gains.name, "integer");
+  }
+
+  bench();
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,320 @@
+/*
+Title: Acrobot remote node
+Description: The remote's side of the radio link, as a Linux process over
+UdpTransport: 2 ms control frames stepping the legs like the walk move, and
+decoding of the leg's telemetry. The built-in timelines go to the leg with
+the firmware's own TimelineUpload, every other frame as on the remote, then
+a few of them are started and stopped with the remote's playback commands
+and heartbeats. The image alternates between two libraries so every cycle
+uploads again, and the time each upload took is reported. The rest of the
+remote (buttons, lcd, cues) is not simulated. Start legNode next to it.
+
+Usage: remoteNode [--loss %] [--latency us] [--jitter us] [--reorder %] [--seconds s]
+*/
+
+#include "../common/node.h"
+
+#include <musicClock.h>
+#include <protocol.h>
+#include <sequences.h>
+#include <telemetryFrame.h>
+#include <timelineLibrary.h>
+#include <timelineUpload.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+const uint32_t PLAYBACK_LEAD = 30;       // ms, as on the remote
+const uint32_t PLAYBACK_HEARTBEAT = 100; // ms
+const uint32_t PLAY_MILLIS = 1000;       // of every move started
+const uint8_t STARTS_PER_UPLOAD = 4;
+
+NodeOptions options;
+UdpTransport *transport;
+
+struct_leg_data dataIn;
+struct_remote_data dataOut;
+
+uint32_t dataTimer = 0;
+uint32_t moveTimer = 0;
+bool lastPackageSuccess = false;
+bool legSeen = false;
+
+uint64_t telemetrySamples = 0;
+uint64_t telemetryFramesLost = 0;
+bool hasSequence = false;
+uint16_t lastSequence = 0;
+
+// the built-in timelines and a copy with one renamed, so the image changes
+// from one cycle to the next
+struct_timeline renamed[MOVE_COUNT];
+TimelineLibrary libraries[2] = {TimelineLibrary(sequences, MOVE_COUNT),
+                                TimelineLibrary(renamed, MOVE_COUNT)};
+TimelineUpload uploads[2] = {TimelineUpload(libraries[0]), TimelineUpload(libraries[1])};
+uint8_t current = 0;
+bool uploadSlot = false;
+
+enum Phase
+{
+  UPLOADING,
+  PLAYING,
+  STOPPING,
+};
+Phase phase = UPLOADING;
+uint32_t uploadStarted = 0;
+std::vector<uint32_t> uploadMillis;
+uint8_t startsThisUpload = 0;
+uint32_t starts = 0;
+int16_t nextTimeline = 0;
+
+MusicClock musicClock;
+bool legPlayback = false;
+struct_playback playbackOut;
+uint32_t playbackTimer = 0;
+uint16_t playbackClockVersion = 0;
+
+void OnDataSent(const uint8_t *mac, bool delivered)
+{
+  lastPackageSuccess = delivered;
+}
+
+void OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int len)
+{
+  if (len < (int)sizeof(dataIn))
+  {
+    return;
+  }
+  memcpy(&dataIn, incomingData, sizeof(dataIn));
+  legSeen = true;
+
+  TelemetryDecoder decoder;
+  if (!decoder.begin(incomingData + sizeof(dataIn), len - sizeof(dataIn)))
+  {
+    return;
+  }
+  if (hasSequence)
+  {
+    int16_t gap = decoder.getSequence() - lastSequence;
+    if (gap > 1)
+    {
+      telemetryFramesLost += gap - 1;
+    }
+  }
+  if (!hasSequence || (int16_t)(decoder.getSequence() - lastSequence) > 0)
+  {
+    lastSequence = decoder.getSequence();
+  }
+  hasSequence = true;
+
+  struct_telemetry_sample s;
+  while (decoder.next(s))
+  {
+    telemetrySamples++;
+  }
+}
+
+void updateMoves()
+{
+  // walk: step right, step left, every 800 ms
+  uint32_t t = (millis() - moveTimer) % 1600;
+  int8_t step = t < 800 ? 20 : -20;
+  dataOut.rTargetPositionDegrees = 180 - step;
+  dataOut.lTargetPositionDegrees = 180 + step;
+  dataOut.rP = 1.4;
+}
+
+void preparePlayback(uint8_t command, int16_t timeline, uint32_t startAt)
+{
+  playbackOut.command = command;
+  playbackOut.sequence++;
+  playbackOut.timeline = timeline;
+  playbackOut.startAt = startAt;
+  playbackOut.position = 0;
+  playbackTimer = millis(); // due now
+}
+
+void startMove()
+{
+  // the next timeline with keyframes
+  struct_timeline timeline;
+  do
+  {
+    nextTimeline = (nextTimeline + 1) % MOVE_COUNT;
+  } while (!libraries[current].get(nextTimeline, timeline) || !timeline.count);
+
+  uint32_t startAt = millis() + PLAYBACK_LEAD;
+  musicClock.setTempoMap(0);
+  musicClock.begin(startAt);
+  legPlayback = true;
+  preparePlayback(PLAYBACK_START, nextTimeline, startAt);
+  starts++;
+  startsThisUpload++;
+  phase = PLAYING;
+}
+
+// uploads, then a few moves played on the leg, then the other image
+void updateShow()
+{
+  uint32_t now = millis();
+  if (!legSeen)
+  {
+    uploadStarted = now; // not timing how long legNode takes to come up
+    return;
+  }
+  switch (phase)
+  {
+  case UPLOADING:
+    if (uploads[current].isDone(dataIn))
+    {
+      uploadMillis.push_back(now - uploadStarted);
+      startsThisUpload = 0;
+      startMove();
+    }
+    break;
+  case PLAYING:
+    if ((int32_t)(now - playbackOut.startAt) >= (int32_t)PLAY_MILLIS)
+    {
+      legPlayback = false; // sendPlayback() stops the leg
+      phase = STOPPING;
+    }
+    break;
+  case STOPPING:
+    if (dataIn.playingTimeline >= 0)
+    {
+      break;
+    }
+    if (startsThisUpload < STARTS_PER_UPLOAD)
+    {
+      startMove();
+      break;
+    }
+    current ^= 1;
+    uploadStarted = now;
+    phase = UPLOADING;
+    break;
+  }
+}
+
+// as the remote's: true while the leg plays, or has to be told to stop
+bool sendPlayback()
+{
+  if (!legPlayback)
+  {
+    if (dataIn.playingTimeline < 0)
+    {
+      return false;
+    }
+    if (playbackOut.command != PLAYBACK_STOP)
+    {
+      preparePlayback(PLAYBACK_STOP, -1, millis());
+    }
+  }
+
+  if (musicClock.getVersion() != playbackClockVersion)
+  {
+    playbackClockVersion = musicClock.getVersion();
+    playbackOut.clockAt = musicClock.getAnchor();
+    playbackOut.clockShow = musicClock.getAnchorShow();
+    playbackOut.rate = musicClock.getRate();
+    playbackTimer = millis();
+  }
+
+  uint32_t now = millis();
+  if ((int32_t)(now - playbackTimer) >= 0)
+  {
+    playbackOut.header = {MSG_PLAYBACK, now};
+    transport->send(LEG_MAC, (uint8_t *)&playbackOut, sizeof(playbackOut));
+    bool started = legPlayback && (int32_t)(now - playbackOut.startAt) >= 0;
+    playbackTimer = now + (started ? PLAYBACK_HEARTBEAT : 10);
+  }
+  return true;
+}
+
+void sendData()
+{
+  if (millis() - dataTimer < 2)
+  {
+    return;
+  }
+  dataTimer = millis();
+  if (sendPlayback())
+  {
+    return;
+  }
+
+  // every other packet goes to the upload until the leg has the library
+  uploadSlot = !uploadSlot;
+  if (uploadSlot && !uploads[current].isDone(dataIn))
+  {
+    uint8_t message[TRANSPORT_MAX_DATA_LEN];
+    size_t len = uploads[current].prepare(dataIn, millis(), message);
+    transport->send(LEG_MAC, message, len);
+    return;
+  }
+
+  dataOut.header = {MSG_CONTROL, millis()};
+  transport->send(LEG_MAC, (uint8_t *)&dataOut, sizeof(dataOut));
+}
+
+int main(int argc, char **argv)
+{
+  if (!parseNodeOptions(argc, argv, options))
+  {
+    return 1;
+  }
+
+  memcpy(renamed, sequences, sizeof(renamed));
+  renamed[0].name = "renamed";
+  for (TimelineUpload &upload : uploads)
+  {
+    upload.init();
+    if (!upload.getSize())
+    {
+      fprintf(stderr, "remoteNode: the built-in timelines do not fit an upload\n");
+      return 1;
+    }
+  }
+
+  setBoot(REMOTE_BOOT);
+  transport = new UdpTransport(REMOTE_MAC, options.impairments);
+  if (!transport->begin())
+  {
+    perror("remoteNode: bind");
+    return 1;
+  }
+  transport->onSent(OnDataSent);
+  transport->onReceive(OnDataRecv);
+  transport->addPeer(LEG_MAC);
+
+  uint32_t end = millis() + options.seconds * 1000;
+  while ((int32_t)(end - millis()) > 0)
+  {
+    transport->poll();
+    updateMoves();
+    updateShow();
+    sendData();
+    idle();
+  }
+
+  printStats("remote", transport->getStats(), options.seconds);
+  printf("remote: %llu telemetry samples (%.0f/s), %llu telemetry frames lost\n",
+         (unsigned long long)telemetrySamples, telemetrySamples / (double)options.seconds,
+         (unsigned long long)telemetryFramesLost);
+  if (!uploadMillis.empty())
+  {
+    uint32_t min = UINT32_MAX, max = 0;
+    double sum = 0;
+    for (uint32_t ms : uploadMillis)
+    {
+      min = ms < min ? ms : min;
+      max = ms > max ? ms : max;
+      sum += ms;
+    }
+    printf("remote: %zu uploads of %zu / %zu bytes, upload time min %u ms, mean %.0f ms, "
+           "max %u ms, %u starts sent\n",
+           uploadMillis.size(), uploads[0].getSize(), uploads[1].getSize(), min,
+           sum / uploadMillis.size(), max, starts);
+  }
+  return 0;
+}
@@ -0,0 +1,206 @@
+/*
+Title: Acrobot show compiler
+Description: Compiles a text choreography (see showParser.h) into the binary
+timeline library image the remote and leg play, and checks it. The image is
+decoded again with the firmware's own TimelineLibrary and played with its
+TimelinePlayer at 1 ms steps, so the checks see exactly what the robot will
+do: targets within the joint limits, kP within the gain range, and a motor
+of the given top speed able to keep up within the tolerance before the next
+keyframe takes over. Exits with 1 on any error.
+
+Usage: showCompile <show> [-o image]
+*/
+
+#include "showParser.h"
+
+#include <protocol.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+int errors = 0;
+
+void report(const char *fileName, int line, const char *name, uint32_t time, const char *message)
+{
+  fprintf(stderr, "%s:%d: error: %s at %u ms: %s\n", fileName, line, name, time, message);
+  errors++;
+}
+
+// plays one timeline on its own, the way the robot would, and checks it
+void checkTimeline(const char *fileName, const ShowSettings &settings, TimelineLibrary &robot,
+                   int16_t index, const ShowTimeline &source)
+{
+  struct_timeline timeline;
+  robot.get(index, timeline);
+  if (!timeline.count)
+  {
+    return;
+  }
+
+  TimelinePlayer player(robot);
+  player.start(index, 0);
+
+  // where a motor with the top speed would be, starting in the first pose
+  float position[2] = {(float)timeline.keyframes[0].rTarget, (float)timeline.keyframes[0].lTarget};
+  float step = settings.maxSpeed / 1000;
+  const char *legs[] = {"right", "left"};
+  char message[160];
+
+  uint32_t end =
+      timeline.duration ? timeline.duration : timeline.keyframes[timeline.count - 1].time + 1;
+  uint16_t segment = 0;
+  struct_timeline_state state;
+  for (uint32_t t = 0; t < end; t++)
+  {
+    if (!player.update(t, state))
+    {
+      continue;
+    }
+    while (segment + 1 < timeline.count && timeline.keyframes[segment + 1].time <= t)
+    {
+      segment++;
+    }
+    // the lag that is left when the next keyframe takes over
+    bool boundary = segment + 1 < timeline.count && timeline.keyframes[segment + 1].time == t + 1;
+    // blame the keyframe being approached, or the one jumped to
+    bool approaching = segment + 1 < timeline.count &&
+                       timeline.keyframes[segment + 1].interpolation != INTERP_STEP;
+    int line = source.lines[approaching ? segment + 1 : segment];
+
+    float targets[2] = {state.rTarget, state.lTarget};
+    for (int leg = 0; leg < 2; leg++)
+    {
+      if (targets[leg] < settings.forwardLimit - 0.05f ||
+          targets[leg] > settings.backwardLimit + 0.05f)
+      {
+        snprintf(message, sizeof(message), "%s target %.1f is outside the limits %.0f..%.0f",
+                 legs[leg], targets[leg], settings.forwardLimit, settings.backwardLimit);
+        report(fileName, line, timeline.name, t, message);
+        return;
+      }
+
+      float delta = targets[leg] - position[leg];
+      position[leg] += fmaxf(-step, fminf(step, delta));
+      float lag = fabsf(targets[leg] - position[leg]);
+      if (boundary && lag > settings.tolerance)
+      {
+        snprintf(message, sizeof(message), "%s leg is still %.0f degrees behind at %.0f degrees/s",
+                 legs[leg], lag, settings.maxSpeed);
+        report(fileName, line, timeline.name, t, message);
+        return;
+      }
+    }
+
+    if (state.kP < settings.minGain - 0.005f || state.kP > settings.maxGain + 0.005f)
+    {
+      snprintf(message, sizeof(message), "kP %.2f is outside %.2f..%.2f", state.kP,
+               settings.minGain, settings.maxGain);
+      report(fileName, line, timeline.name, t, message);
+      return;
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const char *input = nullptr;
+  const char *output = nullptr;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+    {
+      output = argv[++i];
+    }
+    else
+    {
+      input = argv[i];
+    }
+  }
+  if (!input)
+  {
+    fprintf(stderr, "usage: showCompile <show> [-o image]\n");
+    return 2;
+  }
+
+  FILE *in = fopen(input, "r");
+  if (!in)
+  {
+    perror(input);
+    return 1;
+  }
+  Show show;
+  ShowParser parser(input);
+  bool parsed = parser.parse(in, show);
+  fclose(in);
+  if (!parsed)
+  {
+    return 1;
+  }
+
+  // the same structures the firmware builds its sequences from
+  std::vector<struct_timeline> timelines;
+  size_t keyframes = 0;
+  for (const ShowTimeline &source : show.timelines)
+  {
+    int16_t next = -1;
+    for (size_t i = 0; i < show.timelines.size(); i++)
+    {
+      if (!source.next.empty() && show.timelines[i].name == source.next)
+      {
+        next = i;
+      }
+    }
+    timelines.push_back({source.name.c_str(), source.keyframes.data(),
+                         (uint16_t)source.keyframes.size(), source.duration, next});
+    keyframes += source.keyframes.size();
+  }
+
+  TimelineLibrary library(timelines.data(), timelines.size());
+  std::vector<uint8_t> image(sizeof(struct_timeline_image_header) +
+                             timelines.size() * sizeof(struct_timeline_image_entry) +
+                             keyframes * sizeof(struct_keyframe));
+  size_t size = library.encode(image.data(), image.size());
+
+  // check what the robot decodes, not what was parsed
+  TimelineLibrary robot;
+  if (!size || !robot.load(image.data(), size))
+  {
+    fprintf(stderr, "%s: encoded image does not load\n", input);
+    return 1;
+  }
+  for (int16_t i = 0; i < robot.getSize(); i++)
+  {
+    checkTimeline(input, show.settings, robot, i, show.timelines[i]);
+  }
+  if (errors)
+  {
+    fprintf(stderr, "%d errors\n", errors);
+    return 1;
+  }
+
+  struct_timeline_image_header header;
+  readTimelineImageHeader(image.data(), size, header);
+  printf("%u timelines, %zu keyframes, %zu bytes, crc %08x\n", robot.getSize(), keyframes, size,
+         header.crc);
+  if (size > UPLOAD_MAX_SIZE)
+  {
+    printf("warning: larger than the leg's %u bytes, it plays from the remote only\n",
+           UPLOAD_MAX_SIZE);
+  }
+
+  if (output)
+  {
+    FILE *out = fopen(output, "wb");
+    if (!out || fwrite(image.data(), 1, size, out) != size)
+    {
+      perror(output);
+      return 1;
+    }
+    fclose(out);
+  }
+  return 0;
+}
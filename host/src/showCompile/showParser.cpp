@@ -0,0 +1,399 @@
+#include "showParser.h"
+
+#include <sequences.h>
+#include <timelineLibrary.h>
+
+#include <math.h>
+#include <sstream>
+#include <stdarg.h>
+#include <stdlib.h>
+
+const char *INTERPOLATION_NAMES[] = {"step", "linear", "hermite", "ease"};
+
+int interpolationFromName(const std::string &name)
+{
+  for (int i = INTERP_STEP; i <= INTERP_EASE; i++)
+  {
+    if (name == INTERPOLATION_NAMES[i])
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+ShowParser::ShowParser(const char *fileName)
+    : fileName(fileName), line(0), errors(0), bpm(0), defaultInterpolation(INTERP_STEP)
+{
+}
+
+void ShowParser::error(const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  fprintf(stderr, "%s:%d: error: ", fileName, line);
+  vfprintf(stderr, format, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+  errors++;
+}
+
+bool ShowParser::parseNumber(const std::string &token, float &value)
+{
+  char *end;
+  value = strtof(token.c_str(), &end);
+  return !token.empty() && *end == 0 && isfinite(value);
+}
+
+bool ShowParser::parseTime(const std::string &token, uint32_t previous, uint32_t &time)
+{
+  std::string t = token;
+  bool relative = !t.empty() && t[0] == '+';
+  if (relative)
+  {
+    t = t.substr(1);
+  }
+
+  float scale = 1;
+  if (!t.empty() && t.back() == 'b')
+  {
+    if (!bpm)
+    {
+      error("%s is in beats, but no tempo is set", token.c_str());
+      return false;
+    }
+    scale = 60000 / bpm;
+    t.pop_back();
+  }
+  else if (t.size() > 2 && t.compare(t.size() - 2, 2, "ms") == 0)
+  {
+    t.resize(t.size() - 2);
+  }
+  else if (!t.empty() && t.back() == 's')
+  {
+    scale = 1000;
+    t.pop_back();
+  }
+
+  float value;
+  if (!parseNumber(t, value) || value < 0)
+  {
+    error("bad time '%s'", token.c_str());
+    return false;
+  }
+  time = lroundf(value * scale) + (relative ? previous : 0);
+  return true;
+}
+
+bool ShowParser::parseKeyframe(std::vector<std::string> &tokens, ShowTimeline &timeline)
+{
+  bool first = timeline.keyframes.empty();
+  uint32_t previous = first ? 0 : timeline.keyframes.back().time;
+
+  struct_keyframe keyframe = {};
+  if (tokens.size() < 2 || !parseTime(tokens[1], previous, keyframe.time))
+  {
+    if (tokens.size() < 2)
+    {
+      error("at needs a time");
+    }
+    return false;
+  }
+  if (!first && keyframe.time <= previous)
+  {
+    error("keyframe at %u ms is not after the one before (%u ms)", keyframe.time, previous);
+    return false;
+  }
+
+  // everything not given is kept from the keyframe before
+  float r = first ? NAN : timeline.keyframes.back().rTarget;
+  float l = first ? NAN : timeline.keyframes.back().lTarget;
+  float kP = first ? NAN : timeline.keyframes.back().kP / 100.f;
+  int interpolation = defaultInterpolation;
+
+  for (size_t i = 2; i < tokens.size(); i++)
+  {
+    const std::string &word = tokens[i];
+    bool hasArgument = i + 1 < tokens.size();
+    float a = 0, b = 0;
+
+    if (word == "stand")
+    {
+      r = l = 180;
+      continue;
+    }
+
+    if (interpolationFromName(word) >= 0)
+    {
+      interpolation = interpolationFromName(word);
+      continue;
+    }
+
+    if (poses.count(word))
+    {
+      r = poses[word].first;
+      l = poses[word].second;
+      continue;
+    }
+
+    if (word == "pose")
+    {
+      if (i + 2 >= tokens.size() || !parseNumber(tokens[i + 1], a) ||
+          !parseNumber(tokens[i + 2], b))
+      {
+        error("pose needs right and left degrees");
+        return false;
+      }
+      r = a;
+      l = b;
+      i += 2;
+      continue;
+    }
+
+    if (!hasArgument || !parseNumber(tokens[i + 1], a))
+    {
+      error("unknown or incomplete '%s'", word.c_str());
+      return false;
+    }
+    i++;
+
+    // the same poses as the remote's pBow(), pStepRight()... helpers
+    if (word == "bow")
+    {
+      r = l = 180 - a;
+    }
+    else if (word == "stepRight")
+    {
+      r = 180 - a;
+      l = 180 + a;
+    }
+    else if (word == "stepLeft")
+    {
+      r = 180 + a;
+      l = 180 - a;
+    }
+    else if (word == "kickRight")
+    {
+      r = 180 - a;
+      l = 180;
+    }
+    else if (word == "kickLeft")
+    {
+      r = 180;
+      l = 180 - a;
+    }
+    else if (word == "r")
+    {
+      r = a;
+    }
+    else if (word == "l")
+    {
+      l = a;
+    }
+    else if (word == "kp")
+    {
+      kP = a;
+    }
+    else
+    {
+      error("unknown '%s'", word.c_str());
+      return false;
+    }
+  }
+
+  if (isnan(r) || isnan(l) || isnan(kP))
+  {
+    error("the first keyframe needs a pose and a kp");
+    return false;
+  }
+  if (r < 0 || r > UINT16_MAX || l < 0 || l > UINT16_MAX || kP < 0 || kP * 100 > UINT16_MAX)
+  {
+    error("value out of range");
+    return false;
+  }
+
+  keyframe.rTarget = lroundf(r);
+  keyframe.lTarget = lroundf(l);
+  keyframe.kP = lroundf(kP * 100);
+  keyframe.interpolation = interpolation;
+  timeline.keyframes.push_back(keyframe);
+  timeline.lines.push_back(line);
+  return true;
+}
+
+bool ShowParser::parse(FILE *in, Show &show)
+{
+  show.settings.forwardLimit = forwardLimit;
+  show.settings.backwardLimit = backwardLimit;
+  ShowSettings &settings = show.settings;
+
+  ShowTimeline *timeline = nullptr;
+  char buffer[512];
+  while (fgets(buffer, sizeof(buffer), in))
+  {
+    line++;
+    std::string text = buffer;
+    text = text.substr(0, text.find('#'));
+
+    std::vector<std::string> tokens;
+    std::istringstream words(text);
+    std::string word;
+    while (words >> word)
+    {
+      tokens.push_back(word);
+    }
+    if (tokens.empty())
+    {
+      continue;
+    }
+
+    const std::string &command = tokens[0];
+    std::vector<float> numbers;
+    for (size_t i = 1; i < tokens.size(); i++)
+    {
+      float value;
+      numbers.push_back(parseNumber(tokens[i], value) ? value : NAN);
+    }
+    bool numeric = true;
+    for (float n : numbers)
+    {
+      numeric = numeric && !isnan(n);
+    }
+
+    if (command == "at")
+    {
+      if (!timeline)
+      {
+        error("keyframe outside a timeline");
+        continue;
+      }
+      parseKeyframe(tokens, *timeline);
+    }
+    else if (command == "timeline")
+    {
+      if (timeline)
+      {
+        error("timeline %s is not closed with end", timeline->name.c_str());
+      }
+      if (tokens.size() < 2)
+      {
+        error("timeline needs a name");
+        timeline = nullptr;
+        continue;
+      }
+      show.timelines.emplace_back();
+      timeline = &show.timelines.back();
+      timeline->name = tokens[1];
+      timeline->line = line;
+
+      for (size_t i = 2; i + 1 < tokens.size(); i += 2)
+      {
+        if (tokens[i] == "next")
+        {
+          timeline->next = tokens[i + 1];
+        }
+        else if (tokens[i] == "duration" || tokens[i] == "loop")
+        {
+          parseTime(tokens[i + 1], 0, timeline->duration);
+          if (tokens[i] == "loop")
+          {
+            timeline->next = timeline->name;
+          }
+        }
+        else
+        {
+          error("unknown timeline option '%s'", tokens[i].c_str());
+        }
+      }
+      if (tokens.size() % 2)
+      {
+        error("timeline option '%s' needs a value", tokens.back().c_str());
+      }
+    }
+    else if (command == "end")
+    {
+      if (!timeline)
+      {
+        error("end without timeline");
+      }
+      timeline = nullptr;
+    }
+    else if (command == "tempo" && numbers.size() == 1 && numeric && numbers[0] > 0)
+    {
+      bpm = numbers[0];
+    }
+    else if (command == "limits" && numbers.size() == 2 && numeric && numbers[0] < numbers[1])
+    {
+      settings.forwardLimit = numbers[0];
+      settings.backwardLimit = numbers[1];
+    }
+    else if (command == "gains" && numbers.size() == 2 && numeric && numbers[0] <= numbers[1])
+    {
+      settings.minGain = numbers[0];
+      settings.maxGain = numbers[1];
+    }
+    else if (command == "motor" && numbers.size() == 2 && numeric && numbers[0] > 0)
+    {
+      settings.maxSpeed = numbers[0];
+      settings.tolerance = numbers[1];
+    }
+    else if (command == "default" && tokens.size() == 2 && interpolationFromName(tokens[1]) >= 0)
+    {
+      defaultInterpolation = interpolationFromName(tokens[1]);
+    }
+    else if (command == "pose" && tokens.size() == 4 && !isnan(numbers[1]) && !isnan(numbers[2]))
+    {
+      poses[tokens[1]] = std::make_pair(numbers[1], numbers[2]);
+    }
+    else
+    {
+      error("can not make sense of '%s'", command.c_str());
+    }
+  }
+
+  if (timeline)
+  {
+    error("timeline %s is not closed with end", timeline->name.c_str());
+  }
+  resolve(show);
+  return errors == 0;
+}
+
+void ShowParser::resolve(Show &show)
+{
+  std::map<std::string, int> names;
+  for (ShowTimeline &timeline : show.timelines)
+  {
+    line = timeline.line;
+    if (timeline.name.size() >= TIMELINE_NAME_LEN)
+    {
+      error("name %s is longer than %u characters", timeline.name.c_str(), TIMELINE_NAME_LEN - 1);
+    }
+    if (names.count(timeline.name))
+    {
+      error("timeline %s is defined twice", timeline.name.c_str());
+    }
+    names[timeline.name] = 1;
+
+    if (!timeline.keyframes.empty() && timeline.duration &&
+        timeline.keyframes.back().time >= timeline.duration)
+    {
+      error("%s has keyframes at or after its duration of %u ms, they never play",
+            timeline.name.c_str(), timeline.duration);
+    }
+    if (!timeline.next.empty() && !timeline.duration)
+    {
+      error("%s continues with %s, but has no duration", timeline.name.c_str(),
+            timeline.next.c_str());
+    }
+  }
+
+  for (ShowTimeline &timeline : show.timelines)
+  {
+    line = timeline.line;
+    if (!timeline.next.empty() && !names.count(timeline.next))
+    {
+      error("%s continues with unknown timeline %s", timeline.name.c_str(), timeline.next.c_str());
+    }
+  }
+}
@@ -0,0 +1,84 @@
+#ifndef SHOW_PARSER_H
+#define SHOW_PARSER_H
+
+#include <timeline.h>
+
+#include <map>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Text choreography, one statement per line, # starts a comment:
+//
+//   tempo 96                   beats per minute, for times like 12b
+//   limits 90 270              joint range, degrees
+//   gains 0 5                  kP range
+//   motor 600 10               top speed in degrees/s, tolerated lag in degrees
+//   default linear             interpolation when a keyframe names none
+//   pose split 150 210         named pose, right and left degrees
+//
+//   timeline walk loop 1600    also: duration <time>, next <timeline>
+//     at 0    stepRight 20 kp 1.4 step
+//     at 800  stepLeft 20
+//     at +2b  split ease       + is relative to the previous keyframe
+//   end
+//
+// Times are ms, or with s or b for seconds and beats. A keyframe sets a
+// pose (stand, bow N, stepRight N, stepLeft N, kickRight N, kickLeft N,
+// pose R L, a named pose, r N and/or l N for one leg), kp and an
+// interpolation (step, linear, hermite, ease); whatever it leaves out is
+// kept from the keyframe before.
+
+struct ShowSettings
+{
+  float forwardLimit;
+  float backwardLimit;
+  float minGain = 0;
+  float maxGain = 5;
+  float maxSpeed = 600; // degrees per second
+  float tolerance = 10; // degrees
+};
+
+struct ShowTimeline
+{
+  std::string name;
+  int line;
+  std::vector<struct_keyframe> keyframes;
+  std::vector<int> lines; // per keyframe
+  uint32_t duration = 0;
+  std::string next;
+};
+
+struct Show
+{
+  ShowSettings settings;
+  std::vector<ShowTimeline> timelines;
+};
+
+class ShowParser
+{
+public:
+  ShowParser(const char *fileName);
+
+  // returns false, after printing every error, if the show does not compile
+  bool parse(FILE *in, Show &show);
+
+private:
+  const char *fileName;
+  int line;
+  int errors;
+
+  float bpm;
+  uint8_t defaultInterpolation;
+  std::map<std::string, std::pair<float, float>> poses;
+
+  void error(const char *format, ...);
+  bool parseTime(const std::string &token, uint32_t previous, uint32_t &time);
+  bool parseNumber(const std::string &token, float &value);
+  bool parseKeyframe(std::vector<std::string> &tokens, ShowTimeline &timeline);
+  void resolve(Show &show);
+};
+
+int interpolationFromName(const std::string &name);
+
+#endif
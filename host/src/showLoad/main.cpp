@@ -0,0 +1,169 @@
+/*
+Title: Acrobot show loader
+Description: Writes a timeline library image into the remote's show partition
+over USB serial, so a show can be changed without rebuilding the firmware.
+The image is checked before it is sent and again by the remote. --export
+writes the sequences built into the firmware as an image, as a starting point.
+
+Usage: showLoad <device> <image> [baud]
+       showLoad --export <image>
+*/
+
+#include "../common/serialPort.h"
+
+#include <binaryLog.h>
+#include <sequences.h>
+#include <showLoad.h>
+#include <timelineLibrary.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+// waits for the next show load record from the remote, skipping every other
+// log record and text; false on timeout
+bool waitForStatus(int fd, int timeoutMillis, struct_log_record &record)
+{
+  static uint8_t frame[256];
+  static size_t frameLen = 0;
+
+  pollfd p = {fd, POLLIN, 0};
+  while (poll(&p, 1, timeoutMillis) > 0)
+  {
+    uint8_t b;
+    if (read(fd, &b, 1) != 1)
+    {
+      return false;
+    }
+    if (b != 0)
+    {
+      if (frameLen < sizeof(frame))
+      {
+        frame[frameLen++] = b;
+      }
+      continue;
+    }
+
+    bool ok = frameLen && decodeLogFrame(frame, frameLen, record);
+    frameLen = 0;
+    if (ok && record.id == LOG_REMOTE_SHOW_LOAD)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool writeAll(int fd, const uint8_t *data, size_t len)
+{
+  while (len)
+  {
+    ssize_t n = write(fd, data, len);
+    if (n <= 0)
+    {
+      return false;
+    }
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+int exportBuiltin(const char *path)
+{
+  TimelineLibrary library(sequences, MOVE_COUNT);
+  std::vector<uint8_t> image(1 << 20);
+  size_t size = library.encode(image.data(), image.size());
+
+  FILE *f = fopen(path, "wb");
+  if (!f || fwrite(image.data(), 1, size, f) != size)
+  {
+    perror(path);
+    return 1;
+  }
+  fclose(f);
+  printf("%s: %u timelines, %zu bytes\n", path, library.getSize(), size);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc == 3 && strcmp(argv[1], "--export") == 0)
+  {
+    return exportBuiltin(argv[2]);
+  }
+  if (argc < 3)
+  {
+    fprintf(stderr, "usage: showLoad <device> <image> [baud] | showLoad --export <image>\n");
+    return 2;
+  }
+
+  FILE *f = fopen(argv[2], "rb");
+  if (!f)
+  {
+    perror(argv[2]);
+    return 1;
+  }
+  std::vector<uint8_t> image;
+  uint8_t buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0)
+  {
+    image.insert(image.end(), buffer, buffer + n);
+  }
+  fclose(f);
+
+  TimelineLibrary library;
+  if (!library.load(image.data(), image.size()))
+  {
+    fprintf(stderr, "%s: not a valid timeline image\n", argv[2]);
+    return 1;
+  }
+  struct_timeline_image_header header;
+  readTimelineImageHeader(image.data(), image.size(), header);
+
+  int fd = open(argv[1], O_RDWR | O_NOCTTY);
+  if (fd < 0)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  setRaw(fd, argc > 3 ? atol(argv[3]) : 921600);
+
+  // command and header, the remote erases the partition before answering
+  uint8_t command = SHOW_LOAD_COMMAND;
+  struct_log_record status;
+  if (!writeAll(fd, &command, 1) || !writeAll(fd, image.data(), sizeof(header)) ||
+      !waitForStatus(fd, 10000, status) || status.arg != SHOW_LOAD_READY)
+  {
+    fprintf(stderr, "remote did not accept the image\n");
+    return 1;
+  }
+
+  size_t sent = sizeof(header);
+  while (sent < header.size)
+  {
+    size_t len = header.size - sent < SHOW_LOAD_BLOCK ? header.size - sent : SHOW_LOAD_BLOCK;
+    if (!writeAll(fd, image.data() + sent, len) || !waitForStatus(fd, 2000, status) ||
+        status.arg != SHOW_LOAD_READY || (size_t)status.values[0] != sent + len)
+    {
+      fprintf(stderr, "load failed after %zu of %u bytes\n", sent, header.size);
+      return 1;
+    }
+    sent += len;
+    fprintf(stderr, "\r%zu / %u", sent, header.size);
+  }
+  fprintf(stderr, "\n");
+
+  if (!waitForStatus(fd, 2000, status) || status.arg != SHOW_LOAD_DONE)
+  {
+    fprintf(stderr, "remote rejected the image\n");
+    return 1;
+  }
+  printf("loaded %u timelines, %u bytes, crc %08x\n", header.timelineCount, header.size, header.crc);
+  return 0;
+}
@@ -0,0 +1,338 @@
+/*
+Title: Acrobot show simulator
+Description: Plays every timeline of a show through the leg's control path
+against a model of the joints, on a virtual 1 kHz clock, much faster than
+real time. The timelines play with the firmware's own TimelinePlayer, as on
+the leg. The PID and the deadband mapping are those of leg/src/main.cpp. The
+plant is the DC gearmotor in common/legModel.h.
+
+Per timeline it reports the tracking error and the overshoot past the
+setpoint range of the last 500 ms. It reports time at full PWM, time outside
+forwardLimit..backwardLimit and the peak current. A timeline that overshoots,
+saturates for long, leaves the limits or stalls the motor is flagged, and the
+tool exits with 1.
+
+--csv and --bin write every sample: setpoint, position, PWM duty and current
+per joint. The binary file is a struct_sim_file_header followed by
+struct_sim_record, little endian.
+
+Usage: showSim [image] [--move name] [--csv file] [--bin file]
+*/
+
+#include "../common/legModel.h"
+
+#include <sequences.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+const uint32_t SETTLE = 1000;                // ms after the last keyframe of a holding timeline
+const uint32_t OVERSHOOT_WINDOW = 500;       // ms
+const uint8_t SUBSTEPS = 4;                  // plant steps per 1 ms PID sample
+const double MAX_OVERSHOOT = 3;              // degrees
+const uint32_t MAX_SATURATION = 300;         // ms at full PWM in one go
+const double LIMIT_TOLERANCE = 1;            // degrees
+
+typedef struct struct_sim_file_header
+{
+  char magic[4]; // "ASIM"
+  uint16_t version;
+  uint16_t recordSize;
+} struct_sim_file_header;
+
+typedef struct struct_sim_record
+{
+  uint16_t timeline; // index in the library
+  uint16_t reserved;
+  uint32_t millis;
+  float setpoint[2]; // right, left, degrees
+  float position[2];
+  float current[2]; // A
+  int16_t duty[2];  // as written to the PWM channels, positive = backward
+} struct_sim_record;
+
+struct JointResult
+{
+  double squaredError = 0;
+  double overshoot = 0;
+  uint32_t overshootAt = 0;
+  uint32_t saturatedMs = 0;
+  uint32_t longestSaturation = 0;
+  uint32_t outsideLimitsMs = 0;
+  double worstLimit = 0; // degrees past the limit
+  double peakCurrent = 0;
+};
+
+PlantParameters parameters;
+FILE *csv = nullptr;
+FILE *bin = nullptr;
+int flagged = 0;
+
+void simulate(TimelineLibrary &library, int16_t index)
+{
+  struct_timeline timeline;
+  library.get(index, timeline);
+  if (!timeline.count)
+  {
+    return;
+  }
+
+  TimelinePlayer player(library);
+  player.start(index, 0);
+  uint32_t end =
+      timeline.duration ? timeline.duration : timeline.keyframes[timeline.count - 1].time + SETTLE;
+
+  // from rest in the first pose
+  double setpoints[2] = {(double)timeline.keyframes[0].rTarget,
+                         (double)timeline.keyframes[0].lTarget};
+  double kP = timeline.keyframes[0].kP / 100.;
+  LegPlant plants[2] = {LegPlant(parameters), LegPlant(parameters)};
+  LegPid pids[2];
+  int16_t duties[2] = {0, 0};
+  SetpointRange ranges[2] = {SetpointRange(OVERSHOOT_WINDOW), SetpointRange(OVERSHOOT_WINDOW)};
+  JointResult results[2];
+  uint32_t saturation[2] = {0, 0};
+  double lastSetpoints[2] = {setpoints[0], setpoints[1]};
+  int8_t directions[2] = {0, 0};
+  for (int joint = 0; joint < 2; joint++)
+  {
+    plants[joint].reset(setpoints[joint]);
+    pids[joint].reset(plants[joint].getMeasured());
+  }
+
+  for (uint32_t t = 0; t < end; t++)
+  {
+    struct_timeline_state state;
+    if (player.update(t, state))
+    {
+      setpoints[0] = state.rTarget;
+      setpoints[1] = state.lTarget;
+      kP = state.kP;
+    }
+
+    struct_sim_record record = {(uint16_t)index, 0, t, {}, {}, {}, {}};
+    for (int joint = 0; joint < 2; joint++)
+    {
+      LegPlant &plant = plants[joint];
+      JointResult &result = results[joint];
+
+      // rP drives both legs, like updatePID()
+      pids[joint].setTunings(kP, 0, 0);
+      int32_t output = pids[joint].compute(setpoints[joint], plant.getMeasured());
+      duties[joint] = legDuty(joint, output, duties[joint]);
+      double peak = 0;
+      for (uint8_t i = 0; i < SUBSTEPS; i++)
+      {
+        plant.step(duties[joint], 0.001 / SUBSTEPS);
+        peak = fmax(peak, fabs(plant.getCurrent()));
+      }
+
+      double position = plant.getPosition();
+      double error = setpoints[joint] - position;
+      result.squaredError += error * error;
+
+      // past the recent setpoints, and ahead of the setpoint in the direction
+      // it last moved in, so lagging behind a move does not count
+      if (setpoints[joint] != lastSetpoints[joint])
+      {
+        directions[joint] = setpoints[joint] > lastSetpoints[joint] ? 1 : -1;
+        lastSetpoints[joint] = setpoints[joint];
+      }
+      ranges[joint].add(t, setpoints[joint]);
+      double past = fmin(
+          fmax(position - ranges[joint].getHigh(), ranges[joint].getLow() - position),
+          (position - setpoints[joint]) * directions[joint]);
+      if (past > result.overshoot)
+      {
+        result.overshoot = past;
+        result.overshootAt = t;
+      }
+
+      if (abs(duties[joint]) >= Robot::Pwm::RANGE)
+      {
+        result.saturatedMs++;
+        saturation[joint]++;
+        result.longestSaturation = std::max(result.longestSaturation, saturation[joint]);
+      }
+      else
+      {
+        saturation[joint] = 0;
+      }
+
+      double outside = fmax(forwardLimit - position, position - backwardLimit);
+      if (outside > 0)
+      {
+        result.outsideLimitsMs++;
+        result.worstLimit = fmax(result.worstLimit, outside);
+      }
+      result.peakCurrent = fmax(result.peakCurrent, peak);
+
+      record.setpoint[joint] = setpoints[joint];
+      record.position[joint] = position;
+      record.current[joint] = plant.getCurrent();
+      record.duty[joint] = duties[joint];
+    }
+
+    if (csv)
+    {
+      fprintf(csv, "%s,%u,%.2f,%.2f,%d,%.3f,%.2f,%.2f,%d,%.3f\n", timeline.name, t,
+              record.setpoint[0], record.position[0], record.duty[0], record.current[0],
+              record.setpoint[1], record.position[1], record.duty[1], record.current[1]);
+    }
+    if (bin)
+    {
+      fwrite(&record, sizeof(record), 1, bin);
+    }
+  }
+
+  const char *joints[] = {"right", "left"};
+  for (int joint = 0; joint < 2; joint++)
+  {
+    const JointResult &result = results[joint];
+    printf("%-20s %-5s rms %5.1f  overshoot %5.1f  full pwm %6u ms (%4u)  outside %5u ms  "
+           "peak %4.1f A\n",
+           timeline.name, joints[joint], sqrt(result.squaredError / end), result.overshoot,
+           result.saturatedMs, result.longestSaturation, result.outsideLimitsMs,
+           result.peakCurrent);
+
+    if (result.overshoot > MAX_OVERSHOOT)
+    {
+      printf("FLAG %s %s: overshoots by %.1f degrees at %u ms\n", timeline.name, joints[joint],
+             result.overshoot, result.overshootAt);
+      flagged++;
+    }
+    if (result.longestSaturation > MAX_SATURATION)
+    {
+      printf("FLAG %s %s: at full PWM for %u ms in one go\n", timeline.name, joints[joint],
+             result.longestSaturation);
+      flagged++;
+    }
+    if (result.worstLimit > LIMIT_TOLERANCE)
+    {
+      printf("FLAG %s %s: %.1f degrees past the limits, %u ms in total\n", timeline.name,
+             joints[joint], result.worstLimit, result.outsideLimitsMs);
+      flagged++;
+    }
+    if (result.peakCurrent >= parameters.stallCurrent)
+    {
+      printf("FLAG %s %s: reaches the stall current of %.1f A\n", timeline.name, joints[joint],
+             parameters.stallCurrent);
+      flagged++;
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const char *imageName = nullptr;
+  const char *moveName = nullptr;
+  const char *csvName = nullptr;
+  const char *binName = nullptr;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--move") == 0 && i + 1 < argc)
+    {
+      moveName = argv[++i];
+    }
+    else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+    {
+      csvName = argv[++i];
+    }
+    else if (strcmp(argv[i], "--bin") == 0 && i + 1 < argc)
+    {
+      binName = argv[++i];
+    }
+    else if (argv[i][0] != '-')
+    {
+      imageName = argv[i];
+    }
+    else
+    {
+      fprintf(stderr, "usage: showSim [image] [--move name] [--csv file] [--bin file]\n");
+      return 2;
+    }
+  }
+
+  // the built-in sequences, or a compiled show
+  TimelineLibrary library(sequences, MOVE_COUNT);
+  std::vector<uint32_t> image; // words, the image must be aligned
+  if (imageName)
+  {
+    FILE *in = fopen(imageName, "rb");
+    if (!in)
+    {
+      perror(imageName);
+      return 1;
+    }
+    fseek(in, 0, SEEK_END);
+    long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    image.resize((size + 3) / 4);
+    bool read = fread(image.data(), 1, size, in) == (size_t)size;
+    fclose(in);
+    if (!read || !library.load((const uint8_t *)image.data(), size))
+    {
+      fprintf(stderr, "%s: not a timeline image\n", imageName);
+      return 1;
+    }
+  }
+
+  if (csvName)
+  {
+    csv = fopen(csvName, "w");
+    if (!csv)
+    {
+      perror(csvName);
+      return 1;
+    }
+    fprintf(csv, "timeline,ms,rSetpoint,rPosition,rDuty,rCurrent,lSetpoint,lPosition,lDuty,"
+                 "lCurrent\n");
+  }
+  if (binName)
+  {
+    bin = fopen(binName, "wb");
+    if (!bin)
+    {
+      perror(binName);
+      return 1;
+    }
+    struct_sim_file_header header = {{'A', 'S', 'I', 'M'}, 1, sizeof(struct_sim_record)};
+    fwrite(&header, sizeof(header), 1, bin);
+  }
+
+  auto started = std::chrono::steady_clock::now();
+  uint64_t simulated = 0;
+  for (int16_t i = 0; i < library.getSize(); i++)
+  {
+    struct_timeline timeline;
+    library.get(i, timeline);
+    if (moveName && strcmp(moveName, timeline.name) != 0)
+    {
+      continue;
+    }
+    simulate(library, i);
+    if (timeline.count)
+    {
+      simulated += timeline.duration ? timeline.duration
+                                     : timeline.keyframes[timeline.count - 1].time + SETTLE;
+    }
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  if (csv)
+  {
+    fclose(csv);
+  }
+  if (bin)
+  {
+    fclose(bin);
+  }
+  printf("%.1f s of show in %.2f s, %d flags\n", simulated / 1000., seconds, flagged);
+  return flagged ? 1 : 0;
+}
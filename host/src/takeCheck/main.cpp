@@ -0,0 +1,193 @@
+/*
+Title: Acrobot input take check
+Description: Encodes a synthetic remote input stream with InputTakeEncoder,
+as the remote does while recording a take, and checks:
+
+1. Round trip: InputTakeDecoder gives back every sample that changed a
+   channel or held a key, with its time, and nothing else.
+2. Truncation: cut anywhere, as a take that ran out of partition or lost
+   its last page, the decoder gives back the records that are whole, then
+   stops without reading past the end.
+
+The stream has slow and fast slider moves, full-scale jumps both ways,
+keys with and without a move, and gaps of up to hours. Anything wrong
+exits with 1.
+
+Usage: takeCheck
+*/
+
+#include <inputTake.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+typedef struct struct_timed_sample
+{
+  uint32_t time; // ms since the take started
+  struct_input_sample sample;
+} struct_timed_sample;
+
+int failures = 0;
+
+void fail(const char *what, double value)
+{
+  if (failures++ < 20)
+  {
+    printf("FAIL %s %.0f\n", what, value);
+  }
+}
+
+// a fixed pseudo-random sequence, so every run and every host gives the
+// same stream
+uint32_t seed = 40;
+uint32_t pseudoRandom(uint32_t range)
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % range;
+}
+
+std::vector<struct_timed_sample> makeStream()
+{
+  std::vector<struct_timed_sample> stream;
+  struct_input_sample sample;
+  memset(&sample, 0, sizeof(sample));
+  uint32_t time = 0;
+  for (uint32_t i = 0; i < 20000; i++)
+  {
+    // mostly a loop a ms, now and then the remote was busy or left alone
+    if (pseudoRandom(100))
+    {
+      time += 1;
+    }
+    else
+    {
+      time += pseudoRandom(5) ? 1 + pseudoRandom(500) : pseudoRandom(1u << 24);
+    }
+
+    uint8_t kind = pseudoRandom(10);
+    if (kind < 6)
+    {
+      // a slider or joystick creeps, by more than the hysteresis
+      uint8_t channel = pseudoRandom(INPUT_CHANNELS);
+      sample.channels[channel] += (int16_t)pseudoRandom(65) - 32;
+    }
+    else if (kind < 7)
+    {
+      // all the way across, either way, any channel
+      uint8_t channel = pseudoRandom(INPUT_CHANNELS);
+      sample.channels[channel] = sample.channels[channel] > 0 ? -32768 : 32767;
+    }
+    else if (kind < 8)
+    {
+      for (uint8_t channel = 0; channel < INPUT_CHANNELS; channel++)
+      {
+        sample.channels[channel] += (int16_t)pseudoRandom(2001) - 1000;
+      }
+    }
+    // else nothing moved, which adds no record unless there is a key
+
+    sample.key = pseudoRandom(8) ? 0 : "0123456789ABCD*#"[pseudoRandom(16)];
+    stream.push_back({time, sample});
+  }
+  return stream;
+}
+
+bool same(const struct_input_sample &a, const struct_input_sample &b)
+{
+  return !memcmp(a.channels, b.channels, sizeof(a.channels)) && a.key == b.key;
+}
+
+int main()
+{
+  const uint32_t START = 123456; // the remote's millis() at record()
+  std::vector<struct_timed_sample> stream = makeStream();
+
+  InputTakeEncoder encoder;
+  encoder.begin(START);
+  std::vector<uint8_t> take;
+  std::vector<struct_timed_sample> expected;
+  std::vector<size_t> ends; // of each record in take
+  for (const struct_timed_sample &input : stream)
+  {
+    uint8_t record[INPUT_TAKE_MAX_RECORD_SIZE];
+    size_t len = encoder.add(input.sample, START + input.time, record);
+    if (len > INPUT_TAKE_MAX_RECORD_SIZE)
+    {
+      fail("record longer than INPUT_TAKE_MAX_RECORD_SIZE", len);
+    }
+    if (len)
+    {
+      take.insert(take.end(), record, record + len);
+      expected.push_back(input);
+      ends.push_back(take.size());
+    }
+  }
+  if (encoder.getRecords() != expected.size())
+  {
+    fail("records counted, of written", encoder.getRecords());
+  }
+  if (encoder.getDuration() != expected.back().time)
+  {
+    fail("duration, ms", encoder.getDuration());
+  }
+  printf("%zu samples, %zu records, %zu bytes, %.2f a record\n", stream.size(), expected.size(),
+         take.size(), (double)take.size() / expected.size());
+
+  // 1: the whole take
+  InputTakeDecoder decoder;
+  decoder.begin(take.data(), take.size());
+  struct_input_sample sample;
+  uint32_t time;
+  size_t decoded = 0;
+  while (decoder.next(sample, time))
+  {
+    if (decoded < expected.size() &&
+        (time != expected[decoded].time || !same(sample, expected[decoded].sample)))
+    {
+      fail("round trip differs at record", decoded);
+    }
+    decoded++;
+  }
+  if (decoded != expected.size())
+  {
+    fail("records decoded, of written", decoded);
+  }
+
+  // 2: every cut in the first and last few hundred bytes, and every 97th in
+  // between; each copy is exactly as long, so a read past it is one past the
+  // end of the vector
+  size_t whole = 0;
+  for (size_t len = 0; len < take.size(); len++)
+  {
+    if (len > 500 && len < take.size() - 500 && len % 97)
+    {
+      continue;
+    }
+    while (whole < ends.size() && ends[whole] <= len)
+    {
+      whole++;
+    }
+    std::vector<uint8_t> cut(take.begin(), take.begin() + len);
+    decoder.begin(cut.data(), cut.size());
+    decoded = 0;
+    while (decoder.next(sample, time))
+    {
+      if (decoded >= whole || time != expected[decoded].time ||
+          !same(sample, expected[decoded].sample))
+      {
+        fail("truncated take differs, cut at byte", len);
+        break;
+      }
+      decoded++;
+    }
+    if (decoded != whole)
+    {
+      fail("records decoded from a truncated take, of whole ones, cut at byte", len);
+    }
+  }
+
+  printf("%d failures\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,233 @@
+/*
+Title: Acrobot teach check
+Description: Records synthetic demonstrations with TeachRecorder, as the leg
+does while its legs are moved by hand, and checks:
+
+1. Round trip: reading the recording back gives every sample that was
+   added, time and counts, and nothing after one that did not fit.
+2. Wrap: a leg passing the sensor's count 0 either way reads back as one
+   continuous move, not a jump of a turn.
+3. Swinging door: at tolerances of 1, 2 and 4 degrees, the linear keyframes
+   extract() makes are within the tolerance of every sample.
+
+The demonstrations move both legs at 0 to 3 counts of noise, hold still,
+jump and skip ms. Their bytes per sample are reported; with noise they have
+to stay under 2. Anything wrong exits with 1.
+
+Usage: teachCheck
+*/
+
+#include <teachRecorder.h>
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+const float DEGREES_PER_COUNT = 360.f / TEACH_COUNTS;
+const float TOLERANCES[] = {1, 2, 4};
+const uint16_t MAX_KEYFRAMES = 4096;
+
+typedef struct struct_sample
+{
+  uint32_t time;
+  uint16_t raw[2];  // as the sensors read it
+  int32_t moved[2]; // the same, not wrapped
+} struct_sample;
+
+int failures = 0;
+
+void fail(const char *demonstration, const char *what, double value)
+{
+  if (failures++ < 20)
+  {
+    printf("FAIL %s: %s %.3f\n", demonstration, what, value);
+  }
+}
+
+// a fixed pseudo-random sequence, so every run and every host gives the
+// same demonstrations
+uint32_t seed = 41;
+int32_t noise(int32_t counts)
+{
+  seed = seed * 1103515245 + 12345;
+  return counts ? (int32_t)(seed >> 16) % (2 * counts + 1) - counts : 0;
+}
+
+uint16_t wrap(int32_t raw)
+{
+  return raw & (TEACH_COUNTS - 1);
+}
+
+// 20 s around centre counts: a swing, a hold, a few jumps of 50 counts and a
+// late PID compute every second or so
+std::vector<struct_sample> demonstrate(int32_t rCentre, int32_t lCentre, int32_t noiseCounts)
+{
+  std::vector<struct_sample> samples;
+  uint32_t time = 1000; // the leg's millis() when teaching starts
+  for (uint32_t t = 0; t < 20000; t++)
+  {
+    if (t % 997 == 0 && t)
+    {
+      t += 1 + t % 3;
+    }
+    if (t > 15000 && t < 15250)
+    {
+      continue; // a gap, the loop held up
+    }
+    float swing = t < 5000 || t > 8000 ? sinf(2 * M_PI * t / 4000) : 0; // held still between
+    int32_t jump = t > 10000 && t < 12000 ? 50 * (int32_t)(t / 500 % 2) : 0;
+    int32_t r = rCentre + (int32_t)lroundf(600 * swing) + jump + noise(noiseCounts);
+    int32_t l = lCentre - (int32_t)lroundf(400 * swing) + noise(noiseCounts);
+    samples.push_back({time + t, {wrap(r), wrap(l)}, {r, l}});
+  }
+  return samples;
+}
+
+// degrees as extract() sees a sample: continuous from the first sample on
+float degrees(const struct_teach_joint &joint, int32_t raw)
+{
+  return joint.offset + joint.scale * raw;
+}
+
+// keyframe values at time, linear as the player interpolates them
+float keyframeAt(const struct_keyframe *keyframes, uint16_t count, uint32_t time, uint8_t joint)
+{
+  uint16_t i = 0;
+  while (i + 2 < count && keyframes[i + 1].time <= time)
+  {
+    i++;
+  }
+  const struct_keyframe &from = keyframes[i];
+  const struct_keyframe &to = keyframes[i + 1 < count ? i + 1 : i];
+  float a = joint ? from.lTarget : from.rTarget;
+  float b = joint ? to.lTarget : to.rTarget;
+  if (to.time == from.time)
+  {
+    return a;
+  }
+  float u = (float)(time - from.time) / (to.time - from.time);
+  return a + (b - a) * u;
+}
+
+// degrees between two angles, the short way round
+float angleError(float a, float b)
+{
+  float error = fmodf(fabsf(a - b), 360);
+  return error > 180 ? 360 - error : error;
+}
+
+void check(const char *name, const std::vector<struct_sample> &samples,
+           const struct_teach_joint joints[2], size_t capacity, bool noisy)
+{
+  std::vector<uint8_t> buffer(capacity);
+  TeachRecorder recorder(buffer.data(), capacity);
+  recorder.begin(samples[0].time, samples[0].raw[0], samples[0].raw[1]);
+  size_t added = 1;
+  while (added < samples.size() &&
+         recorder.add(samples[added].time, samples[added].raw[0], samples[added].raw[1]))
+  {
+    added++;
+  }
+  recorder.end();
+
+  if (recorder.getSamples() != added)
+  {
+    fail(name, "samples counted, of added", (double)recorder.getSamples() - added);
+  }
+  if (recorder.getDuration() != samples[added - 1].time - samples[0].time)
+  {
+    fail(name, "duration, ms", recorder.getDuration());
+  }
+
+  // 1 and 2: every sample back, and the counts move as the leg did, also
+  // where they wrap
+  struct_teach_cursor cursor;
+  recorder.rewind(cursor);
+  size_t read = 0;
+  bool more = true;
+  while (more && read < added)
+  {
+    const struct_sample &sample = samples[read];
+    for (uint8_t j = 0; j < 2; j++)
+    {
+      if (wrap(cursor.raw[j]) != sample.raw[j])
+      {
+        fail(name, "counts read back differ at sample", read);
+      }
+      if (cursor.raw[j] - samples[0].raw[j] != sample.moved[j] - samples[0].moved[j])
+      {
+        fail(name, "counts jump a turn at sample", read);
+      }
+    }
+    if (cursor.time != sample.time - samples[0].time)
+    {
+      fail(name, "time read back differs at sample", read);
+    }
+    read++;
+    more = recorder.next(cursor);
+  }
+  if (read != added || more)
+  {
+    fail(name, "samples read back, of added", (double)read - added);
+  }
+
+  double bytes = (double)recorder.getSize() / added;
+  printf("%-12s %6zu samples %6zu bytes, %.2f a sample\n", name, added, recorder.getSize(), bytes);
+  if (noisy && bytes >= 2)
+  {
+    fail(name, "bytes a sample", bytes);
+  }
+
+  // 3: the keyframes at each tolerance against every sample
+  static struct_keyframe keyframes[MAX_KEYFRAMES];
+  for (float tolerance : TOLERANCES)
+  {
+    uint16_t count = recorder.extract(joints, tolerance, 100, keyframes, MAX_KEYFRAMES);
+    if (!count)
+    {
+      fail(name, "no keyframes at tolerance", tolerance);
+      continue;
+    }
+    float worst = 0;
+    recorder.rewind(cursor);
+    do
+    {
+      for (uint8_t j = 0; j < 2; j++)
+      {
+        float error = angleError(keyframeAt(keyframes, count, cursor.time, j),
+                                 degrees(joints[j], cursor.raw[j]));
+        worst = error > worst ? error : worst;
+      }
+    } while (recorder.next(cursor));
+    printf("  tolerance %g: %u keyframes, worst error %.2f degrees\n", tolerance, count, worst);
+    if (worst > tolerance + 1e-3f)
+    {
+      fail(name, "worst keyframe error, degrees", worst);
+    }
+  }
+}
+
+int main()
+{
+  // about 180 degrees at the centre of each demonstration, the left leg
+  // mirrored as on the leg
+  const struct_teach_joint joints[2] = {{180 - 2048 * DEGREES_PER_COUNT, DEGREES_PER_COUNT},
+                                        {180 + 1000 * DEGREES_PER_COUNT, -DEGREES_PER_COUNT}};
+  char name[32];
+  for (int32_t noiseCounts = 0; noiseCounts <= 3; noiseCounts++)
+  {
+    snprintf(name, sizeof(name), "noise %d", noiseCounts);
+    check(name, demonstrate(2048, 1000, noiseCounts), joints, 48 * 1024, noiseCounts > 0);
+  }
+
+  // both legs swing across the sensor's zero, the right one starting below it
+  const struct_teach_joint zero[2] = {{180, DEGREES_PER_COUNT}, {180, -DEGREES_PER_COUNT}};
+  check("wrap", demonstrate(-100, 100, 1), zero, 48 * 1024, true);
+
+  // a buffer that fills up part way, the recording ends there
+  check("full buffer", demonstrate(2048, 1000, 2), joints, 4096, true);
+
+  printf("%d failures\n", failures);
+  return failures ? 1 : 0;
+}
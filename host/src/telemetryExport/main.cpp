@@ -0,0 +1,160 @@
+/*
+Title: Acrobot telemetry export
+Description: Turns the telemetry dumps in a binary log into CSV, a row per
+1 kHz leg sample. The remote keeps the last seconds of leg telemetry, 't' on
+its serial starts a dump.
+
+Reads a capture file or stdin until the end, or a serial device (set to raw
+mode at the given baud) until one dump is complete.
+
+Usage: telemetryExport [file-or-device] [baud] > telemetry.csv
+       telemetryExport /dev/ttyUSB0 921600 > telemetry.csv
+*/
+
+#include "../common/serialPort.h"
+
+#include <binaryLog.h>
+#include <telemetryFrame.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static struct_telemetry_sample sample;
+static uint8_t joints; // of the sample so far, as a bit each
+
+static int16_t low(int32_t value)
+{
+  return (int16_t)(value & 0xFFFF);
+}
+
+static int16_t high(int32_t value)
+{
+  return (int16_t)((uint32_t)value >> 16);
+}
+
+static void printSample()
+{
+  printf("%u,%u", sample.micros, sample.loopMicros);
+  for (uint8_t i = 0; i < TELEMETRY_JOINTS; i++)
+  {
+    const struct_telemetry_joint &j = sample.joints[i];
+    printf(",%d,%d,%d,%d,%d", j.position, j.velocity, j.setpoint, j.output, j.duty);
+  }
+  printf("\n");
+}
+
+// the joints of a sample come one after the other, a sample missing one
+// (the log dropped it) is skipped
+static bool addRecord(const struct_log_record &r)
+{
+  if (r.arg >= TELEMETRY_JOINTS)
+  {
+    return false;
+  }
+  if (r.arg == 0 || (uint32_t)r.values[0] != sample.micros)
+  {
+    joints = 0;
+  }
+
+  sample.micros = r.values[0];
+  sample.loopMicros = (uint16_t)high(r.values[3]);
+  struct_telemetry_joint &j = sample.joints[r.arg];
+  j.position = low(r.values[1]);
+  j.velocity = high(r.values[1]);
+  j.setpoint = low(r.values[2]);
+  j.output = high(r.values[2]);
+  j.duty = low(r.values[3]);
+  joints |= 1 << r.arg;
+
+  if (joints != (1 << TELEMETRY_JOINTS) - 1)
+  {
+    return false;
+  }
+  printSample();
+  joints = 0;
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  int fd = STDIN_FILENO;
+  if (argc > 1)
+  {
+    fd = open(argv[1], O_RDONLY | O_NOCTTY);
+    if (fd < 0)
+    {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+  setRaw(fd, argc > 2 ? atol(argv[2]) : 921600);
+  struct stat info;
+  bool device = fstat(fd, &info) == 0 && S_ISCHR(info.st_mode);
+  if (device)
+  {
+    fprintf(stderr, "waiting for a telemetry dump\n");
+  }
+
+  printf("micros,loopMicros,rPosition,rVelocity,rSetpoint,rOutput,rDuty,"
+         "lPosition,lVelocity,lSetpoint,lOutput,lDuty\n");
+
+  uint8_t frame[256];
+  size_t frameLen = 0;
+  bool overflow = false;
+  bool done = false;
+  unsigned long samples = 0;
+  unsigned long expected = 0;
+  unsigned long lostFrames = 0;
+  unsigned long dumps = 0;
+
+  uint8_t buffer[4096];
+  ssize_t n;
+  while (!done && (n = read(fd, buffer, sizeof(buffer))) > 0)
+  {
+    for (ssize_t i = 0; i < n && !done; i++)
+    {
+      if (buffer[i] != 0)
+      {
+        if (frameLen < sizeof(frame))
+        {
+          frame[frameLen++] = buffer[i];
+        }
+        else
+        {
+          overflow = true;
+        }
+        continue;
+      }
+
+      struct_log_record r;
+      if (!overflow && frameLen && decodeLogFrame(frame, frameLen, r))
+      {
+        if (r.id == LOG_REMOTE_TELEMETRY)
+        {
+          samples += addRecord(r);
+        }
+        else if (r.id == LOG_REMOTE_TELEMETRY_DONE)
+        {
+          expected += r.values[0];
+          lostFrames += r.values[1];
+          dumps++;
+          done = device; // a file can hold several
+        }
+        else if (r.id == LOG_DROPPED)
+        {
+          fprintf(stderr, "the log dropped %d records, some samples may be missing\n", r.values[0]);
+        }
+      }
+      frameLen = 0;
+      overflow = false;
+    }
+    fflush(stdout);
+  }
+
+  fprintf(stderr, "%lu of %lu samples from %lu dumps, %lu frames lost over the radio\n", samples,
+          expected, dumps, lostFrames);
+  return 0;
+}
@@ -0,0 +1,189 @@
+/*
+Title: Acrobot timeline check
+Description: Plays every built-in sequence at 1 ms steps, as authored and
+with every keyframe forced to each interpolation type, and checks that the
+interpolated targets and gains never leave the range of the two keyframes
+around them, nor forwardLimit..backwardLimit when both keyframes are inside
+it. Keyframes that are themselves outside the limits are only reported.
+Also checks that TimelineLibrary::load() takes the image of the built-in
+sequences and turns down images whose counts or offsets run past the end.
+Exits with 1 on any violation.
+
+Usage: timelineCheck
+*/
+
+#include <sequences.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+const char *INTERPOLATION_NAMES[] = {"step", "linear", "hermite", "ease"};
+const int AS_AUTHORED = -1;
+
+int violations = 0;
+int warnings = 0;
+
+void report(const char *name, const char *mode, uint32_t time, const char *what, float value,
+            float low, float high)
+{
+  if (violations++ < 20)
+  {
+    printf("FAIL %s (%s) at %u ms: %s %.2f outside %.2f..%.2f\n", name, mode, time, what, value,
+           low, high);
+  }
+}
+
+void checkTimeline(const struct_timeline &authored, int mode)
+{
+  std::vector<struct_keyframe> keyframes(authored.keyframes, authored.keyframes + authored.count);
+  if (mode != AS_AUTHORED)
+  {
+    for (struct_keyframe &k : keyframes)
+    {
+      k.interpolation = mode;
+    }
+  }
+
+  struct_timeline timeline = authored;
+  timeline.keyframes = keyframes.data();
+  timeline.next = -1; // stay inside this timeline
+  timeline.duration = 0;
+
+  const char *modeName = mode == AS_AUTHORED ? "as authored" : INTERPOLATION_NAMES[mode];
+  const char *what[] = {"right", "left", "kP"};
+
+  TimelineLibrary library(&timeline, 1);
+  TimelinePlayer player(library);
+  player.start(0, 0);
+
+  uint32_t end = keyframes.back().time + 1;
+  size_t segment = 0;
+  for (uint32_t t = 0; t <= end; t++)
+  {
+    while (segment + 1 < keyframes.size() && keyframes[segment + 1].time <= t)
+    {
+      segment++;
+    }
+
+    struct_timeline_state state;
+    if (!player.update(t, state))
+    {
+      continue;
+    }
+    float values[3] = {state.rTarget, state.lTarget, state.kP};
+
+    const struct_keyframe &from = keyframes[segment];
+    const struct_keyframe &to = keyframes[std::min(segment + 1, keyframes.size() - 1)];
+
+    for (uint8_t field = 0; field < 3; field++)
+    {
+      float a = keyframeValue(from, field);
+      float b = keyframeValue(to, field);
+      float low = std::min(a, b) - 0.01f;
+      float high = std::max(a, b) + 0.01f;
+      if (values[field] < low || values[field] > high)
+      {
+        report(authored.name, modeName, t, what[field], values[field], low, high);
+      }
+
+      bool endsInside = field < 2 && low >= forwardLimit - 0.01f && high <= backwardLimit + 0.01f;
+      if (endsInside && (values[field] < forwardLimit || values[field] > backwardLimit))
+      {
+        report(authored.name, modeName, t, what[field], values[field], forwardLimit, backwardLimit);
+      }
+    }
+  }
+}
+
+// an image changed after encoding, with its crc fixed up so only the
+// bounds checks stand in the way
+bool loads(std::vector<uint32_t> storage, size_t len, uint32_t firstKeyframe, uint16_t count)
+{
+  uint8_t *image = (uint8_t *)storage.data();
+  struct_timeline_image_header header;
+  memcpy(&header, image, sizeof(header));
+  struct_timeline_image_entry entry;
+  memcpy(&entry, image + sizeof(header), sizeof(entry));
+  entry.firstKeyframe = firstKeyframe;
+  entry.count = count;
+  memcpy(image + sizeof(header), &entry, sizeof(entry));
+  header.crc = crc32(image + sizeof(header), header.size - sizeof(header));
+  memcpy(image, &header, sizeof(header));
+
+  TimelineLibrary library;
+  return library.load(image, len);
+}
+
+void checkImage()
+{
+  TimelineLibrary builtIn(sequences, MOVE_COUNT);
+  std::vector<uint32_t> storage(64 * 1024);
+  size_t len = builtIn.encode((uint8_t *)storage.data(), storage.size() * sizeof(uint32_t));
+  struct_timeline_image_header header;
+  if (!len || !readTimelineImageHeader((uint8_t *)storage.data(), len, header))
+  {
+    printf("FAIL the built-in sequences do not encode\n");
+    violations++;
+    return;
+  }
+
+  struct
+  {
+    const char *name;
+    uint32_t firstKeyframe;
+    uint16_t count;
+    bool loads;
+  } cases[] = {
+      {"as encoded", 0, 1, true},
+      {"the last keyframe", header.keyframeCount - 1, 1, true},
+      {"one past the end", header.keyframeCount, 1, false},
+      {"wrapping around 32 bits", UINT32_MAX, 2, false},
+  };
+  for (const auto &c : cases)
+  {
+    if (loads(storage, len, c.firstKeyframe, c.count) != c.loads)
+    {
+      printf("FAIL an image with an entry %s is %s\n", c.name, c.loads ? "turned down" : "loaded");
+      violations++;
+    }
+  }
+}
+
+int main()
+{
+  checkImage();
+
+  for (uint16_t i = 0; i < MOVE_COUNT; i++)
+  {
+    const struct_timeline &timeline = sequences[i];
+    if (!timeline.count)
+    {
+      continue;
+    }
+
+    for (uint16_t k = 0; k < timeline.count; k++)
+    {
+      const struct_keyframe &keyframe = timeline.keyframes[k];
+      if (keyframe.rTarget < forwardLimit || keyframe.rTarget > backwardLimit ||
+          keyframe.lTarget < forwardLimit || keyframe.lTarget > backwardLimit)
+      {
+        printf("warning: %s keyframe at %u ms is outside the limits (%u, %u)\n", timeline.name,
+               keyframe.time, keyframe.rTarget, keyframe.lTarget);
+        warnings++;
+      }
+    }
+
+    checkTimeline(timeline, AS_AUTHORED);
+    for (int mode = INTERP_LINEAR; mode <= INTERP_EASE; mode++)
+    {
+      checkTimeline(timeline, mode);
+    }
+  }
+
+  printf("%d violations, %d keyframes outside the limits\n", violations, warnings);
+  return violations ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+/*
+Title: Acrobot trace export
+Description: Turns the trace dumps in a binary log into Chrome trace JSON, to
+open in chrome://tracing or ui.perfetto.dev. Build a firmware with
+-D TRACE_EVENTS (env:profile), then start a dump: the leg's down left button,
+'x' on the remote's serial.
+
+Reads a capture file or stdin until the end, or a serial device (set to raw
+mode at the given baud) until one dump is complete. Each task is a thread,
+the core an event ran on is in its args. The cores' cycle counters are tied
+to the common micros() by the clock events in the dump.
+
+Usage: traceExport [file-or-device] [baud] > trace.json
+       traceExport /dev/ttyUSB0 921600 > trace.json
+*/
+
+#include "../common/serialPort.h"
+
+#include <binaryLog.h>
+#include <traceEvents.h>
+#include <traceRing.h>
+
+#include <algorithm>
+#include <fcntl.h>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+struct Clock
+{
+  size_t position; // in the core's events
+  uint32_t cycles;
+  int64_t micros; // unwrapped
+  uint16_t mhz;
+};
+
+struct Event
+{
+  double micros;
+  uint32_t task;
+  uint16_t id;
+  uint8_t phase;
+  uint8_t core;
+};
+
+static std::vector<struct_trace_event> cores[TraceRing::CORES];
+static std::map<uint32_t, std::string> taskNames;
+
+static void addRecord(const struct_log_record &r)
+{
+  if (r.id == LOG_TRACE_TASK)
+  {
+    char name[13] = {};
+    memcpy(name, &r.values[1], 12);
+    taskNames[r.values[0]] = name;
+    return;
+  }
+
+  struct_trace_event event = {(uint32_t)r.values[0], (uint32_t)r.values[1], r.arg,
+                              (uint8_t)r.values[2], (uint8_t)(r.values[2] >> 8)};
+  if (event.core < TraceRing::CORES)
+  {
+    cores[event.core].push_back(event);
+  }
+}
+
+// every event timed from the clock event before it, or the first one after
+// it for those at the start; a cycle count is within seconds of a clock
+static void convert(uint8_t core, std::vector<Event> &out)
+{
+  const std::vector<struct_trace_event> &events = cores[core];
+  std::vector<Clock> clocks;
+  for (size_t i = 0; i < events.size(); i++)
+  {
+    if (events[i].phase != TRACE_PHASE_CLOCK)
+    {
+      continue;
+    }
+    int64_t micros = events[i].task;
+    if (!clocks.empty())
+    {
+      micros = clocks.back().micros + (int32_t)(events[i].task - (uint32_t)clocks.back().micros);
+    }
+    clocks.push_back({i, events[i].cycles, micros, events[i].id ? events[i].id : (uint16_t)240});
+  }
+  if (clocks.empty())
+  {
+    if (!events.empty())
+    {
+      fprintf(stderr, "core %u: %zu events without a clock, skipped\n", core, events.size());
+    }
+    return;
+  }
+
+  size_t next = 0;
+  for (size_t i = 0; i < events.size(); i++)
+  {
+    while (next + 1 < clocks.size() && clocks[next + 1].position <= i)
+    {
+      next++;
+    }
+    const struct_trace_event &event = events[i];
+    if (event.phase == TRACE_PHASE_CLOCK)
+    {
+      continue;
+    }
+    const Clock &clock = clocks[next];
+    double micros = clock.micros + (double)(int32_t)(event.cycles - clock.cycles) / clock.mhz;
+    out.push_back({micros, event.task, event.id, event.phase, core});
+  }
+}
+
+static const char *eventName(uint16_t id)
+{
+  return id < TRACE_ID_COUNT ? traceNames[id] : "unknown";
+}
+
+int main(int argc, char **argv)
+{
+  int fd = STDIN_FILENO;
+  if (argc > 1)
+  {
+    fd = open(argv[1], O_RDONLY | O_NOCTTY);
+    if (fd < 0)
+    {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+  setRaw(fd, argc > 2 ? atol(argv[2]) : 921600);
+  struct stat info;
+  bool device = fstat(fd, &info) == 0 && S_ISCHR(info.st_mode);
+  if (device)
+  {
+    fprintf(stderr, "waiting for a trace dump\n");
+  }
+
+  uint8_t frame[256];
+  size_t frameLen = 0;
+  bool overflow = false;
+  bool done = false;
+  unsigned long dumps = 0;
+
+  uint8_t buffer[4096];
+  ssize_t n;
+  while (!done && (n = read(fd, buffer, sizeof(buffer))) > 0)
+  {
+    for (ssize_t i = 0; i < n && !done; i++)
+    {
+      if (buffer[i] != 0)
+      {
+        if (frameLen < sizeof(frame))
+        {
+          frame[frameLen++] = buffer[i];
+        }
+        else
+        {
+          overflow = true;
+        }
+        continue;
+      }
+
+      struct_log_record r;
+      if (!overflow && frameLen && decodeLogFrame(frame, frameLen, r))
+      {
+        if (r.id == LOG_TRACE_EVENT || r.id == LOG_TRACE_TASK)
+        {
+          addRecord(r);
+        }
+        else if (r.id == LOG_TRACE_DONE)
+        {
+          dumps++;
+          done = device; // a file can hold several
+        }
+        else if (r.id == LOG_DROPPED)
+        {
+          fprintf(stderr, "the log dropped %d records, some events may be missing\n", r.values[0]);
+        }
+      }
+      frameLen = 0;
+      overflow = false;
+    }
+  }
+
+  std::vector<Event> events;
+  for (uint8_t core = 0; core < TraceRing::CORES; core++)
+  {
+    convert(core, events);
+  }
+  // a task can move between cores, its begin and end still pair up in order
+  std::stable_sort(events.begin(), events.end(),
+                   [](const Event &a, const Event &b) { return a.micros < b.micros; });
+  double start = events.empty() ? 0 : events.front().micros;
+
+  printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"acrobot\"}}");
+  for (const auto &task : taskNames)
+  {
+    const char *name = task.second.empty() ? "task" : task.second.c_str();
+    printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+           task.first, name);
+  }
+  for (const Event &event : events)
+  {
+    const char *phase = event.phase == TRACE_PHASE_BEGIN ? "B" : event.phase == TRACE_PHASE_END ? "E" : "i";
+    printf(",\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,%s\"args\":{\"core\":%u}}",
+           eventName(event.id), phase, event.micros - start, event.task,
+           event.phase == TRACE_PHASE_MARK ? "\"s\":\"t\"," : "", event.core);
+  }
+  printf("\n]}\n");
+
+  fprintf(stderr, "%zu events from %lu dumps, %zu tasks\n", events.size(), dumps, taskNames.size());
+  return 0;
+}
@@ -0,0 +1,43 @@
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <Arduino.h>
+#include <angle.h>
+#include "AS5600.h"
+#include <SparkFun_I2C_Mux_Arduino_Library.h>
+
+// A joint's AS5600, read through the I2C multiplexer on Joint::MUX_PORT.
+// Positions are Angles from the top: the raw reading plus Joint::NEUTRAL,
+// negated for a MIRRORED encoder. It is a MotorController Source.
+template <typename Joint>
+class Encoder {
+public:
+  explicit Encoder(QWIICMUX &mux) : mux(mux) {}
+
+  // after the multiplexer's begin(), returns whether the sensor answers
+  bool begin() {
+    mux.setPort(Joint::MUX_PORT);
+    sensor.begin();
+    return sensor.isConnected();
+  }
+
+  void update() {
+    mux.setPort(Joint::MUX_PORT);
+    raw = sensor.readAngle();
+  }
+
+  // of the last update()
+  uint16_t getRaw() { return raw; }
+  Angle getPosition() { return toAngle(raw); }
+
+  static Angle toAngle(uint16_t raw) {
+    return Joint::MIRRORED ? Angle::fromCounts(-(raw + Joint::NEUTRAL)) : Angle::fromCounts(raw + Joint::NEUTRAL);
+  }
+
+private:
+  QWIICMUX &mux;
+  AS5600 sensor;
+  uint16_t raw = 0;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef LEDCPWM_H
+#define LEDCPWM_H
+
+#include <Arduino.h>
+
+// A MotorController sink on the LEDC, one channel per direction of the
+// motor driver. It has no state, the channels and pins are the profile's.
+template <typename Pwm, typename Joint>
+class LedcPwm {
+public:
+  void begin() {
+    ledcSetup(Joint::FORWARD_CHANNEL, Pwm::FREQUENCY, Pwm::RESOLUTION);
+    ledcAttachPin(Joint::FORWARD_PIN, Joint::FORWARD_CHANNEL);
+
+    ledcSetup(Joint::BACKWARD_CHANNEL, Pwm::FREQUENCY, Pwm::RESOLUTION);
+    ledcAttachPin(Joint::BACKWARD_PIN, Joint::BACKWARD_CHANNEL);
+  }
+
+  // -Pwm::RANGE..Pwm::RANGE, positive = backward channel
+  void write(int16_t duty) {
+    if (duty > 0) {
+      ledcWrite(Joint::BACKWARD_CHANNEL, duty);
+      ledcWrite(Joint::FORWARD_CHANNEL, 0);
+    } else {
+      ledcWrite(Joint::FORWARD_CHANNEL, -duty);
+      ledcWrite(Joint::BACKWARD_CHANNEL, 0);
+    }
+  }
+};
+
+#endif
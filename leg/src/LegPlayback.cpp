@@ -0,0 +1,58 @@
+#include "LegPlayback.h"
+
+LegPlayback::LegPlayback() : receiver(TIMELINE_COUNTS_PER_DEGREE) {
+}
+
+void LegPlayback::init() {
+  queue = xQueueCreate(8, sizeof(struct_message));
+}
+
+void LegPlayback::receive(const uint8_t *data, int len) {
+  if (!queue || len <= 0 || len > (int)TRANSPORT_MAX_DATA_LEN) {
+    return;
+  }
+  struct_message message;
+  message.len = len;
+  memcpy(message.data, data, len);
+  xQueueSend(queue, &message, 0); // dropped when full, the remote resends
+}
+
+void LegPlayback::sync(uint32_t remoteMillis) {
+  uint32_t now = millis();
+  portENTER_CRITICAL(&clockMux);
+  clock.add(remoteMillis, now);
+  portEXIT_CRITICAL(&clockMux);
+}
+
+void LegPlayback::process() {
+  struct_message message;
+  while (queue && xQueueReceive(queue, &message, 0) == pdTRUE) {
+    // a copy, the callback goes on adding to the clock meanwhile
+    portENTER_CRITICAL(&clockMux);
+    ClockSync synced = clock;
+    portEXIT_CRITICAL(&clockMux);
+    receiver.receive(message.data, message.len, synced);
+  }
+}
+
+bool LegPlayback::update(uint32_t now, const struct_leg_targets &current,
+                         struct_leg_targets &targets) {
+  struct_timeline_state state;
+  if (!receiver.update(now, toTimelineState(current), state)) {
+    return false;
+  }
+  targets = fromTimelineState(state);
+  return true;
+}
+
+uint32_t LegPlayback::getCrc() {
+  return receiver.getCrc();
+}
+
+uint16_t LegPlayback::getNextChunk() {
+  return receiver.getNextChunk();
+}
+
+int16_t LegPlayback::getPlaying() {
+  return receiver.getPlaying();
+}
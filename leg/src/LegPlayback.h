@@ -0,0 +1,49 @@
+#ifndef LEGPLAYBACK_H
+#define LEGPLAYBACK_H
+
+#include <Arduino.h>
+#include "LegTargets.h"
+#include <clockSync.h>
+#include <protocol.h>
+#include <timelineReceiver.h>
+#include <transport.h>
+
+// Plays choreography on the leg itself. The remote uploads a timeline library
+// once, then only sends start/stop commands with a start time on its own
+// clock, so a lost packet no longer freezes the leg mid-move.
+//
+// Messages arrive on the WiFi task and are queued; process() hands them to
+// the TimelineReceiver in loop(), which is the only place the image and the
+// player are touched.
+class LegPlayback {
+public:
+  LegPlayback();
+  void init();
+
+  // from the receive callback, anything but MSG_CONTROL
+  void receive(const uint8_t *data, int len);
+  // feeds the clock with every message header, also from the callback
+  void sync(uint32_t remoteMillis);
+
+  void process();
+  // writes the targets at now, returns false if the remote's targets apply
+  bool update(uint32_t now, const struct_leg_targets &current, struct_leg_targets &targets);
+
+  uint32_t getCrc();
+  uint16_t getNextChunk();
+  int16_t getPlaying();
+
+private:
+  typedef struct struct_message {
+    uint8_t len;
+    uint8_t data[TRANSPORT_MAX_DATA_LEN];
+  } struct_message;
+
+  QueueHandle_t queue = nullptr;
+  portMUX_TYPE clockMux = portMUX_INITIALIZER_UNLOCKED;
+  ClockSync clock;
+
+  TimelineReceiver receiver;
+};
+
+#endif
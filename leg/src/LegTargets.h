@@ -0,0 +1,28 @@
+#ifndef LEGTARGETS_H
+#define LEGTARGETS_H
+
+#include <angle.h>
+#include <math.h>
+#include <timeline.h>
+
+// What a timeline sets on the leg: the setpoints, as the PID takes them, and
+// the gain. The leg's players scale the keyframes into encoder counts, so
+// their state only rounds to an Angle here, with no degrees in between.
+const float TIMELINE_COUNTS_PER_DEGREE = Angle::COUNTS / 360.f;
+
+typedef struct struct_leg_targets {
+  Angle rTarget;
+  Angle lTarget;
+  float kP;
+} struct_leg_targets;
+
+inline struct_timeline_state toTimelineState(const struct_leg_targets &targets) {
+  return {(float)targets.rTarget.getCounts(), (float)targets.lTarget.getCounts(), targets.kP};
+}
+
+inline struct_leg_targets fromTimelineState(const struct_timeline_state &state) {
+  return {Angle::fromCounts(lroundf(state.rTarget)), Angle::fromCounts(lroundf(state.lTarget)),
+          state.kP};
+}
+
+#endif
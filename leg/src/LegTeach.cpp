@@ -0,0 +1,104 @@
+#include "LegTeach.h"
+
+LegTeach::LegTeach(uint16_t rNeutral, uint16_t lNeutral)
+    : recorder(buffer, CAPACITY), taught{{"taught", keyframes, 0, 0, -1}}, library(taught, 1),
+      player(library, TIMELINE_COUNTS_PER_DEGREE) {
+  // as updatePositions(), the left leg is mirrored
+  const float degreesPerCount = 360. / TEACH_COUNTS;
+  joints[0] = {rNeutral * degreesPerCount, degreesPerCount};
+  joints[1] = {-lNeutral * degreesPerCount, -degreesPerCount};
+}
+
+void LegTeach::updateControls(bool teachSwitch, bool playButton, bool stopButton) {
+  if (teachSwitch && (mode == IDLE || mode == PLAYING)) {
+    player.stop();
+    mode = ARMED; // starts with the next sample
+  }
+  if (!teachSwitch && (mode == ARMED || mode == TEACHING)) {
+    finish();
+  }
+
+  if (playButton && !lastPlayButton && mode == IDLE && taught[0].count) {
+    starting = true;
+    mode = PLAYING;
+  }
+  if (stopButton && !lastStopButton && mode == PLAYING) {
+    player.stop();
+    mode = IDLE;
+  }
+  lastPlayButton = playButton;
+  lastStopButton = stopButton;
+}
+
+void LegTeach::sample(uint32_t now, uint16_t rRaw, uint16_t lRaw) {
+  if (mode == ARMED) {
+    recorder.begin(now, rRaw, lRaw);
+    mode = TEACHING;
+  } else if (mode == TEACHING) {
+    recorder.add(now, rRaw, lRaw); // a full recording ends there, still limp
+  }
+}
+
+void LegTeach::finish() {
+  bool sampled = mode == TEACHING;
+  mode = IDLE;
+  if (!sampled) {
+    return; // switched off again before the next PID compute
+  }
+  recorder.end();
+
+  uint16_t count = 0;
+  for (tolerance = TOLERANCE; !count && tolerance <= MAX_TOLERANCE; tolerance *= 2) {
+    count = recorder.extract(joints, tolerance, KP, keyframes, MAX_KEYFRAMES);
+  }
+  tolerance /= 2;
+
+  // eases from wherever the legs are when it plays
+  for (uint16_t i = 0; i < count; i++) {
+    keyframes[i].time += APPROACH;
+  }
+  if (count) {
+    keyframes[0].interpolation = INTERP_EASE;
+  }
+  taught[0].count = count;
+  logged = 0;
+}
+
+bool LegTeach::update(uint32_t now, const struct_leg_targets &current,
+                      struct_leg_targets &targets) {
+  if (mode == ARMED || mode == TEACHING) {
+    targets = current;
+    targets.kP = 0; // limp, as relax
+    return true;
+  }
+  if (mode != PLAYING) {
+    return false;
+  }
+
+  if (starting) {
+    player.start(0, now, toTimelineState(current));
+    starting = false;
+  }
+  struct_timeline_state state;
+  if (player.update(now, state)) {
+    targets = fromTimelineState(state);
+  } else {
+    targets = current;
+  }
+  return true;
+}
+
+void LegTeach::log(BinaryLog &log) {
+  if (logged < 0) {
+    return;
+  }
+  if (logged == 0) {
+    log.log(LOG_LEG_TEACH, taught[0].count, recorder.getSamples(), recorder.getSize(),
+            recorder.getDuration(), taught[0].count ? tolerance * 100 : 0);
+  } else {
+    const struct_keyframe &keyframe = keyframes[logged - 1];
+    log.log(LOG_LEG_TEACH_KEYFRAME, logged - 1, keyframe.time, keyframe.rTarget, keyframe.lTarget,
+            keyframe.kP);
+  }
+  logged = logged < taught[0].count ? logged + 1 : -1;
+}
@@ -0,0 +1,56 @@
+#ifndef LEGTEACH_H
+#define LEGTEACH_H
+
+#include <Arduino.h>
+#include "LegTargets.h"
+#include <binaryLog.h>
+#include <teachRecorder.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+// Teaching a move by demonstration. While the yellow switch is on the legs go
+// limp, as in relax, and both encoders are recorded at control rate as they
+// are moved by hand. Switching it off turns the recording into keyframes,
+// which go out in the binary log (see host/logDecode) and play here with the
+// up right button, at a gain that holds the legs; down right stops them.
+class LegTeach {
+public:
+  static const size_t CAPACITY = 48 * 1024; // half a minute of demonstration, usually more
+  static const uint16_t MAX_KEYFRAMES = 256;
+  static const uint16_t KP = 150;        // hundredths
+  static const uint16_t APPROACH = 1000; // ms from wherever the legs are to the first keyframe
+  static constexpr float TOLERANCE = 1;  // degrees, doubled until the keyframes fit
+  static constexpr float MAX_TOLERANCE = 8;
+
+  LegTeach(uint16_t rNeutral, uint16_t lNeutral);
+
+  void updateControls(bool teachSwitch, bool playButton, bool stopButton);
+  // after every PID compute
+  void sample(uint32_t now, uint16_t rRaw, uint16_t lRaw);
+  // like LegPlayback::update, false if neither teaching nor playing
+  bool update(uint32_t now, const struct_leg_targets &current, struct_leg_targets &targets);
+  // the taught move, a keyframe per call so the log ring keeps up
+  void log(BinaryLog &log);
+
+private:
+  enum Mode { IDLE, ARMED, TEACHING, PLAYING };
+
+  struct_teach_joint joints[2];
+  uint8_t buffer[CAPACITY];
+  TeachRecorder recorder;
+  Mode mode = IDLE;
+  bool lastPlayButton = false;
+  bool lastStopButton = false;
+
+  struct_keyframe keyframes[MAX_KEYFRAMES];
+  struct_timeline taught[1];
+  TimelineLibrary library;
+  TimelinePlayer player;
+  bool starting = false;
+  float tolerance = 0;
+  int32_t logged = -1; // -1 = nothing to log, 0 = the summary next
+
+  void finish();
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef MCPWMPWM_H
+#define MCPWMPWM_H
+
+#include <Arduino.h>
+#include <driver/mcpwm.h>
+
+// A MotorController sink on the MCPWM, the ESP32's motor control PWM: a
+// timer of unit 0 per joint, Joint::MCPWM_TIMER, with the forward pin on
+// its A output and the backward pin on B. Both outputs share the timer, so
+// they can not drift apart as two LEDC channels may. Build with
+// -D MCPWM_DRIVE (env:mcpwm) to drive the legs with it instead of LedcPwm.
+template <typename Pwm, typename Joint>
+class McpwmPwm {
+public:
+  void begin() {
+    mcpwm_gpio_init(MCPWM_UNIT_0, signal(false), Joint::FORWARD_PIN);
+    mcpwm_gpio_init(MCPWM_UNIT_0, signal(true), Joint::BACKWARD_PIN);
+
+    mcpwm_config_t config = {};
+    config.frequency = Pwm::FREQUENCY;
+    config.cmpr_a = 0;
+    config.cmpr_b = 0;
+    config.counter_mode = MCPWM_UP_COUNTER;
+    config.duty_mode = MCPWM_DUTY_MODE_0;
+    mcpwm_init(MCPWM_UNIT_0, TIMER, &config);
+  }
+
+  // -Pwm::RANGE..Pwm::RANGE, positive = backward channel
+  void write(int16_t duty) {
+    // the driver takes percent
+    if (duty > 0) {
+      mcpwm_set_duty(MCPWM_UNIT_0, TIMER, MCPWM_OPR_B, duty * (100.f / Pwm::RANGE));
+      mcpwm_set_duty(MCPWM_UNIT_0, TIMER, MCPWM_OPR_A, 0);
+    } else {
+      mcpwm_set_duty(MCPWM_UNIT_0, TIMER, MCPWM_OPR_A, -duty * (100.f / Pwm::RANGE));
+      mcpwm_set_duty(MCPWM_UNIT_0, TIMER, MCPWM_OPR_B, 0);
+    }
+  }
+
+private:
+  static constexpr mcpwm_timer_t TIMER = (mcpwm_timer_t)Joint::MCPWM_TIMER;
+
+  // MCPWM0A, MCPWM0B, MCPWM1A, ... in order
+  static mcpwm_io_signals_t signal(bool backward) {
+    return (mcpwm_io_signals_t)(MCPWM0A + Joint::MCPWM_TIMER * 2 + backward);
+  }
+};
+
+#endif
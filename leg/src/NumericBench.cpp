@@ -0,0 +1,96 @@
+#include "NumericBench.h"
+
+#ifdef NUMERIC_BENCH
+#include <PID_v1.h> // https://github.com/br3ttb/, only for the comparison
+#include <floatPid.h>
+#include <intPid.h>
+#include <loopProfiler.h>
+#include "Encoder.h"
+#include <robotProfile.h>
+
+static const uint16_t TICKS = 2000; // ms
+typedef Robot::RightLeg RLeg;
+typedef Robot::LeftLeg LLeg;
+static const int16_t RANGE = Robot::Pwm::RANGE;
+static const uint8_t DEADBAND = RLeg::DEADBAND;
+
+// the results go here, so the compiler can not drop the work
+static volatile long sink;
+
+void runNumericBench(Print &out) {
+  double dSetpoint[2] = {170, 190}, dInput[2] = {0, 0}, dOutput[2] = {0, 0};
+  float fSetpoint[2] = {170, 190}, fInput[2] = {0, 0}, fOutput[2] = {0, 0};
+  PID dPID[2] = {PID(&dInput[0], &dOutput[0], &dSetpoint[0], 1, 0, 0, DIRECT),
+                 PID(&dInput[1], &dOutput[1], &dSetpoint[1], 1, 0, 0, DIRECT)};
+  FloatPid fPID[2] = {FloatPid(&fInput[0], &fOutput[0], &fSetpoint[0], 1, 0, 0),
+                      FloatPid(&fInput[1], &fOutput[1], &fSetpoint[1], 1, 0, 0)};
+  Angle iSetpoint[2] = {Angle::fromWholeDegrees(170), Angle::fromWholeDegrees(190)}, iInput[2];
+  IntPid iPID[2] = {IntPid(RANGE, 1), IntPid(RANGE, 1)};
+  for (uint8_t i = 0; i < 2; i++) {
+    dPID[i].SetMode(AUTOMATIC);
+    dPID[i].SetOutputLimits(-RANGE, RANGE);
+    dPID[i].SetSampleTime(1);
+    fPID[i].start();
+    fPID[i].setOutputLimits(-RANGE, RANGE);
+    fPID[i].setSampleTime(1);
+    iPID[i].start(iInput[i]);
+  }
+
+  uint64_t doubleCycles = 0, floatCycles = 0, intCycles = 0;
+  uint16_t doubleSamples = 0, floatSamples = 0, intSamples = 0;
+  for (uint16_t tick = 0; tick < TICKS; tick++) {
+    uint16_t raw = (tick * 37) % 4096; // encoder readings all round
+    uint32_t ms = millis();
+    while (millis() == ms) {
+    }
+
+    uint32_t start = profileCycles();
+    dInput[0] = fmod(((raw + RLeg::NEUTRAL) / 4096.) * 360, 360);
+    dInput[1] = 360 - fmod(((raw + LLeg::NEUTRAL) / 4096.) * 360, 360);
+    for (uint8_t i = 0; i < 2; i++) {
+      dPID[i].SetTunings(1.4, 0.2, 0.01);
+      doubleSamples += dPID[i].Compute();
+      sink = dOutput[i] > 1 ? map(dOutput[i], 0, RANGE, DEADBAND, RANGE) : 0;
+    }
+    doubleCycles += profileCycles() - start;
+
+    start = profileCycles();
+    fInput[0] = ((raw + RLeg::NEUTRAL) % 4096) * (360.f / 4096);
+    fInput[1] = 360 - ((raw + LLeg::NEUTRAL) % 4096) * (360.f / 4096);
+    for (uint8_t i = 0; i < 2; i++) {
+      fPID[i].setTunings(1.4f, 0.2f, 0.01f);
+      floatSamples += fPID[i].compute(millis());
+      sink = fOutput[i] > 1 ? map(fOutput[i], 0, RANGE, DEADBAND, RANGE) : 0;
+    }
+    floatCycles += profileCycles() - start;
+
+    start = profileCycles();
+    iInput[0] = Encoder<RLeg>::toAngle(raw);
+    iInput[1] = Encoder<LLeg>::toAngle(raw);
+    for (uint8_t i = 0; i < 2; i++) {
+      iPID[i].setTunings(1.4f, 0.2f, 0.01f);
+      intSamples += iPID[i].compute(iSetpoint[i], iInput[i], millis());
+      int32_t output = iPID[i].getOutput();
+      sink = output > IntPid::ONE ? map(IntPid::toPwm(output), 0, RANGE, DEADBAND, RANGE) : 0;
+    }
+    intCycles += profileCycles() - start;
+  }
+
+  out.println("numeric bench, cycles per control tick (both joints)");
+  out.print("double + PID_v1: ");
+  out.print((uint32_t)(doubleCycles / TICKS));
+  out.print(", ");
+  out.print(doubleSamples);
+  out.println(" samples");
+  out.print("float + FloatPid: ");
+  out.print((uint32_t)(floatCycles / TICKS));
+  out.print(", ");
+  out.print(floatSamples);
+  out.println(" samples");
+  out.print("Angle + IntPid: ");
+  out.print((uint32_t)(intCycles / TICKS));
+  out.print(", ");
+  out.print(intSamples);
+  out.println(" samples");
+}
+#endif
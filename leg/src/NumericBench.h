@@ -0,0 +1,16 @@
+#ifndef NUMERICBENCH_H
+#define NUMERICBENCH_H
+
+#include <Arduino.h>
+
+// Cycles per control tick of the arithmetic updatePositions(), updatePID()
+// and controlMotorPID() do: in double with PID_v1 as the leg started out, in
+// float with FloatPid, and in Angle counts with IntPid as it does now. Build
+// env:bench; it runs once at the end of setup() and prints to out.
+//
+// All three run a sample every millisecond, as the control job does, over
+// the same sweep of encoder readings. Their equivalence is checked on the
+// host, by host/numericCheck.
+void runNumericBench(Print &out);
+
+#endif
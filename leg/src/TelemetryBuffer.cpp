@@ -0,0 +1,26 @@
+#include "TelemetryBuffer.h"
+
+void TelemetryBuffer::record(const struct_telemetry_sample &sample) {
+  if (getPending() == CAPACITY) {
+    tail++;
+    dropped++;
+  }
+  samples[head % CAPACITY] = sample;
+  head++;
+}
+
+size_t TelemetryBuffer::pack(uint8_t *frame, size_t capacity) {
+  encoder.begin(frame, capacity, sequence++);
+  while (tail != head && encoder.add(samples[tail % CAPACITY])) {
+    tail++;
+  }
+  return encoder.getSize();
+}
+
+uint16_t TelemetryBuffer::getPending() {
+  return head - tail;
+}
+
+uint32_t TelemetryBuffer::getDropped() {
+  return dropped;
+}
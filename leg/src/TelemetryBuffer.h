@@ -0,0 +1,28 @@
+#ifndef TELEMETRYBUFFER_H
+#define TELEMETRYBUFFER_H
+
+#include <Arduino.h>
+#include <telemetryFrame.h>
+
+// Ring of per-tick samples, filled by the control loop and drained into
+// outgoing frames. Oldest samples are dropped when the radio falls behind.
+class TelemetryBuffer {
+public:
+  static const uint16_t CAPACITY = 128; // power of two
+
+  void record(const struct_telemetry_sample &sample);
+  // packs as many buffered samples as fit, returns the frame size
+  size_t pack(uint8_t *frame, size_t capacity);
+
+  uint16_t getPending();
+  uint32_t getDropped();
+
+private:
+  struct_telemetry_sample samples[CAPACITY];
+  uint16_t head = 0, tail = 0;
+  uint16_t sequence = 0;
+  uint32_t dropped = 0;
+  TelemetryEncoder encoder;
+};
+
+#endif
@@ -10,34 +10,38 @@ Status light: Blue = connected wireless, Red = disconnected wireless
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <esp_now.h>
+#include <espNowTransport.h>
+#include <protocol.h>
 #include "AS5600.h"
 #include "Wire.h"
-#include <PID_v1.h> // https://github.com/br3ttb/
 #include <RunningMedian.h>
 #include <SparkFun_I2C_Mux_Arduino_Library.h>
 #include <LiquidCrystal_I2C.h>
 #include "PCF8574.h"
-
-#define R_F_PWM_PIN  16  
-#define R_B_PWM_PIN  17   
-#define L_F_PWM_PIN  19  
-#define L_B_PWM_PIN  18 
-#define BATTERY_V_PIN 32
-
-#define BUZZER_PIN 26
-#define IR_PIN 27
-#define LED_R_PIN 14
-#define LED_G_PIN 12
-#define LED_B_PIN 13
-
-#define BOOT_SW_PIN 23
-
-#define ENCODER_L_PWM 15
+#include "TelemetryBuffer.h"
+#include "LegPlayback.h"
+#include "LegTeach.h"
+#include "NumericBench.h"
+#include <robotProfile.h>
+#include "Encoder.h"
+#include "LedcPwm.h"
+#include "McpwmPwm.h"
+#include <motorController.h>
+#include <binaryLog.h>
+#include <intPid.h>
+#include <heapMonitor.h>
+#include <loopProfiler.h>
+#include <profileZones.h>
+#include <loadGovernor.h>
+#include <scheduler.h>
+#include <traceRing.h>
+
+// pins, channels and calibration are the robot's, see robotProfile.h
+typedef Robot::Pwm Pwm;
+typedef Robot::RightLeg RLeg;
+typedef Robot::LeftLeg LLeg;
 
 // TODO:
-// Create encoder class & files
-// Remove old encoder & motorcontrollers from main
 // Import and combine component classes from the 'remote' project
 // Finish up, test everything :)
 
@@ -50,15 +54,14 @@ Status light: Blue = connected wireless, Red = disconnected wireless
 
 int8_t batteryPercent;
 RunningMedian batterySamples = RunningMedian(64); 
-uint32_t batteryAlarmTimer = 0;
 
 void updateBattery();
 
 // BUZZER
-uint32_t buzzerTimer = 0;
+uint8_t buzzerJob; // one-shot, turns it off
 
 void setBuzzer(uint16_t time=100);
-void updateBuzzer();
+void buzzerOff(void *);
 
 // DATA espnow
 
@@ -66,84 +69,30 @@ uint32_t lastReceiveTime = 0;
 
 uint8_t remoteAddress[] = {0x34, 0x94, 0x54, 0xBE, 0xDB, 0x6C};
 
-uint32_t dataTimer = 0;
-
 bool connectionStatus = false;
 
-// data out:
-typedef struct struct_data_out {
-
-  double rP;
-  double rI;
-  double rD;
-
-  double rInput;
-  double lInput;
-
-} struct_data_out;
-
-struct_data_out dataOut;
-
-// data in:
-
-typedef struct struct_data_in {
-  int16_t joystickLX;
-  int16_t joystickLY;
-  int16_t joystickRX;
-  int16_t joystickRY;
-
-  int16_t sliderLL;
-  int16_t sliderLA;
-  int16_t sliderRL;
-  int16_t sliderRA;
-
-  int16_t encoderPos;
-  bool encoderSwDown;
-
-  char key;
-
-  int8_t batteryPercent;
+// packet layouts live in shared/Protocol
+struct_leg_data dataOut;
+struct_remote_data dataIn;
 
-  double rP;
-  double rI;
-  double rD;
-
-  double lP;
-  double lI;
-  double lD;
-
-  uint16_t rTargetPositionDegrees;
-  uint16_t lTargetPositionDegrees;
-
-} struct_data_in;
-
-struct_data_in dataIn;
-
-esp_now_peer_info_t peerInfo;
+EspNowTransport transport;
 
 void resetReceiveTimeout();
 void checkReceiveTimeout();
 void sendData();
-void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status);
+void OnDataSent(const uint8_t *mac_addr, bool delivered);
 void OnDataRecv(const uint8_t * mac, const uint8_t *incomingData, int len);
 
-String success; // TODO: remove this
-
 // ENCODERS
 
-AS5600 rAs5600; // encoder
-AS5600 lAs5600; // encoder
-
 void captureLPWM();
 
 volatile uint32_t lPWMduration = 0;
 
 uint16_t positionRLegRaw;
 uint16_t positionLLegRaw;
-double positionRLegDegrees;
-double positionLLegDegrees;
-const uint16_t NEUTRAL_R_LEG = 3107; // 4096 - position at very top, raw
-const uint16_t NEUTRAL_L_LEG = 4004; // 4096 - position at very top, raw
+Angle positionRLeg;
+Angle positionLLeg;
 
 void updatePositions();
 
@@ -164,15 +113,14 @@ bool yellowSwitch;
 // I2C MULTIPLEXER
 
 QWIICMUX myMux;
+Encoder<RLeg> rEncoder(myMux);
+Encoder<LLeg> lEncoder(myMux);
 
 void muxInit();
-uint16_t getRAngleThroughMux();
-uint16_t getLAngleThroughMux();
 
 // LCD
 
 LiquidCrystal_I2C lcd(0x27, 20, 4);
-uint32_t lcdTimer = 0;
 
 void lcdInit();
 void setLCD();
@@ -203,30 +151,104 @@ void updateLED();
 uint16_t rTargetPositionDegrees = 180;
 uint16_t lTargetPositionDegrees = 180;
 
-const uint8_t RDEADBAND = 44;
-const uint8_t LDEADBAND = 46;
-
-double rSetpoint, rInput, rOutput; //used by PID lib
-double lSetpoint, lInput, lOutput;
+// angles in counts and outputs in fixed point, see IntPid; degrees only for
+// the LCD, the remote and the logs
+Angle rSetpoint, rInput;
+Angle lSetpoint, lInput;
 //setpoint= nb Rotation of the motor shaft,
 //input = current rotation,
 //output is pwmSpeed of the motor
 
-//Specify the links and initial tuning parameters
-double rP = 1., rI = 0, rD = 0.; 
-double lP = 1., lI = 0, lD = 0.; 
+//Specify the initial tuning parameters, per degree as the remote sends them
+float rP = 1., rI = 0, rD = 0.; 
+float lP = 1., lI = 0, lD = 0.; 
 
-PID rPID(&rInput, &rOutput, &rSetpoint, rP, rI, rD, DIRECT); 
-PID lPID(&lInput, &lOutput, &lSetpoint, lP, lI, lD, DIRECT); 
+// each joint's IntPid runs in its MotorController, see MOTORS
 
 void pidInit();
 void controlMotorPID();
 void updatePID();
 
+// PLAYBACK
+
+LegPlayback playback; // timelines uploaded by the remote, played here
+
+// TEACH
+
+// yellow switch: limp and record a move by hand, up right plays it, down right stops
+LegTeach teach(RLeg::NEUTRAL, LLeg::NEUTRAL);
+
 // PRINT
 
-uint32_t printTimer = 0;
+const uint32_t SERIAL_BAUD = 921600;
+BinaryLog binaryLog;
+
 void printAll();
+void dumpAll();
+
+// PROFILER
+
+// cycle counts of every stage of loop(), build with -D LOOP_PROFILER
+#ifdef LOOP_PROFILER
+LoopProfiler loopProfiler(legZoneNames, LEG_ZONE_COUNT);
+#endif
+// and -D TRACE_EVENTS, the down left button dumps the trace ring to the log
+
+// HEAP
+
+// -D HEAP_MONITOR (env:debug) counts the allocations of every task; loop()
+// may not make any once the steady job has run, and the report job logs the
+// counts, the free heap and every task's stack high-water mark
+#ifdef HEAP_MONITOR
+const uint32_t HEAP_STEADY_DELAY = 2000000; // us, the scheduler's timer and WiFi are up by then
+const uint32_t HEAP_REPORT_INTERVAL = 5000000;
+
+void heapSteadyJob(void *);
+void heapReportJob(void *);
+#endif
+
+// SCHEDULER
+
+// everything in loop() is a job, see setup() for the periods; misses and
+// overruns go to the binary log
+Scheduler scheduler;
+const uint32_t CONTROL_PERIOD = 1000; // us, the PID's sample time
+uint8_t controlJobId, printJobId, lcdJobId, batteryJobId;
+
+void controlJob(void *);
+void sendJob(void *);
+void buttonsJob(void *);
+void batteryJob(void *);
+void printJob(void *);
+void dumpJob(void *);
+void lcdJob(void *);
+void reportJob(uint8_t job, const struct_job_stats &stats);
+
+// LOAD SHEDDING
+
+// what gives way, a level at a time, when the control job runs short of time
+typedef struct struct_shed_level {
+  uint32_t printPeriod; // us
+  uint32_t lcdPeriod;
+  uint32_t batteryPeriod;
+  uint8_t telemetryDecimation; // a sample every nth PID compute
+} struct_shed_level;
+
+const struct_shed_level SHED_LEVELS[] = {
+  {300000, 50000, 10000, 1},
+  {1000000, 50000, 10000, 1},    // debug prints
+  {1000000, 250000, 10000, 1},   // lcd refresh
+  {1000000, 250000, 100000, 1},  // battery sampling
+  {1000000, 250000, 100000, 2},  // telemetry
+  {2000000, 1000000, 100000, 4}, // all of it, further
+};
+const uint8_t SHED_LEVEL_COUNT = sizeof(SHED_LEVELS) / sizeof(SHED_LEVELS[0]);
+
+LoadGovernor governor(CONTROL_PERIOD, SHED_LEVEL_COUNT - 1);
+uint8_t telemetryDecimation = 1;
+uint8_t telemetrySkipped = 0;
+
+void shedLoad();
 
 // PROCESS DATA
 
@@ -243,16 +265,19 @@ void processJoystick();
 void zeroJoystick();
 
 
-// PWM
+// MOTORS
 
-const uint8_t R_F_PWM_CHAN = 0;
-const uint8_t R_B_PWM_CHAN = 1;
-const uint8_t L_F_PWM_CHAN = 2;
-const uint8_t L_B_PWM_CHAN = 3;
-const uint16_t PWM_FREQ = 24000; // TODO can be experimented with. https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/peripherals/ledc.html?highlight=pwm#supported-range-of-frequency-and-duty-resolutions
-const uint8_t PWM_RES = 8; // will receive error on serial if set too high.
-const uint16_t PWM_RANGE = pow(2, PWM_RES) -1;
-// const uint16_t PWM_RANGE = 128;
+// a joint's PID, from its encoder to its PWM; updatePID() and
+// controlMotorPID() run the two halves, so they are profiled apart
+#ifdef MCPWM_DRIVE
+typedef McpwmPwm<Pwm, RLeg> RPwm;
+typedef McpwmPwm<Pwm, LLeg> LPwm;
+#else
+typedef LedcPwm<Pwm, RLeg> RPwm;
+typedef LedcPwm<Pwm, LLeg> LPwm;
+#endif
+MotorController<Robot, RLeg, RPwm, Encoder<RLeg>> rMotor(rEncoder);
+MotorController<Robot, LLeg, LPwm, Encoder<LLeg>> lMotor(lEncoder);
 
 void pwmInit();
 
@@ -266,6 +291,21 @@ void joystickOrButtonsControlLegs();
 void sliderPWMtest();
 
 
+// TELEMETRY
+
+TelemetryBuffer telemetry;
+uint8_t telemetryFrame[TRANSPORT_MAX_DATA_LEN];
+
+uint32_t loopStartMicros = 0;
+uint16_t loopMicros = 0;
+bool pidComputed = false;
+uint32_t lastSampleMicros = 0;
+Angle lastRInput, lastLInput;
+
+void updateLoopTime();
+void recordTelemetry();
+int16_t degreesPerSecond(Angle from, Angle to, uint32_t dtMicros);
+
 // END FORWARD DECLARATIONS
 // **********************************
 
@@ -273,40 +313,62 @@ void sliderPWMtest();
 
 
 void setup() {
-  pinMode(BOOT_SW_PIN, INPUT_PULLUP);
-  pinMode(L_F_PWM_PIN, OUTPUT);
-  digitalWrite(L_F_PWM_PIN, LOW);
+  pinMode(Robot::BOOT_SW_PIN, INPUT_PULLUP);
+  pinMode(LLeg::FORWARD_PIN, OUTPUT);
+  digitalWrite(LLeg::FORWARD_PIN, LOW);
 
 
-  Serial.begin(115200);
+  Serial.begin(SERIAL_BAUD);
   WiFi.mode(WIFI_MODE_STA);
   Serial.println(WiFi.macAddress());
 
-  WiFi.mode(WIFI_STA);
-  if (esp_now_init() != ESP_OK) {
+  playback.init();
+  dataOut.profile.zone = PROFILE_NONE;
+
+  if (!transport.begin()) {
     Serial.println("Error initializing ESP-NOW");
     return;
   }
 
   // data sent&receive callback
-  esp_now_register_send_cb(OnDataSent);
-  esp_now_register_recv_cb(OnDataRecv);
+  transport.onSent(OnDataSent);
+  transport.onReceive(OnDataRecv);
 
   // register peer
-  memcpy(peerInfo.peer_addr, remoteAddress, 6);
-  peerInfo.channel = 0;  
-  peerInfo.encrypt = false;
-  if (esp_now_add_peer(&peerInfo) != ESP_OK){
+  if (!transport.addPeer(remoteAddress)){
     Serial.println("Failed to add peer");
     return;
   }
 
   pwmInit();
   pidInit();
+#ifdef NUMERIC_BENCH
+  runNumericBench(Serial);
+#endif
   muxInit();
   lcdInit();
   expanderInit();
 
+  binaryLog.startTask(Serial);
+
+  // name, function, context, priority, period, deadline, budget (us)
+  // the periods that can be shed are those of SHED_LEVELS[0]
+  const struct_shed_level &shed = SHED_LEVELS[0];
+  controlJobId = scheduler.add({"control", controlJob, nullptr, 3, CONTROL_PERIOD, 500, 800});
+  scheduler.add({"send", sendJob, nullptr, 2, 5000, 0, 300});
+  scheduler.add({"buttons", buttonsJob, nullptr, 1, 10000, 0, 500});
+  batteryJobId = scheduler.add({"battery", batteryJob, nullptr, 1, shed.batteryPeriod, 0, 200});
+  printJobId = scheduler.add({"print", printJob, nullptr, 1, shed.printPeriod, 0, 500});
+  scheduler.add({"dump", dumpJob, nullptr, 0, 10000, 0, 500});
+  lcdJobId = scheduler.add({"lcd", lcdJob, nullptr, 0, shed.lcdPeriod, 0, 5000});
+  buzzerJob = scheduler.add({"buzzer", buzzerOff, nullptr, 2, 0, 0, 50});
+  scheduler.onReport(reportJob);
+
+#ifdef HEAP_MONITOR
+  heapMonitor.watch();
+  scheduler.start(scheduler.add({"heapSteady", heapSteadyJob, nullptr, 0, 0, 0, 0}), HEAP_STEADY_DELAY);
+  scheduler.add({"heap", heapReportJob, nullptr, 0, HEAP_REPORT_INTERVAL, 0, 2000});
+#endif
 }
 
 //**********************************
@@ -314,26 +376,87 @@ void setup() {
 
 
 void loop() {
+  scheduler.run();
+}
+
+// every millisecond, on the PID's sample time
+void controlJob(void *) {
+  PROFILE_TICK(loopProfiler, LEG_ZONE_LOOP);
+  updateLoopTime();
   checkReceiveTimeout();
-  updateLED();
-  updatePositions();
-  updateButtons();
-  updateLCD();
-  updateBattery();
-  updatePID();
+  PROFILE(loopProfiler, LEG_ZONE_POSITIONS, updatePositions());
+  PROFILE(loopProfiler, LEG_ZONE_PLAYBACK, playback.process());
+  PROFILE(loopProfiler, LEG_ZONE_PID, updatePID());
 
-  dataOut.rInput = rInput;
-  dataOut.lInput = lInput;
+  dataOut.timelineCrc = playback.getCrc();
+  dataOut.uploadNextChunk = playback.getNextChunk();
+  dataOut.playingTimeline = playback.getPlaying();
 
-  controlMotorPID();
+  PROFILE(loopProfiler, LEG_ZONE_MOTORS, controlMotorPID());
+  if (pidComputed){
+    PROFILE(loopProfiler, LEG_ZONE_TEACH, teach.sample(millis(), positionRLegRaw, positionLLegRaw));
+  }
+  PROFILE(loopProfiler, LEG_ZONE_TELEMETRY, recordTelemetry());
   // sliderPWMtest();
+  // joystickOrButtonsControlLegs();
 
-  sendData();
+  if (governor.update(schedulerMicros(), scheduler.getSlack(controlJobId))){
+    shedLoad();
+  }
+}
 
-  // joystickOrButtonsControlLegs();
+void sendJob(void *) {
+  dataOut.rInput = rInput.toDegrees();
+  dataOut.lInput = lInput.toDegrees();
+  PROFILE(loopProfiler, LEG_ZONE_SEND, sendData());
+}
 
-  printAll();
+void buttonsJob(void *) {
+  PROFILE(loopProfiler, LEG_ZONE_LED, updateLED());
+  PROFILE(loopProfiler, LEG_ZONE_BUTTONS, updateButtons());
+  teach.updateControls(yellowSwitch, buttonUpR, buttonDownR);
+}
 
+void batteryJob(void *) {
+  PROFILE(loopProfiler, LEG_ZONE_BATTERY, updateBattery());
+}
+
+void printJob(void *) {
+  PROFILE(loopProfiler, LEG_ZONE_PRINT, printAll());
+}
+
+void dumpJob(void *) {
+  PROFILE(loopProfiler, LEG_ZONE_PRINT, dumpAll());
+}
+
+void lcdJob(void *) {
+  PROFILE(loopProfiler, LEG_ZONE_LCD, updateLCD());
+}
+
+void reportJob(uint8_t job, const struct_job_stats &stats) {
+  binaryLog.log(LOG_LEG_JOB, job, stats.misses, stats.overruns, stats.maxRun, stats.maxLate);
+}
+
+#ifdef HEAP_MONITOR
+void heapSteadyJob(void *) {
+  heapMonitor.steady();
+}
+
+void heapReportJob(void *) {
+  heapMonitor.report(binaryLog);
+}
+#endif
+
+void shedLoad() {
+  uint8_t level = governor.getLevel();
+  const struct_shed_level &shed = SHED_LEVELS[level];
+  scheduler.setPeriod(printJobId, shed.printPeriod);
+  scheduler.setPeriod(lcdJobId, shed.lcdPeriod);
+  scheduler.setPeriod(batteryJobId, shed.batteryPeriod);
+  telemetryDecimation = shed.telemetryDecimation;
+
+  dataOut.loadLevel = level;
+  binaryLog.log(LOG_LEG_LOAD, level, governor.getMinSlack(), governor.getLostTicks());
 }
 
 
@@ -345,7 +468,7 @@ void loop() {
 // MARK: - Battery
 
 void updateBattery(){
-  batterySamples.add(analogRead(BATTERY_V_PIN));
+  batterySamples.add(analogRead(Robot::BATTERY_V_PIN));
 
   batteryPercent = map(batterySamples.getAverage(), 2060, 2370, 0, 100); // 2060 =~ 3.65v, 2370 =~ 4.2v
   // TODO: Update for LIPO battery robot!!!
@@ -358,9 +481,9 @@ void updateBattery(){
 
   // low battery alarm, turn on again when updated for Robin
 
-  // if (batteryPercent < 10 && batteryAlarmTimer < millis()){
+  // in a job of its own every 600 ms, as the remote's:
+  // if (batteryPercent < 10){
   //   setBuzzer(300);
-  //   batteryAlarmTimer = millis() + 600;
   // }
 }
 
@@ -368,14 +491,12 @@ void updateBattery(){
 // MARK: - Buzzer
 
 void setBuzzer(uint16_t time){
-  buzzerTimer = millis() + time;
+  digitalWrite(Robot::BUZZER_PIN, HIGH);
+  scheduler.start(buzzerJob, time * 1000);
 }
-void updateBuzzer(){
-  if (buzzerTimer > millis()){
-    digitalWrite(BUZZER_PIN, HIGH);
-  } else {
-    digitalWrite(BUZZER_PIN, LOW);
-  }
+
+void buzzerOff(void *){
+  digitalWrite(Robot::BUZZER_PIN, LOW);
 }
 
 
@@ -396,14 +517,12 @@ void checkReceiveTimeout(){
 }
 
 // Callback when data is sent
-void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
+void OnDataSent(const uint8_t *mac_addr, bool delivered) {
+  TRACE_SCOPE(TRACE_RADIO_SENT);
   // Serial.print("\r\nLast Packet Send Status:\t");
-  // Serial.println(status == ESP_NOW_SEND_SUCCESS ? "Delivery Success" : "Delivery Fail");
-  if (status ==0){
-    success = "Delivery Success :)";
-  }
-  else{
-    success = "Delivery Fail :(";
+  // Serial.println(delivered ? "Delivery Success" : "Delivery Fail");
+  if (!delivered){
+    TRACE_MARK(TRACE_RADIO_LOST);
   }
 
   //Note that too short interval between sending two ESP-NOW data may lead to disorder of sending callback function. So, it is recommended that sending the next ESP-NOW data after the sending callback function of the previous sending has returned.
@@ -411,11 +530,28 @@ void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
 }
 
 void OnDataRecv(const uint8_t * mac, const uint8_t *incomingData, int len) {
+  TRACE_SCOPE(TRACE_RADIO_RECEIVE);
+  struct_remote_header header;
+  if (len < (int)sizeof(header)){
+    return;
+  }
+  memcpy(&header, incomingData, sizeof(header));
+  playback.sync(header.millis);
+  resetReceiveTimeout();
+
+  // uploads and playback commands are handled in loop()
+  if (header.type != MSG_CONTROL){
+    playback.receive(incomingData, len);
+    return;
+  }
+
+  if (len < (int)sizeof(dataIn)){
+    return;
+  }
   memcpy(&dataIn, incomingData, sizeof(dataIn));
   // Serial.print("Bytes received: ");
   // Serial.println(len);
   processJoystick();
-  resetReceiveTimeout();
 
   rP = dataIn.rP;
   rI = dataIn.rI;
@@ -430,13 +566,13 @@ void OnDataRecv(const uint8_t * mac, const uint8_t *incomingData, int len) {
 }
 
 void sendData(){
-  
-  if (dataTimer < millis()){
-    esp_now_send(remoteAddress, (uint8_t *) &dataOut, sizeof(dataOut));
-
-    dataTimer = millis() + 5;
+  // telemetry rides along behind dataOut, so the frame rate stays the same
+  memcpy(telemetryFrame, &dataOut, sizeof(dataOut));
+  size_t len = sizeof(dataOut);
+  if (telemetry.getPending()){
+    len += telemetry.pack(telemetryFrame + len, sizeof(telemetryFrame) - len);
   }
-  
+  TRACE(TRACE_RADIO_SEND, transport.send(remoteAddress, telemetryFrame, len));
 };
 
 
@@ -445,18 +581,20 @@ void sendData(){
 
 
 void updatePositions(){
-  positionLLegRaw = getLAngleThroughMux();
-  positionRLegRaw = getRAngleThroughMux();
+  TRACE(TRACE_I2C_ENCODER_L, lEncoder.update());
+  TRACE(TRACE_I2C_ENCODER_R, rEncoder.update());
 
-  positionLLegDegrees = 360 - fmod(((positionLLegRaw + NEUTRAL_L_LEG) / 4096.) * 360, 360);
-  positionRLegDegrees = fmod(((positionRLegRaw + NEUTRAL_R_LEG) / 4096.) * 360, 360);
+  positionLLegRaw = lEncoder.getRaw();
+  positionRLegRaw = rEncoder.getRaw();
+  positionLLeg = lEncoder.getPosition();
+  positionRLeg = rEncoder.getPosition();
 }
 
 void captureLPWM()
 {
   static uint32_t lastTime  = 0;
   uint32_t now = micros();
-  if (digitalRead(ENCODER_L_PWM) == HIGH)
+  if (digitalRead(LLeg::ENCODER_PWM_PIN) == HIGH)
   {
     lPWMduration = now - lastTime;
   }
@@ -478,9 +616,10 @@ void expanderInit(){
 
 void updateButtons(){
 
-  uint8_t readings = Expander.read8();
+  uint8_t readings;
+  TRACE(TRACE_I2C_EXPANDER, readings = Expander.read8());
 
-  buttonUpL = !digitalRead(BOOT_SW_PIN);
+  buttonUpL = !digitalRead(Robot::BOOT_SW_PIN);
   buttonUpR = !(readings & (1 << 0));
   buttonDownR = !(readings & (1 << 1));
   yellowSwitch = !(readings & (1 << 2));
@@ -497,30 +636,14 @@ void muxInit(){
     Serial.println("Mux not detected.");
   }
 
-  myMux.setPort(0);
-  rAs5600.begin();
-  myMux.setPort(1);
-  lAs5600.begin();
-
-  if (!lAs5600.isConnected()){
-    Serial.println("Left encoder not connected.");
-  }
-
-  myMux.setPort(0);
-  if (!rAs5600.isConnected()){
+  if (!rEncoder.begin()){
     Serial.println("Right encoder not connected.");
   }
 
-}
-
-uint16_t getRAngleThroughMux(){
-  myMux.setPort(0);
-  return rAs5600.readAngle();
-}
+  if (!lEncoder.begin()){
+    Serial.println("Left encoder not connected.");
+  }
 
-uint16_t getLAngleThroughMux(){
-  myMux.setPort(1);
-  return lAs5600.readAngle();
 }
 
 // -------------------------------
@@ -554,12 +677,7 @@ void setLCD()
 
 void updateLCD()
 {
-
-  if (lcdTimer > millis())
-  {
-    return;
-  }
-  lcdTimer = millis() + 50; // update every 200 milliseconds
+  TRACE_SCOPE(TRACE_LCD_FLUSH);
 
   if (lcdPID){
     lcdUpdatePID();
@@ -608,14 +726,14 @@ void lcdUpdateTargetPosition(){
   lcd.print(rTargetPositionDegrees);
   lcd.print(" ");
   lcd.setCursor(3,2);
-  lcd.print(rInput, 0);
+  lcd.print(rInput.toDegrees(), 0);
   lcd.print(" ");
 
   lcd.setCursor(11,1);
   lcd.print(lTargetPositionDegrees);
   lcd.print(" ");
   lcd.setCursor(11,2);
-  lcd.print(lInput, 0);
+  lcd.print(lInput.toDegrees(), 0);
   lcd.print(" ");
 }
 
@@ -625,39 +743,39 @@ void lcdUpdateTargetPosition(){
 
 
 void ledRed(uint8_t brightness = 10){
-  analogWrite(LED_R_PIN, brightness);
-  analogWrite(LED_G_PIN, 0);
-  analogWrite(LED_B_PIN, 0);
+  analogWrite(Robot::LED_R_PIN, brightness);
+  analogWrite(Robot::LED_G_PIN, 0);
+  analogWrite(Robot::LED_B_PIN, 0);
 }
 
 void ledGreen(uint8_t brightness = 10){
-  analogWrite(LED_R_PIN, 0);
-  analogWrite(LED_G_PIN, brightness);
-  analogWrite(LED_B_PIN, 0);
+  analogWrite(Robot::LED_R_PIN, 0);
+  analogWrite(Robot::LED_G_PIN, brightness);
+  analogWrite(Robot::LED_B_PIN, 0);
 }
 
 void ledBlue(uint8_t brightness = 10){
-  analogWrite(LED_R_PIN, 0);
-  analogWrite(LED_G_PIN, 0);
-  analogWrite(LED_B_PIN, brightness);
+  analogWrite(Robot::LED_R_PIN, 0);
+  analogWrite(Robot::LED_G_PIN, 0);
+  analogWrite(Robot::LED_B_PIN, brightness);
 }
 
 void ledYellow(uint8_t brightness = 10){
-  analogWrite(LED_R_PIN, brightness);
-  analogWrite(LED_G_PIN, brightness * 0.4);
-  analogWrite(LED_B_PIN, 0);
+  analogWrite(Robot::LED_R_PIN, brightness);
+  analogWrite(Robot::LED_G_PIN, brightness * 0.4);
+  analogWrite(Robot::LED_B_PIN, 0);
 }
 
 void ledWhite(uint8_t brightness = 10){
-  analogWrite(LED_R_PIN, brightness);
-  analogWrite(LED_G_PIN, brightness);
-  analogWrite(LED_B_PIN, brightness);
+  analogWrite(Robot::LED_R_PIN, brightness);
+  analogWrite(Robot::LED_G_PIN, brightness);
+  analogWrite(Robot::LED_B_PIN, brightness);
 }
 
 void ledOff(){
-  analogWrite(LED_R_PIN, 0);
-  analogWrite(LED_G_PIN, 0);
-  analogWrite(LED_B_PIN, 0);
+  analogWrite(Robot::LED_R_PIN, 0);
+  analogWrite(Robot::LED_G_PIN, 0);
+  analogWrite(Robot::LED_B_PIN, 0);
 }
 
 void updateLED(){
@@ -673,91 +791,85 @@ void updateLED(){
 // MARK: - PID
 
 void pidInit(){
-  rPID.SetMode(AUTOMATIC);
-  rPID.SetOutputLimits(-PWM_RANGE, PWM_RANGE);
-  rPID.SetSampleTime(1);
+  rMotor.setTunings(rP, rI, rD);
+  rMotor.start();
 
-  lPID.SetMode(AUTOMATIC);
-  lPID.SetOutputLimits(-PWM_RANGE, PWM_RANGE);
-  lPID.SetSampleTime(1);
+  lMotor.setTunings(lP, lI, lD);
+  lMotor.start();
 }
 
 void updatePID(){
-  rInput = positionRLegDegrees;
-  rSetpoint = rTargetPositionDegrees;
-  rPID.SetTunings(rP, rI, rD);
-  rPID.Compute();
+  // while a timeline plays here, it sets the targets instead of the remote
+  struct_leg_targets current = {rSetpoint, lSetpoint, rP};
+  struct_leg_targets targets;
+  if (teach.update(millis(), current, targets) || playback.update(millis(), current, targets)){
+    rSetpoint = targets.rTarget;
+    lSetpoint = targets.lTarget;
+    rP = targets.kP;
+  } else {
+    rSetpoint = Angle::fromWholeDegrees(rTargetPositionDegrees);
+    lSetpoint = Angle::fromWholeDegrees(lTargetPositionDegrees);
+  }
+
+  // the controllers read the encoders themselves, as updatePositions() left them
+  rInput = positionRLeg;
+  rMotor.setTarget(rSetpoint);
+  rMotor.setTunings(rP, rI, rD);
+  TRACE(TRACE_PID_R, pidComputed = rMotor.updatePid(millis()));
 
-  lInput = positionLLegDegrees;
-  lSetpoint = lTargetPositionDegrees;
-  lPID.SetTunings(rP, rI, rD); // still R incoming
-  lPID.Compute();
+  lInput = positionLLeg;
+  lMotor.setTarget(lSetpoint);
+  lMotor.setTunings(rP, rI, rD); // still R incoming
+  TRACE(TRACE_PID_L, lMotor.updatePid(millis()));
 }
 
 void controlMotorPID(){
-  // right
-  if (rOutput > 1){
-    ledcWrite(R_B_PWM_CHAN, map(rOutput, 0, PWM_RANGE, RDEADBAND, PWM_RANGE));
-    ledcWrite(R_F_PWM_CHAN, 0);
-  }
-  if (rOutput < -1){
-    ledcWrite(R_F_PWM_CHAN, -map(rOutput, 0, -PWM_RANGE, -RDEADBAND, -PWM_RANGE));
-    ledcWrite(R_B_PWM_CHAN, 0);
-  }
-  if (rOutput > -1 && rOutput < 1){
-    ledcWrite(R_F_PWM_CHAN, 0);
-    ledcWrite(R_B_PWM_CHAN, 0);
-  }
-
-  // left
-  if (lOutput > 1){
-    ledcWrite(L_B_PWM_CHAN, map(lOutput, 0, PWM_RANGE, LDEADBAND, PWM_RANGE));
-    ledcWrite(L_F_PWM_CHAN, 0);
-  }
-  if (lOutput < -1){
-    ledcWrite(L_F_PWM_CHAN, -map(lOutput, 0, -PWM_RANGE, -LDEADBAND, -PWM_RANGE));
-    ledcWrite(L_B_PWM_CHAN, 0);
-  }
-  if (lOutput > -1 && lOutput < 1){
-    ledcWrite(L_F_PWM_CHAN, 0);
-    ledcWrite(L_B_PWM_CHAN, 0);
-  }
+  // the deadband mapping is checked on the host, see host/motorCheck
+  rMotor.updateMotor();
+  lMotor.updateMotor();
 }
 
 // -------------------------------
 // MARK: - Print
 
 void printAll(){
-  if (printTimer < millis()){
-    printTimer = millis() + 300;
-    Serial.print("R: ");
-    Serial.print(positionRLegDegrees);
-    Serial.print("\t");
-    Serial.print(getRAngleThroughMux());
-    Serial.print("L: ");
-    Serial.print(positionLLegDegrees);
-    Serial.print("\t");
-    Serial.println(getLAngleThroughMux());
+  // binary records, decoded on the host with host/logDecode
+  binaryLog.log(LOG_LEG_POSITIONS, 0, positionRLegRaw, positionLLegRaw,
+                positionRLeg.toTenths(), positionLLeg.toTenths());
+  binaryLog.log(LOG_LEG_BUTTONS, buttonUpL | buttonDownL << 1 | yellowSwitch << 2 |
+                                 buttonUpR << 3 | buttonDownR << 4);
+
+#ifdef LOOP_PROFILER
+  // a zone per tick, it also rides along to the remote in dataOut
+  loopProfiler.next(dataOut.profile);
+  binaryLog.log(LOG_LEG_PROFILE, dataOut.profile.zone, dataOut.profile.min,
+                dataOut.profile.mean, dataOut.profile.max, dataOut.profile.p99);
+#endif
+}
 
-    Serial.print(buttonUpL);
-    Serial.print(buttonDownL);
-    Serial.print(yellowSwitch);
-    Serial.print(buttonUpR);
-    Serial.println(buttonDownR);
+// paced dumps, a few records each time so they do not crowd out the prints;
+// nothing to do unless one is running
+void dumpAll(){
+  teach.log(binaryLog);
 
+#ifdef TRACE_EVENTS
+  if (buttonDownL){
+    traceRing.startDump();
   }
+  traceRing.drain(binaryLog);
+#endif
 }
 
 // -------------------------------
 // MARK: - Process data
 
 void processJoystick(){
-  // maps value to -PWM_RANGE to PWM_RANGE, if above/below JOYSTICK_THRESHOLD
+  // maps value to -Pwm::RANGE to Pwm::RANGE, if above/below JOYSTICK_THRESHOLD
 
-  joystickRX = map(dataIn.joystickRX, 0, 4095, -PWM_RANGE, PWM_RANGE);
-  joystickRY = map(dataIn.joystickRY, 0, 4095, -PWM_RANGE, PWM_RANGE);
-  joystickLX = map(dataIn.joystickLX, 0, 4095, -PWM_RANGE, PWM_RANGE);
-  joystickLY = map(dataIn.joystickLY, 0, 4095, -PWM_RANGE, PWM_RANGE);
+  joystickRX = map(dataIn.joystickRX, 0, 4095, -Pwm::RANGE, Pwm::RANGE);
+  joystickRY = map(dataIn.joystickRY, 0, 4095, -Pwm::RANGE, Pwm::RANGE);
+  joystickLX = map(dataIn.joystickLX, 0, 4095, -Pwm::RANGE, Pwm::RANGE);
+  joystickLY = map(dataIn.joystickLY, 0, 4095, -Pwm::RANGE, Pwm::RANGE);
 
   if (joystickRX < JOYSTICK_TRESHOLD && joystickRX > -JOYSTICK_TRESHOLD){
     joystickRX = 0;
@@ -782,22 +894,69 @@ void zeroJoystick(){
 }
 
 // -------------------------------
-// MARK: - PWM
+// MARK: - MOTORS
 
 void pwmInit(){
-  ledcSetup(R_F_PWM_CHAN, PWM_FREQ, PWM_RES);
-  ledcAttachPin(R_F_PWM_PIN, R_F_PWM_CHAN);
+  rMotor.begin();
+  lMotor.begin();
+}
 
-  ledcSetup(R_B_PWM_CHAN, PWM_FREQ, PWM_RES);
-  ledcAttachPin(R_B_PWM_PIN, R_B_PWM_CHAN);
 
-  ledcSetup(L_F_PWM_CHAN, PWM_FREQ, PWM_RES);
-  ledcAttachPin(L_F_PWM_PIN, L_F_PWM_CHAN);
 
-  ledcSetup(L_B_PWM_CHAN, PWM_FREQ, PWM_RES);
-  ledcAttachPin(L_B_PWM_PIN, L_B_PWM_CHAN);
+// --------------------------------
+// MARK: - Telemetry
+
+void updateLoopTime(){
+  uint32_t now = micros();
+  loopMicros = min(now - loopStartMicros, (uint32_t)UINT16_MAX);
+  loopStartMicros = now;
 }
 
+void recordTelemetry(){
+  // one sample per PID compute, so ~1 kHz with SetSampleTime(1)
+  if (!pidComputed){
+    return;
+  }
+  // fewer while the governor sheds load, the timestamps show which
+  if (++telemetrySkipped < telemetryDecimation){
+    return;
+  }
+  telemetrySkipped = 0;
+
+  uint32_t now = micros();
+  uint32_t dt = now - lastSampleMicros;
+
+  struct_telemetry_sample sample;
+  sample.micros = now;
+  sample.loopMicros = loopMicros;
+
+  sample.joints[0].position = rInput.toTenths();
+  sample.joints[0].velocity = degreesPerSecond(lastRInput, rInput, dt);
+  sample.joints[0].setpoint = rSetpoint.toTenths();
+  sample.joints[0].output = IntPid::toPwm(rMotor.getOutput());
+  sample.joints[0].duty = rMotor.getDuty();
+
+  sample.joints[1].position = lInput.toTenths();
+  sample.joints[1].velocity = degreesPerSecond(lastLInput, lInput, dt);
+  sample.joints[1].setpoint = lSetpoint.toTenths();
+  sample.joints[1].output = IntPid::toPwm(lMotor.getOutput());
+  sample.joints[1].duty = lMotor.getDuty();
+
+  telemetry.record(sample);
+
+  lastSampleMicros = now;
+  lastRInput = rInput;
+  lastLInput = lInput;
+}
+
+int16_t degreesPerSecond(Angle from, Angle to, uint32_t dtMicros){
+  if (dtMicros == 0){
+    return 0;
+  }
+  // the shortest way round, in counts
+  int64_t delta = to - from;
+  return constrain(delta * 360 * 1000000 / ((int64_t)Angle::COUNTS * dtMicros), INT16_MIN, INT16_MAX);
+}
 
 
 // --------------------------------
@@ -809,36 +968,36 @@ void joystickOrButtonsControlLegs(){
 
   // right
   if (joystickRY > JOYSTICK_TRESHOLD){
-    ledcWrite(R_F_PWM_CHAN, joystickRY /2);
+    ledcWrite(RLeg::FORWARD_CHANNEL, joystickRY /2);
   } else if (buttonUpR){
-    ledcWrite(R_F_PWM_CHAN, speed);
+    ledcWrite(RLeg::FORWARD_CHANNEL, speed);
   } else {
-    ledcWrite(R_F_PWM_CHAN, 0);
+    ledcWrite(RLeg::FORWARD_CHANNEL, 0);
   }
 
   if (joystickRY < -JOYSTICK_TRESHOLD){
-    ledcWrite(R_B_PWM_CHAN, -joystickRY /2);
+    ledcWrite(RLeg::BACKWARD_CHANNEL, -joystickRY /2);
   } else if (buttonDownR){
-    ledcWrite(R_B_PWM_CHAN, speed);
+    ledcWrite(RLeg::BACKWARD_CHANNEL, speed);
   }  else {
-    ledcWrite(R_B_PWM_CHAN, 0);
+    ledcWrite(RLeg::BACKWARD_CHANNEL, 0);
   }
 
   // left
   if (joystickLY > JOYSTICK_TRESHOLD){
-    ledcWrite(L_F_PWM_CHAN, joystickLY /2);
+    ledcWrite(LLeg::FORWARD_CHANNEL, joystickLY /2);
   } else if (buttonUpL){
-    ledcWrite(L_F_PWM_CHAN, speed);
+    ledcWrite(LLeg::FORWARD_CHANNEL, speed);
   } else {
-    ledcWrite(L_F_PWM_CHAN, 0);
+    ledcWrite(LLeg::FORWARD_CHANNEL, 0);
   }
 
   if (joystickLY < -JOYSTICK_TRESHOLD){
-    ledcWrite(L_B_PWM_CHAN, -joystickLY /2);
+    ledcWrite(LLeg::BACKWARD_CHANNEL, -joystickLY /2);
   } else if (buttonDownL){
-    ledcWrite(L_B_PWM_CHAN, speed);
+    ledcWrite(LLeg::BACKWARD_CHANNEL, speed);
   } else {
-    ledcWrite(L_B_PWM_CHAN, 0);
+    ledcWrite(LLeg::BACKWARD_CHANNEL, 0);
   }
 
 }
@@ -848,19 +1007,19 @@ void sliderPWMtest(){
   slideTestBackward = map(dataIn.sliderRL , 0, 17620, 0, 255);
 
   if (slideTestForward > 5){
-    ledcWrite(R_F_PWM_CHAN, slideTestForward);
-    ledcWrite(L_F_PWM_CHAN, slideTestForward);
+    ledcWrite(RLeg::FORWARD_CHANNEL, slideTestForward);
+    ledcWrite(LLeg::FORWARD_CHANNEL, slideTestForward);
   } else {
-    ledcWrite(R_F_PWM_CHAN, 0);
-    ledcWrite(L_F_PWM_CHAN, 0);
+    ledcWrite(RLeg::FORWARD_CHANNEL, 0);
+    ledcWrite(LLeg::FORWARD_CHANNEL, 0);
   }
 
   if (slideTestBackward > 5){
-    ledcWrite(R_B_PWM_CHAN, slideTestBackward);
-    ledcWrite(L_B_PWM_CHAN, slideTestBackward);
+    ledcWrite(RLeg::BACKWARD_CHANNEL, slideTestBackward);
+    ledcWrite(LLeg::BACKWARD_CHANNEL, slideTestBackward);
   } else {
-    ledcWrite(R_B_PWM_CHAN, 0);
-    ledcWrite(L_B_PWM_CHAN, 0);
+    ledcWrite(RLeg::BACKWARD_CHANNEL, 0);
+    ledcWrite(LLeg::BACKWARD_CHANNEL, 0);
   }
 
 }
@@ -3,7 +3,6 @@
 Battery::Battery(uint8_t pin, Buzzer &buzzer, PhysicalSwitch &lowPowerSwitch)
     : pin(pin), buzzer(buzzer), lowPowerSwitch(lowPowerSwitch), samples(64)
 {
-  alarmTimer = millis();
 }
 
 void Battery::sleep()
@@ -32,7 +31,7 @@ bool Battery::shouldWakeUp()
 
 bool Battery::shouldBuzzerBuzz()
 {
-  return getPercentage() < 10 && alarmTimer < millis() && lowPowerSwitch.isOff();
+  return getPercentage() < 10 && lowPowerSwitch.isOff();
 }
 
 int8_t Battery::getPercentage()
@@ -59,10 +58,12 @@ void Battery::update()
     // lcd.clear();
     // setLCD();
   }
+}
 
+void Battery::alarm()
+{
   if (shouldBuzzerBuzz())
   {
     buzzer.buzzFor(300);
-    alarmTimer = millis() + 600;
   }
 }
@@ -12,6 +12,8 @@ class Battery
 public:
   Battery(uint8_t pin, Buzzer &buzzer, PhysicalSwitch &lowPowerSwitch);
   void update();
+  // every 600 ms, buzzes half of it when low
+  void alarm();
   int8_t getPercentage();
 
 private:
@@ -19,7 +21,6 @@ private:
   Buzzer &buzzer;
   PhysicalSwitch &lowPowerSwitch;
   RunningMedian samples;
-  uint32_t alarmTimer;
   int8_t percentage;
   bool shouldSleep();
   bool shouldWakeUp();
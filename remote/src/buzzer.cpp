@@ -1,6 +1,6 @@
 #include <buzzer.h>
 
-Buzzer::Buzzer(uint8_t pin) : pin(pin)
+Buzzer::Buzzer(uint8_t pin, Scheduler &scheduler) : pin(pin), scheduler(scheduler), job(Scheduler::NO_JOB)
 {
   
 }
@@ -8,14 +8,17 @@ Buzzer::Buzzer(uint8_t pin) : pin(pin)
 void Buzzer::init()
 {
   pinMode(pin, OUTPUT);
+  job = scheduler.add({"buzzer", off, this, 2, 0, 0, 50});
 }
 
-void Buzzer::update()
+void Buzzer::buzzFor(uint16_t ms)
 {
-  digitalWrite(pin, timer > millis());
+  // a longer or shorter buzz replaces the one going
+  digitalWrite(pin, HIGH);
+  scheduler.start(job, ms * 1000);
 }
 
-void Buzzer::buzzFor(uint16_t ms)
+void Buzzer::off(void *self)
 {
-  timer = millis() + ms;
+  digitalWrite(((Buzzer *)self)->pin, LOW);
 }
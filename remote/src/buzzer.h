@@ -2,18 +2,21 @@
 #define BUZZER_H
 
 #include <Arduino.h>
+#include <scheduler.h>
 
 class Buzzer
 {
 public:
-  Buzzer(uint8_t pin);
+  Buzzer(uint8_t pin, Scheduler &scheduler);
   void init();
-  void update();
   void buzzFor(uint16_t time);
 
 private:
   uint8_t pin;
-  uint32_t timer = 0;
+  Scheduler &scheduler;
+  uint8_t job; // one-shot, turns it off
+
+  static void off(void *self);
 };
 
 #endif
@@ -0,0 +1,123 @@
+#include <cueList.h>
+
+CueList::CueList(const struct_cue *cues, uint8_t count)
+    : cues(cues), count(count), running(-1), standby(0), status(CUE_LOADING), timelineIndex(-1),
+      checked(0), outsideLimits(0), entryPose({180, 180, 0})
+{
+}
+
+void CueList::reset()
+{
+  running = -1;
+  prefetch(0);
+}
+
+void CueList::prefetch(uint8_t index)
+{
+  standby = index;
+  status = index < count ? CUE_LOADING : CUE_END;
+  timelineIndex = -1;
+  checked = 0;
+  outsideLimits = 0;
+}
+
+void CueList::update(TimelineLibrary &library)
+{
+  if (status != CUE_LOADING)
+  {
+    return;
+  }
+
+  const struct_cue &cue = cues[standby];
+  if (timelineIndex < 0)
+  {
+    timelineIndex = library.find(sequences[cue.move].name);
+    if (timelineIndex < 0 || !library.get(timelineIndex, timeline) || !timeline.count)
+    {
+      status = CUE_FAILED;
+    }
+    return;
+  }
+
+  // keyframes in order, and which are outside the limits
+  uint16_t end = min((uint16_t)(checked + CHECK_STEP), timeline.count);
+  for (; checked < end; checked++)
+  {
+    const struct_keyframe &keyframe = timeline.keyframes[checked];
+    if (checked && keyframe.time < timeline.keyframes[checked - 1].time)
+    {
+      status = CUE_FAILED;
+      return;
+    }
+    if (keyframe.rTarget < forwardLimit || keyframe.rTarget > backwardLimit ||
+        keyframe.lTarget < forwardLimit || keyframe.lTarget > backwardLimit)
+    {
+      outsideLimits++;
+    }
+  }
+  if (checked < timeline.count)
+  {
+    return;
+  }
+
+  // where GO will take the legs, as a seek with nothing to ramp from would
+  TimelinePlayer preview(library);
+  preview.seek(timelineIndex, cue.position, 0, entryPose, 0);
+  if (!preview.update(0, entryPose))
+  {
+    const struct_keyframe &first = timeline.keyframes[0];
+    entryPose = {(float)first.rTarget, (float)first.lTarget, first.kP / 100.f};
+  }
+  status = CUE_READY;
+}
+
+const struct_cue *CueList::go()
+{
+  if (status != CUE_READY)
+  {
+    return nullptr;
+  }
+  running = standby;
+  prefetch(standby + 1);
+  return &cues[running];
+}
+
+void CueList::back()
+{
+  prefetch(standby ? min(standby - 1, count - 1) : 0);
+}
+
+CueList::Status CueList::getStatus()
+{
+  return status;
+}
+
+int16_t CueList::getRunning()
+{
+  return running;
+}
+
+uint8_t CueList::getStandby()
+{
+  return standby;
+}
+
+uint8_t CueList::getCount()
+{
+  return count;
+}
+
+const struct_cue &CueList::getCue(uint8_t index)
+{
+  return cues[index];
+}
+
+const struct_timeline_state &CueList::getEntryPose()
+{
+  return entryPose;
+}
+
+uint16_t CueList::getOutsideLimits()
+{
+  return outsideLimits;
+}
@@ -0,0 +1,61 @@
+#ifndef CUE_LIST_H
+#define CUE_LIST_H
+
+#include <Arduino.h>
+#include <cues.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+// Runs the show as an ordered list of cues: GO starts the cue on standby and
+// puts the next one on standby, BACK moves the standby back one. The cue on
+// standby is looked up and checked a few keyframes per loop, and its entry
+// pose worked out, so GO itself is only a seek.
+class CueList
+{
+public:
+  static const uint8_t CHECK_STEP = 32; // keyframes per update
+
+  enum Status
+  {
+    CUE_LOADING,
+    CUE_READY,
+    CUE_FAILED,
+    CUE_END, // past the last cue
+  };
+
+  CueList(const struct_cue *cues, uint8_t count);
+  // again whenever the library changes, standby on the first cue
+  void reset();
+  // the background work, once per loop
+  void update(TimelineLibrary &library);
+
+  // the cue to start, nullptr if the standby is not ready
+  const struct_cue *go();
+  void back();
+
+  Status getStatus();
+  int16_t getRunning(); // -1 = none yet
+  uint8_t getStandby();
+  uint8_t getCount();
+  const struct_cue &getCue(uint8_t index);
+  // of the cue on standby, once ready
+  const struct_timeline_state &getEntryPose();
+  uint16_t getOutsideLimits();
+
+private:
+  const struct_cue *cues;
+  uint8_t count;
+  int16_t running;
+  uint8_t standby;
+
+  Status status;
+  int16_t timelineIndex; // in the library, -1 = not looked up yet
+  struct_timeline timeline;
+  uint16_t checked;
+  uint16_t outsideLimits;
+  struct_timeline_state entryPose;
+
+  void prefetch(uint8_t index);
+};
+
+#endif
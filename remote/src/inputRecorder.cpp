@@ -0,0 +1,291 @@
+#include <inputRecorder.h>
+
+InputRecorder::InputRecorder()
+    : partition(nullptr), slotSize(0), state(TAKE_IDLE), slot(0), erased(0), mode(0), pageUsed(0),
+      written(0), mapped(nullptr), handle(0), replayStart(0), hasNext(false), nextTime(0)
+{
+  memset(&header, 0, sizeof(header));
+  memset(&filtered, 0, sizeof(filtered));
+}
+
+bool InputRecorder::init()
+{
+  partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                       (esp_partition_subtype_t)PARTITION_SUBTYPE, "takes");
+  if (!partition)
+  {
+    Serial.println("no takes partition");
+    return false;
+  }
+
+  // both slots hold a take if the remote went off before the older one was
+  // erased, the newer one wins
+  slotSize = (partition->size / 2) & ~(SPI_FLASH_SEC_SIZE - 1);
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    struct_input_take_header take;
+    if (readHeader(i, take) && (!header.magic || (int8_t)(take.sequence - header.sequence) > 0))
+    {
+      header = take;
+      slot = i ^ 1;
+    }
+  }
+  erased = 0;
+  return header.magic != 0;
+}
+
+bool InputRecorder::readHeader(uint8_t slot, struct_input_take_header &take)
+{
+  // no magic if it is erased, or the recording never finished
+  return esp_partition_read(partition, slot * slotSize, &take, sizeof(take)) == ESP_OK &&
+         take.magic == INPUT_TAKE_MAGIC && take.version == INPUT_TAKE_VERSION &&
+         take.size <= slotSize - DATA_OFFSET;
+}
+
+bool InputRecorder::erase()
+{
+  // not while a take plays either, the stall would show
+  if (!partition || state != TAKE_IDLE || erased >= slotSize)
+  {
+    return false;
+  }
+  uint32_t offset = slot * slotSize + erased;
+  if (!isBlank(offset) && esp_partition_erase_range(partition, offset, SPI_FLASH_SEC_SIZE) != ESP_OK)
+  {
+    return false;
+  }
+  erased += SPI_FLASH_SEC_SIZE;
+  return true;
+}
+
+bool InputRecorder::isBlank(uint32_t offset)
+{
+  // reading a sector takes well under a millisecond, erasing it tens; the
+  // page buffer is free while not recording
+  for (uint32_t i = 0; i < SPI_FLASH_SEC_SIZE; i += PAGE_SIZE)
+  {
+    if (esp_partition_read(partition, offset + i, page, PAGE_SIZE) != ESP_OK)
+    {
+      return false;
+    }
+    for (size_t j = 0; j < PAGE_SIZE; j++)
+    {
+      if (page[j] != 0xFF)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void InputRecorder::filter(struct_input_sample &sample)
+{
+  for (uint8_t i = 0; i < INPUT_CHANNELS; i++)
+  {
+    int16_t hysteresis = i < 4 ? SLIDER_HYSTERESIS : JOYSTICK_HYSTERESIS;
+    if (abs(sample.channels[i] - filtered.channels[i]) >= hysteresis)
+    {
+      filtered.channels[i] = sample.channels[i];
+    }
+    sample.channels[i] = filtered.channels[i];
+  }
+}
+
+void InputRecorder::update(uint32_t now, struct_input_sample &sample, BinaryLog &log)
+{
+  filter(sample);
+
+  if (state == TAKE_RECORDING)
+  {
+    uint8_t record[INPUT_TAKE_MAX_RECORD_SIZE];
+    size_t len = encoder.add(sample, now, record);
+    if (len && !append(record, len))
+    {
+      finishRecording(); // the partition is full, keep what fits
+      logState(log);
+    }
+    return;
+  }
+
+  if (state != TAKE_REPLAYING)
+  {
+    return;
+  }
+
+  // any key takes the remote back, and does nothing else
+  if (sample.key)
+  {
+    sample.key = 0;
+    finishReplay();
+    logState(log);
+    return;
+  }
+
+  // one key per loop, as from the keypad, a second one waits for the next
+  replayed.key = 0;
+  while (hasNext && (int32_t)(now - replayStart - nextTime) >= 0 && !(next.key && replayed.key))
+  {
+    memcpy(replayed.channels, next.channels, sizeof(replayed.channels));
+    replayed.key = next.key;
+    hasNext = decoder.next(next, nextTime);
+  }
+  sample = replayed;
+
+  if (!hasNext)
+  {
+    finishReplay();
+    logState(log);
+  }
+}
+
+bool InputRecorder::record(uint32_t now, uint8_t mode, BinaryLog &log)
+{
+  stop(log);
+  // the previous take stays replayable until this one is saved
+  if (!partition || erased <= DATA_OFFSET)
+  {
+    return false;
+  }
+
+  this->mode = mode;
+  encoder.begin(now);
+  pageUsed = 0;
+  written = 0;
+  state = TAKE_RECORDING;
+  logState(log);
+  return true;
+}
+
+bool InputRecorder::append(const uint8_t *record, size_t len)
+{
+  // the slot is full, or was not erased all the way yet
+  if (DATA_OFFSET + written + pageUsed + len > erased)
+  {
+    return false;
+  }
+  while (len)
+  {
+    size_t n = min(len, PAGE_SIZE - pageUsed);
+    memcpy(page + pageUsed, record, n);
+    pageUsed += n;
+    record += n;
+    len -= n;
+    if (pageUsed == PAGE_SIZE && !flush())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool InputRecorder::flush()
+{
+  if (!pageUsed)
+  {
+    return true;
+  }
+  // into erased flash, a page write takes under a millisecond
+  bool ok = esp_partition_write(partition, slot * slotSize + DATA_OFFSET + written, page,
+                                pageUsed) == ESP_OK;
+  written += pageUsed;
+  pageUsed = 0;
+  return ok;
+}
+
+void InputRecorder::finishRecording()
+{
+  state = TAKE_IDLE;
+
+  // the header goes in last, so an interrupted take is not replayed
+  struct_input_take_header take = {INPUT_TAKE_MAGIC,
+                                   INPUT_TAKE_VERSION,
+                                   mode,
+                                   (uint8_t)(header.magic ? header.sequence + 1 : 0),
+                                   (uint32_t)(written + pageUsed),
+                                   encoder.getRecords(),
+                                   encoder.getDuration()};
+  if (flush() && esp_partition_write(partition, slot * slotSize, &take, sizeof(take)) == ESP_OK)
+  {
+    header = take;
+    slot ^= 1;
+  }
+  // erase() starts on the free slot again, the previous take or what was
+  // written of this one
+  erased = 0;
+}
+
+bool InputRecorder::replay(uint32_t now, BinaryLog &log)
+{
+  stop(log);
+  if (header.magic != INPUT_TAKE_MAGIC || !header.size)
+  {
+    return false;
+  }
+
+  const void *data;
+  if (esp_partition_mmap(partition, (slot ^ 1) * slotSize, DATA_OFFSET + header.size,
+                         SPI_FLASH_MMAP_DATA, &data, &handle) != ESP_OK)
+  {
+    return false;
+  }
+  mapped = (const uint8_t *)data;
+  decoder.begin(mapped + DATA_OFFSET, header.size);
+  memset(&replayed, 0, sizeof(replayed));
+  hasNext = decoder.next(next, nextTime);
+  replayStart = now;
+  state = TAKE_REPLAYING;
+  logState(log);
+  return true;
+}
+
+void InputRecorder::finishReplay()
+{
+  state = TAKE_IDLE;
+  if (mapped)
+  {
+    spi_flash_munmap(handle);
+  }
+  mapped = nullptr;
+  hasNext = false;
+}
+
+void InputRecorder::stop(BinaryLog &log)
+{
+  if (state == TAKE_RECORDING)
+  {
+    finishRecording();
+  }
+  else if (state == TAKE_REPLAYING)
+  {
+    finishReplay();
+  }
+  else
+  {
+    return;
+  }
+  logState(log);
+}
+
+TakeState InputRecorder::getState()
+{
+  return state;
+}
+
+uint8_t InputRecorder::getMode()
+{
+  return header.mode;
+}
+
+void InputRecorder::logState(BinaryLog &log)
+{
+  if (state == TAKE_RECORDING)
+  {
+    log.log(LOG_REMOTE_TAKE, state, written + pageUsed, encoder.getRecords());
+  }
+  else
+  {
+    log.log(LOG_REMOTE_TAKE, state, header.magic ? header.size : 0,
+            header.magic ? header.records : 0);
+  }
+}
@@ -0,0 +1,93 @@
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <Arduino.h>
+#include <binaryLog.h>
+#include <esp_partition.h>
+#include <inputTake.h>
+
+enum TakeState : uint16_t
+{
+  TAKE_IDLE,
+  TAKE_RECORDING,
+  TAKE_REPLAYING,
+};
+
+// Records the sliders, joysticks and keypad into the "takes" partition (see
+// partitions.csv) and feeds a take back in place of the live input, so a
+// puppeteered sequence can be played again exactly as it was performed.
+//
+// The analog channels go through a little hysteresis, live or not, so noise
+// does not fill the take and what is replayed is what the pipeline used.
+//
+// The partition holds two slots: the last take stays in one while the other
+// is erased in the background, so recording only ever writes pages and a
+// take can be as long as a slot.
+class InputRecorder
+{
+public:
+  static const uint8_t PARTITION_SUBTYPE = 0x41; // after the show partition
+  static const int16_t SLIDER_HYSTERESIS = 16;   // ads counts
+  static const int16_t JOYSTICK_HYSTERESIS = 8;  // analogRead() counts
+
+  InputRecorder();
+  // finds the partition and the take in it, false if there is none
+  bool init();
+
+  // sample holds the live input and is replaced by what the pipeline uses
+  void update(uint32_t now, struct_input_sample &sample, BinaryLog &log);
+
+  // erases a sector of the slot the next take goes in, when idle; false once
+  // there is nothing left to erase. Blocks for tens of ms, unless the
+  // sector is blank already, as most are at boot
+  bool erase();
+
+  // into the erased part of the free slot, the take ends where that does
+  bool record(uint32_t now, uint8_t mode, BinaryLog &log);
+  bool replay(uint32_t now, BinaryLog &log);
+  void stop(BinaryLog &log);
+
+  TakeState getState();
+  // the remote mode the take started in
+  uint8_t getMode();
+
+private:
+  static const size_t PAGE_SIZE = 256;
+  static const size_t DATA_OFFSET = PAGE_SIZE; // the header has the first page
+
+  const esp_partition_t *partition;
+  uint32_t slotSize;
+  TakeState state;
+  struct_input_take_header header; // of the take in flash, magic 0 if none
+  uint8_t slot;                    // the next take goes in, the other holds header's
+  uint32_t erased;                 // bytes of it, from its start
+  struct_input_sample filtered;
+
+  // recording
+  InputTakeEncoder encoder;
+  uint8_t mode;
+  uint8_t page[PAGE_SIZE];
+  size_t pageUsed;
+  uint32_t written;
+
+  // replaying
+  const uint8_t *mapped;
+  spi_flash_mmap_handle_t handle;
+  InputTakeDecoder decoder;
+  uint32_t replayStart;
+  struct_input_sample replayed;
+  bool hasNext;
+  struct_input_sample next;
+  uint32_t nextTime;
+
+  bool readHeader(uint8_t slot, struct_input_take_header &take);
+  bool isBlank(uint32_t offset);
+  void filter(struct_input_sample &sample);
+  bool append(const uint8_t *record, size_t len);
+  bool flush();
+  void finishRecording();
+  void finishReplay();
+  void logState(BinaryLog &log);
+};
+
+#endif
@@ -1,9 +1,10 @@
 #include <lcd.h>
+#include <traceRing.h>
 
-Lcd::Lcd(PhysicalSwitch &lowPowerSwitch, Battery &battery)
-    : lowPowerSwitch(lowPowerSwitch), battery(battery), liquidCrystal(0x27, 20, 4)
+Lcd::Lcd(PhysicalSwitch &lowPowerSwitch, Battery &battery, CueList &cueList, MusicClock &musicClock)
+    : lowPowerSwitch(lowPowerSwitch), battery(battery), cueList(cueList), musicClock(musicClock),
+      liquidCrystal(0x27, 20, 4)
 {
-  updateTimer = millis();
 }
 
 void Lcd::init()
@@ -43,12 +44,11 @@ void Lcd::update()
     init();
     writeStaticData();
   }
+}
 
-  if (updateTimer > millis()) return;
-
-  updateTimer = millis() + 200; // only draw on lcd every 200ms
-  writeDynamicData();
-
+void Lcd::draw()
+{
+  TRACE(TRACE_LCD_FLUSH, writeDynamicData());
 }
 
 void Lcd::writeStaticData()
@@ -190,6 +190,45 @@ void Lcd::writeDynamicData()
     // liquidCrystal.print(" ");
   }
 
+  if (modeStates[CUES])
+  {
+    // running and standby cue, where standby starts, and the tempo
+    char line[21];
+    int16_t running = cueList.getRunning();
+    snprintf(line, sizeof(line), "%-5s%02d %-10.10s", musicClock.isHeld() ? "HOLD" : "RUN",
+             running + 1, running >= 0 ? cueList.getCue(running).name : "-");
+    liquidCrystal.setCursor(0, 0);
+    liquidCrystal.print(line);
+
+    const char *statusNames[] = {"..", "ok", "FAIL", "END"};
+    uint8_t standby = cueList.getStandby();
+    snprintf(line, sizeof(line), "SBY %02d %-8.8s %-4s", standby + 1,
+             standby < cueList.getCount() ? cueList.getCue(standby).name : "-",
+             statusNames[cueList.getStatus()]);
+    liquidCrystal.setCursor(0, 1);
+    liquidCrystal.print(line);
+
+    const struct_timeline_state &entry = cueList.getEntryPose();
+    if (cueList.getStatus() == CueList::CUE_READY)
+    {
+      snprintf(line, sizeof(line), "in R%3d L%3d %c     ", (int)entry.rTarget, (int)entry.lTarget,
+               cueList.getOutsideLimits() ? '!' : ' ');
+    }
+    else
+    {
+      snprintf(line, sizeof(line), "%-20s", "");
+    }
+    liquidCrystal.setCursor(0, 2);
+    liquidCrystal.print(line);
+
+    // in integer tenths: newlib's %f allocates the first time it runs, and
+    // loop() must not allocate once setup is over
+    int tenths = (int)(musicClock.getTempo() * 10 + 0.5f);
+    snprintf(line, sizeof(line), "%3d.%1d bpm           ", tenths / 10, tenths % 10);
+    liquidCrystal.setCursor(0, 3);
+    liquidCrystal.print(musicClock.getTempo() > 0 ? line : "                    ");
+  }
+
   if (modeStates[BATTERY]){
     liquidCrystal.setCursor(18, 0);
     char batPerc[3];
@@ -5,24 +5,30 @@
 #include <LiquidCrystal_I2C.h>
 #include <physicalSwitch.h>
 #include <battery.h>
+#include <cueList.h>
+#include <musicClock.h>
 
 class Lcd
 {
 public:
-  Lcd(PhysicalSwitch &lowPowerSwitch, Battery &battery);
+  Lcd(PhysicalSwitch &lowPowerSwitch, Battery &battery, CueList &cueList, MusicClock &musicClock);
   void init();
   void allModesOff(); 
-  enum Mode { REMOTE_MODE_NAME, JOYSTICK, SLIDER, PID, TARGET_POSITION, BATTERY, NUM_MODES};
+  enum Mode { REMOTE_MODE_NAME, JOYSTICK, SLIDER, PID, TARGET_POSITION, CUES, BATTERY, NUM_MODES};
   void turnModeOn(Mode mode); 
   void turnModeOff(Mode mode);
+  // every loop, redraws after waking up
   void update();
+  // the values that change
+  void draw();
 
 
 private:
   PhysicalSwitch &lowPowerSwitch;
   Battery &battery;
+  CueList &cueList;
+  MusicClock &musicClock;
   LiquidCrystal_I2C liquidCrystal;
-  uint32_t updateTimer;
   bool modeStates[NUM_MODES];
 
   void writeStaticData();
@@ -18,12 +18,29 @@ TODO: The LCD is updated by the Acrobot
 #include <RunningMedian.h> // https://github.com/RobTillaart/RunningMedian
 #include <WiFi.h>
 #include <Wire.h>
-#include <esp_now.h>
 
 #include <battery.h>
+#include <binaryLog.h>
 #include <buzzer.h>
+#include <cueList.h>
+#include <cues.h>
+#include <espNowTransport.h>
+#include <heapMonitor.h>
+#include <inputRecorder.h>
 #include <lcd.h>
+#include <loopProfiler.h>
+#include <musicClock.h>
 #include <physicalSwitch.h>
+#include <profileZones.h>
+#include <protocol.h>
+#include <scheduler.h>
+#include <sequences.h>
+#include <showStore.h>
+#include <timelineLibrary.h>
+#include <telemetryCapture.h>
+#include <tempos.h>
+#include <timelineUpload.h>
+#include <traceRing.h>
 
 #define BATTERY_V 35
 #define LOW_POWER_SW 18
@@ -48,10 +65,16 @@ TODO: The LCD is updated by the Acrobot
 //----------------
 // NEW OOP initalising
 
-Buzzer buzzer = Buzzer(BUZZER);
+// everything in loop() is a job, see setup() for the periods; misses and
+// overruns go to the binary log
+Scheduler scheduler;
+Buzzer buzzer = Buzzer(BUZZER, scheduler);
 PhysicalSwitch lowPowerSwitch = PhysicalSwitch(LOW_POWER_SW, INPUT_PULLDOWN);
 Battery battery = Battery(BATTERY_V, buzzer, lowPowerSwitch);
-Lcd lcd = Lcd(lowPowerSwitch, battery);
+MusicClock musicClock; // see MUSIC CLOCK
+CueList cueList = CueList(cues, cueCount);
+Lcd lcd = Lcd(lowPowerSwitch, battery, cueList, musicClock);
+TelemetryCapture telemetryCapture = TelemetryCapture(96 * 1024); // ~7s of 1 kHz leg samples
 
 
 // ---------------
@@ -60,7 +83,6 @@ Lcd lcd = Lcd(lowPowerSwitch, battery);
 // ADC
 Adafruit_ADS1115 ads1115; // adc converter
 
-uint32_t adsTimer;
 uint8_t currentAds = 0;
 int16_t sliderLL;
 int16_t sliderLA;
@@ -72,7 +94,6 @@ void readADS();
 // BATTERY
 int8_t batteryPercent;
 RunningMedian batterySamples = RunningMedian(64);
-uint32_t batteryAlarmTimer = 0;
 bool chargingState = false;
 
 void setModemSleep();
@@ -82,71 +103,29 @@ void updateBattery();
 
 // DATA ESPNOW
 
-uint32_t dataTimer = 0;
+bool sendWanted = false; // by checkButtons(), in the modes that stream to the leg
 // mac address of robot
 uint8_t robotAddress[] = {0x94, 0xE6, 0x86, 0x00, 0xE0, 0xD0};
-typedef struct struct_data_in
-{
-  double kP;
-  double kI;
-  double kD;
-
-  double rInput;
-  double lInput;
-
-} struct_data_in;
-
-double kP = 0.2;
-double kI = 0;
-double kD = 0;
-
-struct_data_in dataIn;
-
-// data out:
-
-typedef struct struct_data_out
-{
-  int16_t joystickLX;
-  int16_t joystickLY;
-  int16_t joystickRX;
-  int16_t joystickRY;
 
-  int16_t sliderLL;
-  int16_t sliderLA;
-  int16_t sliderRL;
-  int16_t sliderRA;
+float kP = 0.2;
+float kI = 0;
+float kD = 0;
 
-  int16_t encoderPos;
-  bool encoderSwDown;
-
-  char key;
-
-  int8_t batteryPercent;
-
-  double kP;
-  double kI;
-  double kD;
-
-  double lP;
-  double lI;
-  double lD;
-
-  uint16_t rTargetPositionDegrees;
-  uint16_t lTargetPositionDegrees;
-
-} struct_data_out;
+// packet layouts live in shared/Protocol
+struct_leg_data dataIn;
 
 uint16_t rTargetPositionDegrees = 180;
 uint16_t lTargetPositionDegrees = 180;
 
-struct_data_out dataOut;
+struct_remote_data dataOut;
 
-esp_now_peer_info_t peerInfo;
+EspNowTransport transport;
 bool lastPackageSuccess = false;
 
 void prepareData();
 void sendData();
-void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status);
+void sendJob(void *);
+void OnDataSent(const uint8_t *mac_addr, bool delivered);
 void OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int len);
 
 // ENCODER
@@ -176,13 +155,28 @@ Keypad_I2C keypad(makeKeymap(hexaKeys), rowPins, colPins, ROWS, COLS,
 
 void checkButtons();
 
+// INPUT TAKES
+
+// the sliders, joysticks and keys can be recorded and played back through the
+// same pipeline: 'B' records and 'C' replays in slider mode, or over serial,
+// any key during a replay takes the remote back
+InputRecorder inputRecorder;
+uint16_t joystickLX; // raw analogRead()
+uint16_t joystickLY;
+uint16_t joystickRX;
+uint16_t joystickRY;
+char keyPressed = NO_KEY; // this loop's, live or replayed
+
+void updateInputs();
+void startReplay();
 
 
 enum remoteModes
 {
   poseMode,
   sliderMode,
-  moveMode
+  moveMode,
+  cueMode
 };
 
 remoteModes remoteMode = poseMode;
@@ -197,44 +191,48 @@ void updateLED();
 
 // MOVES
 
-uint32_t moveTimer = 0;
+// moveList and the keyframes of every move live in shared/Choreography,
+// a show loaded into flash replaces them by name
+moveList move = stop;
+ShowStore showStore;
+TimelineLibrary sequenceLibrary = TimelineLibrary(sequences, MOVE_COUNT);
+TimelinePlayer timelinePlayer = TimelinePlayer(sequenceLibrary);
+int16_t moveIndex[MOVE_COUNT]; // in sequenceLibrary, -1 = not in the show
+
+void loadSequences();
+moveList moveOf(int16_t index);
+void startMove(moveList theMove, uint32_t offset = 0, bool immediate = false);
+void startCue(const char *name);
+void cueGo();
+void updateMoves();
 
-enum moveList
-{
-  stop,
-  relax,
-  stand,
-  walk,
-  walkLarge,
-  pirouette,
-  acroyogaSequence,
-  jump,
-  flip,
-  musicSequence0,
-  musicSequence1,
-  musicSequence2,
-  musicSequence3,
-  musicSequence4,
-  musicSequence5,
-  musicSequence6,
-  musicSequence7,
-  musicSequence8,
-  musicSequence9,
-  textSequence0,
-  textSequence1,
-};
+// MUSIC CLOCK
 
-moveList move = stop;
+// timelines play on show time, which follows the music's tempo: the encoder
+// nudges it and 'D' taps the beat in move and cue mode
+const float TEMPO_NUDGE = 0.5; // bpm per encoder step
 
-void startMove(moveList);
-void updateMoves();
-bool moveTimePassed(u32_t time);
+void checkTempo(char keyInput);
 
-// POSITIONS
+// LEG PLAYBACK
 
-uint16_t forwardLimit = 90;
-uint16_t backwardLimit = 270;
+// once the leg has the library, moves play on the leg and only a playback
+// command goes out, repeated as a heartbeat
+TimelineUpload timelineUpload = TimelineUpload(sequenceLibrary);
+const uint32_t PLAYBACK_LEAD = 30;       // ms between sending a start and the start
+const uint32_t PLAYBACK_HEARTBEAT = 100; // ms
+bool legPlayback = false;
+struct_playback playbackOut;
+uint32_t playbackTimer = 0;
+bool uploadSlot = false;
+uint16_t playbackClockVersion = 0;
 
+void preparePlayback(uint8_t command, int16_t timeline, uint32_t startAt, uint32_t position);
+bool sendPlayback();
+
+// POSITIONS
+
+// forwardLimit and backwardLimit live in shared/Choreography
 uint16_t withinLimits(uint16_t position);
 void pBow(int16_t upperBodyDegrees = 45);
 void pStand();
@@ -244,9 +242,43 @@ void pKickRight(int8_t degrees);
 void pKickLeft(int8_t degrees);
 
 // PRINT
-uint32_t printTimer = 0;
+const uint32_t SERIAL_BAUD = 921600;
+BinaryLog binaryLog;
 
 void printAll();
+void checkSerialCommands();
+void reportJob(uint8_t job, const struct_job_stats &stats);
+
+// PROFILER
+
+// cycle counts of every stage of loop(), build with -D LOOP_PROFILER; the
+// leg's arrive in dataIn either way, 'l' logs both
+#ifdef LOOP_PROFILER
+LoopProfiler loopProfiler(remoteZoneNames, REMOTE_ZONE_COUNT);
+#endif
+// and -D TRACE_EVENTS, 'x' dumps the trace ring to the log
+struct_profile_stats legProfile[LEG_ZONE_COUNT];
+
+void logProfile(uint16_t id, const struct_profile_stats *stats, uint8_t zones);
+
+// HEAP
+
+// -D HEAP_MONITOR (env:debug) counts the allocations of every task; loop()
+// may not make any once the steady job has run, and the report job logs the
+// counts, the free heap and every task's stack high-water mark
+#ifdef HEAP_MONITOR
+const uint32_t HEAP_STEADY_DELAY = 2000000; // us, the scheduler's timer and WiFi are up by then
+const uint32_t HEAP_REPORT_INTERVAL = 5000000;
+
+void heapSteadyJob(void *);
+void heapReportJob(void *);
+#endif
+
+// LOOP
+void pollJob(void *);
+void lcdJob(void *);
+void batteryJob(void *);
+void takesJob(void *);
 
 // END FORWARD DECLARATIONS
 // **********************************
@@ -259,6 +291,11 @@ void setup()
   buzzer.init();
   lowPowerSwitch.init();
   lcd.init();
+  telemetryCapture.init();
+  showStore.init();
+  inputRecorder.init();
+  loadSequences();
+  dataIn.playingTimeline = -1;
 
 
   lcd.turnModeOn(Lcd::BATTERY);
@@ -270,7 +307,8 @@ void setup()
 
   pinMode(ENCODER_SW, INPUT_PULLUP);
 
-  Serial.begin(115200);
+  Serial.setRxBufferSize(1024); // room for a show load block
+  Serial.begin(SERIAL_BAUD);
   Serial.println("remote is connected to serial");
 
   Wire.begin();
@@ -290,24 +328,36 @@ void setup()
 
   WiFi.mode(WIFI_MODE_STA);
 
-  WiFi.mode(WIFI_STA);
-  if (esp_now_init() != ESP_OK)
+  if (!transport.begin())
   {
     Serial.println("Error initializing ESP-NOW");
     return;
   }
 
   // data sent&receive callback
-  esp_now_register_send_cb(OnDataSent);
-  esp_now_register_recv_cb(OnDataRecv);
+  transport.onSent(OnDataSent);
+  transport.onReceive(OnDataRecv);
 
   // register peer
-  memcpy(peerInfo.peer_addr, robotAddress, 6);
-  peerInfo.channel = 0;
-  peerInfo.encrypt = false;
-
-  bool isPeerRegistered = esp_now_add_peer(&peerInfo) != ESP_OK;
+  bool isPeerRegistered = !transport.addPeer(robotAddress);
   Serial.println(isPeerRegistered ? "Failed to add peer" : "setup done");
+
+  binaryLog.startTask(Serial);
+
+  // name, function, context, priority, period, deadline, budget (us)
+  scheduler.add({"send", sendJob, nullptr, 3, 2000, 1000, 500});
+  scheduler.add({"poll", pollJob, nullptr, 2, 1000, 0, 800});
+  scheduler.add({"lcd", lcdJob, nullptr, 0, 200000, 0, 10000});
+  scheduler.add({"battery", batteryJob, nullptr, 0, 600000, 0, 100});
+  // erases ahead for the next input take, a sector at a time while idle
+  scheduler.add({"takes", takesJob, nullptr, 0, 50000, 0, 0});
+  scheduler.onReport(reportJob);
+
+#ifdef HEAP_MONITOR
+  heapMonitor.watch();
+  scheduler.start(scheduler.add({"heapSteady", heapSteadyJob, nullptr, 0, 0, 0, 0}), HEAP_STEADY_DELAY);
+  scheduler.add({"heap", heapReportJob, nullptr, 0, HEAP_REPORT_INTERVAL, 0, 2000});
+#endif
 }
 
 //**********************************
@@ -315,17 +365,24 @@ void setup()
 
 void loop()
 {
-  // TODO test duration of loop
+  scheduler.run();
+}
+
+// the inputs, modes and serial, every millisecond
+void pollJob(void *)
+{
+  PROFILE_TICK(loopProfiler, REMOTE_ZONE_LOOP);
 
-  battery.update();
+  PROFILE(loopProfiler, REMOTE_ZONE_BATTERY, battery.update());
 
-  updateEncoder(); // update encoder pos, and buzzFor encoder up/down bools for one
-                   // loop
-  buzzer.update();  // play buzzer if buzzertimer is high
+  // update encoder pos, and buzzFor encoder up/down bools for one loop
+  PROFILE(loopProfiler, REMOTE_ZONE_ENCODER, updateEncoder());
   lcd.update();
-  lowPowerSwitch.update();
-  updateLED();
-  readADS();
+  PROFILE(loopProfiler, REMOTE_ZONE_SWITCH, lowPowerSwitch.update());
+  PROFILE(loopProfiler, REMOTE_ZONE_CUE_LIST, cueList.update(sequenceLibrary));
+  PROFILE(loopProfiler, REMOTE_ZONE_LED, updateLED());
+  PROFILE(loopProfiler, REMOTE_ZONE_ADS, readADS());
+  PROFILE(loopProfiler, REMOTE_ZONE_INPUTS, updateInputs());
 
   // in slider mode, send continuously.
   // if (lcdSlider){
@@ -333,7 +390,7 @@ void loop()
   //   sendData();
   // }
 
-  checkButtons();
+  PROFILE(loopProfiler, REMOTE_ZONE_BUTTONS, checkButtons());
 
   if (encoderUp)
   {
@@ -350,8 +407,44 @@ void loop()
     buzzer.buzzFor(50);
   }
 
-  // printAll();
+  PROFILE(loopProfiler, REMOTE_ZONE_SERIAL, checkSerialCommands());
+  telemetryCapture.drain(binaryLog);
+#ifdef TRACE_EVENTS
+  traceRing.drain(binaryLog);
+#endif
+}
+
+void lcdJob(void *)
+{
+  PROFILE(loopProfiler, REMOTE_ZONE_LCD, lcd.draw());
+}
+
+void batteryJob(void *)
+{
+  battery.alarm();
+}
+
+void takesJob(void *)
+{
+  inputRecorder.erase();
+}
+
+void reportJob(uint8_t job, const struct_job_stats &stats)
+{
+  binaryLog.log(LOG_REMOTE_JOB, job, stats.misses, stats.overruns, stats.maxRun, stats.maxLate);
+}
+
+#ifdef HEAP_MONITOR
+void heapSteadyJob(void *)
+{
+  heapMonitor.steady();
+}
+
+void heapReportJob(void *)
+{
+  heapMonitor.report(binaryLog);
 }
+#endif
 
 //**********************************
 // MARK: -FUNCTIONS
@@ -363,6 +456,7 @@ void readADS()
 {
   // based on
   // https://github.com/adafruit/Adafruit_ADS1X15/blob/master/examples/nonblocking/nonblocking.ino
+  TRACE_SCOPE(TRACE_I2C_ADS);
 
   if (!ads1115.conversionComplete())
   {
@@ -408,10 +502,10 @@ void prepareData()
 
   // todo: correct for middle position
 
-  uint16_t joyCorrectedLX = 4095 - analogRead(JOYSTICK_L_X); // invert scale
-  uint16_t joyCorrectedLY = analogRead(JOYSTICK_L_Y);
-  uint16_t joyCorrectedRX = analogRead(JOYSTICK_R_X);
-  uint16_t joyCorrectedRY = 4095 - analogRead(JOYSTICK_R_Y); // invert scale
+  uint16_t joyCorrectedLX = 4095 - joystickLX; // invert scale
+  uint16_t joyCorrectedLY = joystickLY;
+  uint16_t joyCorrectedRX = joystickRX;
+  uint16_t joyCorrectedRY = 4095 - joystickRY; // invert scale
 
   uint16_t joyCenterLX = 2225; // unflipped: 1870
   uint16_t joyCenterLY = 1860;
@@ -459,46 +553,68 @@ void prepareData()
   dataOut.joystickRX = joyCorrectedRX;
   dataOut.joystickRY = joyCorrectedRY;
 
-  // ads1115 is very slow, only process every 100ms...
-  // if ( adsTimer < millis()){
+  // the last of readADS()'s non-blocking conversions
   dataOut.sliderLL = sliderLL;
   dataOut.sliderLA = sliderLA;
   dataOut.sliderRL = sliderRL;
   dataOut.sliderRA = sliderRA;
-  //   adsTimer = millis() + 5000;
-  // }
 
   dataOut.encoderPos = encoderPos;
   dataOut.encoderSwDown = encoderSwDown;
 
   dataOut.batteryPercent = batteryPercent;
 
-  dataOut.kP = kP;
-  dataOut.kI = kI;
-  dataOut.kD = kD;
+  dataOut.rP = kP;
+  dataOut.rI = kI;
+  dataOut.rD = kD;
 
   dataOut.rTargetPositionDegrees = rTargetPositionDegrees;
   dataOut.lTargetPositionDegrees = lTargetPositionDegrees;
 }
 
+// every 2 ms
+void sendJob(void *)
+{
+  if (!sendWanted)
+  {
+    return;
+  }
+  sendWanted = false;
+  PROFILE(loopProfiler, REMOTE_ZONE_SEND, sendData());
+}
+
 void sendData()
 {
-  if (dataTimer >= millis())
+  if (sendPlayback())
   {
     return;
   }
-  // send once every 2 ms.
-  esp_now_send(robotAddress, (uint8_t *)&dataOut, sizeof(dataOut));
-  dataTimer = millis() + 2;
+
+  // every other packet goes to the upload until the leg has the library
+  uploadSlot = !uploadSlot;
+  if (uploadSlot && !timelineUpload.isDone(dataIn))
+  {
+    uint8_t message[TRANSPORT_MAX_DATA_LEN];
+    size_t len = timelineUpload.prepare(dataIn, millis(), message);
+    TRACE(TRACE_RADIO_SEND, transport.send(robotAddress, message, len));
+    return;
+  }
+
+  dataOut.header = {MSG_CONTROL, millis()};
+  TRACE(TRACE_RADIO_SEND, transport.send(robotAddress, (uint8_t *)&dataOut, sizeof(dataOut)));
 };
 
 // Callback when data is sent
-void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status)
+void OnDataSent(const uint8_t *mac_addr, bool delivered)
 {
+  TRACE_SCOPE(TRACE_RADIO_SENT);
   // Serial.print("\r\nLast Packet Send Status:\t");
-  // Serial.println(status == ESP_NOW_SEND_SUCCESS ? "Delivery Success" :
-  // "Delivery Fail");
-  lastPackageSuccess = status == ESP_NOW_SEND_SUCCESS;
+  // Serial.println(delivered ? "Delivery Success" : "Delivery Fail");
+  lastPackageSuccess = delivered;
+  if (!delivered)
+  {
+    TRACE_MARK(TRACE_RADIO_LOST);
+  }
 
   // Note that too short interval between sending two ESP-NOW data may lead to
   // disorder of sending callback function. So, it is recommended that sending
@@ -509,18 +625,33 @@ void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status)
 
 void OnDataRecv(const uint8_t *mac, const uint8_t *incomingData, int len)
 {
+  TRACE_SCOPE(TRACE_RADIO_RECEIVE);
+  if (len < (int)sizeof(dataIn))
+  {
+    return;
+  }
   memcpy(&dataIn, incomingData, sizeof(dataIn));
-  Serial.print("Bytes received: ");
-  Serial.println(len);
+  if (dataIn.profile.zone < LEG_ZONE_COUNT)
+  {
+    legProfile[dataIn.profile.zone] = dataIn.profile;
+  }
+
+  // anything behind dataIn is a batch of leg telemetry samples
+  if (len > (int)sizeof(dataIn))
+  {
+    telemetryCapture.store(incomingData + sizeof(dataIn), len - sizeof(dataIn));
+  }
+
+  binaryLog.log(LOG_REMOTE_RECEIVED, len, dataIn.rInput * 10, dataIn.lInput * 10);
 
   // only after boot
   if (millis() >= 1000)
   {
     return;
   }
-  kP = dataIn.kP;
-  kI = dataIn.kI;
-  kD = dataIn.kD;
+  kP = dataIn.rP;
+  kI = dataIn.rI;
+  kD = dataIn.rD;
 }
 
 // -----------------------
@@ -545,6 +676,10 @@ uint8_t encoderPIDSelection = 0;
 
 void encoderPID()
 {
+  if (remoteMode == moveMode || remoteMode == cueMode)
+  {
+    return; // the encoder sets the tempo there
+  }
 
   // ENCODER MODE STUFF, TODO: FIX ME
 
@@ -564,15 +699,15 @@ void encoderPID()
   {
     if (encoderPIDSelection == 0)
     {
-      kP += 0.2;
+      kP += 0.2f;
     }
     if (encoderPIDSelection == 1)
     {
-      kI += 0.2;
+      kI += 0.2f;
     }
     if (encoderPIDSelection == 2)
     {
-      kD += 0.2;
+      kD += 0.2f;
     }
   }
 
@@ -580,18 +715,18 @@ void encoderPID()
   {
     if (encoderPIDSelection == 0)
     {
-      kP -= 0.2;
-      kP = max(kP, 0.);
+      kP -= 0.2f;
+      kP = max(kP, 0.f);
     }
     if (encoderPIDSelection == 1)
     {
-      kI -= 0.2;
-      kI = max(kI, 0.);
+      kI -= 0.2f;
+      kI = max(kI, 0.f);
     }
     if (encoderPIDSelection == 2)
     {
-      kD -= 0.2;
-      kD = max(kD, 0.);
+      kD -= 0.2f;
+      kD = max(kD, 0.f);
     }
   }
 }
@@ -602,8 +737,9 @@ void encoderPID()
 void checkButtons()
 {
 
-  char keyInput = keypad.getKey();
+  char keyInput = keyPressed;
   dataOut.key = keyInput;
+  remoteModes previousMode = remoteMode;
 
   if (keyInput == '1')
   {
@@ -631,6 +767,52 @@ void checkButtons()
     startMove(textSequence0);
   }
 
+  // the encoder switch changes between move and cue mode
+  if (encoderSwPressed && remoteMode == moveMode)
+  {
+    remoteMode = cueMode;
+  }
+  else if (encoderSwPressed && previousMode == cueMode && remoteMode == cueMode)
+  {
+    remoteMode = moveMode;
+  }
+
+  if (remoteMode == cueMode && previousMode != cueMode)
+  {
+    cueList.reset();
+    lcd.turnModeOn(Lcd::CUES);
+  }
+  if (remoteMode != cueMode && previousMode == cueMode)
+  {
+    musicClock.hold(millis(), false);
+    lcd.turnModeOff(Lcd::CUES);
+  }
+
+  if (remoteMode == cueMode)
+  {
+    // GO, BACK and hold
+    if (keyInput == '#')
+    {
+      cueGo();
+    }
+
+    if (keyInput == '*')
+    {
+      cueList.back();
+    }
+
+    if (keyInput == '0')
+    {
+      musicClock.hold(millis(), !musicClock.isHeld());
+    }
+
+    checkTempo(keyInput);
+
+    PROFILE(loopProfiler, REMOTE_ZONE_MOVES, updateMoves());
+    prepareData();
+    sendWanted = true;
+  }
+
   if (remoteMode == poseMode)
   {
     if (keyInput == '0')
@@ -668,7 +850,7 @@ void checkButtons()
     //   if (keyInput != NO_KEY)
     //   {
     //     prepareData();
-    //     sendData();
+    //     sendWanted = true;
     //   }
     // }
   }
@@ -680,7 +862,7 @@ void checkButtons()
     rTargetPositionDegrees =
         map(sliderRL, 0, 17620, backwardLimit, forwardLimit);
     prepareData();
-    sendData();
+    sendWanted = true;
   }
 
   if (remoteMode == moveMode)
@@ -723,10 +905,11 @@ void checkButtons()
 
     if (keyInput == 'C')
     {
-      move = musicSequence6;
-      moveTimer = millis() - 51000;
+      startCue("rehearsal");
     }
 
+    checkTempo(keyInput);
+
     if (keyInput == '*')
     {
       startMove(musicSequence0);
@@ -747,12 +930,68 @@ void checkButtons()
       startMove(textSequence0);
     }
 
-    updateMoves();
+    PROFILE(loopProfiler, REMOTE_ZONE_MOVES, updateMoves());
     prepareData();
-    sendData();
+    sendWanted = true;
+  }
+}
+
+
+// --------------------------------
+// MARK: - Input takes
+
+void updateInputs()
+{
+  char key;
+  TRACE(TRACE_I2C_KEYPAD, key = keypad.getKey());
+  struct_input_sample sample = {{sliderRA, sliderRL, sliderLL, sliderLA,
+                                 (int16_t)analogRead(JOYSTICK_L_X), (int16_t)analogRead(JOYSTICK_L_Y),
+                                 (int16_t)analogRead(JOYSTICK_R_X), (int16_t)analogRead(JOYSTICK_R_Y)},
+                                key};
+
+  // the keys that control takes are not part of one
+  TakeState state = inputRecorder.getState();
+  if (remoteMode == sliderMode && sample.key == 'B' && state != TAKE_REPLAYING)
+  {
+    if (state == TAKE_RECORDING)
+    {
+      inputRecorder.stop(binaryLog);
+    }
+    else
+    {
+      inputRecorder.record(millis(), remoteMode, binaryLog);
+    }
+    sample.key = NO_KEY;
   }
+  if (remoteMode == sliderMode && sample.key == 'C' && state == TAKE_IDLE)
+  {
+    startReplay();
+    sample.key = NO_KEY;
+  }
+
+  inputRecorder.update(millis(), sample, binaryLog);
+
+  sliderRA = sample.channels[0];
+  sliderRL = sample.channels[1];
+  sliderLL = sample.channels[2];
+  sliderLA = sample.channels[3];
+  joystickLX = sample.channels[4];
+  joystickLY = sample.channels[5];
+  joystickRX = sample.channels[6];
+  joystickRY = sample.channels[7];
+  keyPressed = sample.key;
 }
 
+void startReplay()
+{
+  if (!inputRecorder.replay(millis(), binaryLog))
+  {
+    buzzer.buzzFor(200); // no take
+    return;
+  }
+  // from the mode it was recorded in, so the keys mean the same
+  remoteMode = (remoteModes)inputRecorder.getMode();
+}
 
 // --------------------------------
 // MARK: - Led
@@ -819,2219 +1058,202 @@ void updateLED()
 // --------------
 // MARK: - Moves
 
-void startMove(moveList theMove)
+void loadSequences()
 {
-  move = theMove;
-  moveTimer = millis();
-}
+  sequenceLibrary = TimelineLibrary(sequences, MOVE_COUNT);
+  bool fromFlash = showStore.load(sequenceLibrary);
 
-void updateMoves()
-{
-  if (move == relax)
+  // resolved once, so starting a move is a table lookup
+  for (uint8_t i = 0; i < MOVE_COUNT; i++)
   {
-    kP = 0;
+    moveIndex[i] = sequenceLibrary.find(sequences[i].name);
   }
+  timelineUpload.init();
+  cueList.reset();
 
-  if (move == stop)
-  {
-    kP = 2;
-    lTargetPositionDegrees = dataIn.lInput;
-    rTargetPositionDegrees = dataIn.rInput;
+  // a record, not text: after a show load the log task is writing frames
+  binaryLog.log(LOG_REMOTE_SHOW, fromFlash, sequenceLibrary.getSize(), timelineUpload.getSize());
+}
 
-    // round to even
-    lTargetPositionDegrees = (lTargetPositionDegrees / 2) * 2;
-    rTargetPositionDegrees = (rTargetPositionDegrees / 2) * 2;
+moveList moveOf(int16_t index)
+{
+  if (index >= 0 && index < MOVE_COUNT && moveIndex[index] == index)
+  {
+    return (moveList)index; // the usual case, same order as the built-in ones
   }
-
-  if (move == stand)
+  for (uint8_t i = 0; i < MOVE_COUNT; i++)
   {
-    pStand();
-    kP = 0.6;
-    if (moveTimePassed(300))
-    {
-      kP = 1;
-    }
-    if (moveTimePassed(600))
+    if (moveIndex[i] == index)
     {
-      kP = 1.5;
-    }
-    if (moveTimePassed(1000))
-    {
-      kP = 2;
+      return (moveList)i;
     }
   }
+  return MOVE_COUNT;
+}
+
+void startMove(moveList theMove, uint32_t offset, bool immediate)
+{
+  // offset starts the move part way through, e.g. to rehearse a section
+  move = theMove;
+  struct_timeline_state from = {(float)rTargetPositionDegrees, (float)lTargetPositionDegrees, kP};
 
-  if (move == walk)
+  // stop and relax follow the remote, anything else plays on the leg if it can
+  uint32_t startAt = millis();
+  const struct_tempo_map *tempo = findTempoMap(theMove);
+  if (tempo)
   {
-    kP = 1.4;
-    pStepRight(20);
-    if (moveTimePassed(800))
-    {
-      pStepLeft(20);
-    }
-    if (moveTimePassed(1600))
-    {
-      startMove(walk);
-    }
+    musicClock.setTempoMap(tempo->reference, tempo->changes, tempo->count);
+  }
+  else
+  {
+    musicClock.setTempoMap(0);
+  }
+  legPlayback = theMove != stop && theMove != relax && moveIndex[theMove] >= 0 &&
+                lastPackageSuccess && timelineUpload.getCrc() &&
+                dataIn.timelineCrc == timelineUpload.getCrc();
+  if (legPlayback && !immediate)
+  {
+    startAt += PLAYBACK_LEAD;
+  }
+  // show time equals millis() at the start
+  musicClock.begin(startAt, offset);
+  if (legPlayback)
+  {
+    preparePlayback(PLAYBACK_START, moveIndex[theMove], startAt, offset);
   }
 
-  if (move == jump)
+  // the local player keeps running as a mirror, for the targets on the lcd
+  if (offset)
+  {
+    timelinePlayer.seek(moveIndex[theMove], offset, startAt, from);
+  }
+  else
   {
-    kP = 1.4;
-    pStand();
+    timelinePlayer.start(moveIndex[theMove], startAt, from);
+  }
+}
 
-    if (moveTimePassed(2000))
-    {
-      kP = 0.6;
-      pBow(45);
-    }
-    if (moveTimePassed(3000))
-    {
-      kP = 4;
-      pBow(-10);
-    }
-    if (moveTimePassed(3800))
-    {
-      kP = 2;
-      pBow(10);
-    }
-    if (moveTimePassed(6000))
-    {
-      kP = 0.8;
-      pStand();
-    }
+void startCue(const char *name)
+{
+  const struct_cue *cue = findCue(name);
+  if (cue)
+  {
+    startMove(cue->move, cue->position);
   }
+}
 
-  if (move == flip)
+void cueGo()
+{
+  const struct_cue *cue = cueList.go();
+  if (!cue)
   {
-    kP = 1.4;
-    pStand();
+    buzzer.buzzFor(200);
+    return;
+  }
+  // no lead, the leg catches up with the cue's start time when the command
+  // arrives
+  startMove(cue->move, cue->position, true);
+}
 
-    if (moveTimePassed(2000))
-    {
-      kP = 1;
-      pBow(15);
-    }
-    if (moveTimePassed(3000))
-    {
-      kP = 2;
-      pStand();
-    }
-    if (moveTimePassed(3300))
-    {
-      kP = 3;
-      pKickRight(90);
-    }
-    if (moveTimePassed(3500))
-    {
-      kP = 2;
-      pStepRight(90);
-    }
-    if (moveTimePassed(4300))
-    {
-      kP = 1.5;
-      pBow(20);
-    }
-    if (moveTimePassed(5500))
-    {
-      kP = 1.5;
-      pStand();
-    }
+void preparePlayback(uint8_t command, int16_t timeline, uint32_t startAt, uint32_t position)
+{
+  playbackOut.command = command;
+  playbackOut.sequence++;
+  playbackOut.timeline = timeline;
+  playbackOut.startAt = startAt;
+  playbackOut.position = position;
+  playbackTimer = millis(); // due now
+}
+
+void checkTempo(char keyInput)
+{
+  if (encoderUp)
+  {
+    musicClock.nudge(TEMPO_NUDGE, millis());
+  }
+  if (encoderDown)
+  {
+    musicClock.nudge(-TEMPO_NUDGE, millis());
+  }
+  if (keyInput == 'D')
+  {
+    musicClock.tap(millis());
   }
+}
 
-  if (move == pirouette)
+bool sendPlayback()
+{
+  if (remoteMode != moveMode && remoteMode != cueMode)
   {
-    kP = 1.4;
-    pStand();
+    legPlayback = false;
+  }
 
-    if (moveTimePassed(2000))
-    {
-      kP = 3;
-      rTargetPositionDegrees = 200;
-      lTargetPositionDegrees = 170;
-    }
-    if (moveTimePassed(3000))
-    {
-      kP = 2;
-      pKickRight(90);
-    }
-    if (moveTimePassed(3450))
+  if (!legPlayback)
+  {
+    if (dataIn.playingTimeline < 0)
     {
-      kP = 2;
-      pBow(10);
+      return false;
     }
-    if (moveTimePassed(3800))
+    // the leg still plays, but the remote should be in control
+    if (playbackOut.command != PLAYBACK_STOP)
     {
-      kP = 1.8;
-      pStand();
+      preparePlayback(PLAYBACK_STOP, -1, millis(), 0);
     }
   }
 
-  if (move == acroyogaSequence)
+  // a new tempo goes out at once
+  if (musicClock.getVersion() != playbackClockVersion)
   {
-    kP = 1.4;
-    pStand();
+    playbackClockVersion = musicClock.getVersion();
+    playbackOut.clockAt = musicClock.getAnchor();
+    playbackOut.clockShow = musicClock.getAnchorShow();
+    playbackOut.rate = musicClock.getRate();
+    playbackTimer = millis();
+  }
 
-    uint32_t moveTime = 0;
+  // faster until the leg has started or stopped, so one lost packet does not
+  // delay it
+  // wrap-safe, millis() rolls over after 49 days
+  uint32_t now = millis();
+  if ((int32_t)(now - playbackTimer) >= 0)
+  {
+    playbackOut.header = {MSG_PLAYBACK, now};
+    transport.send(robotAddress, (uint8_t *)&playbackOut, sizeof(playbackOut));
+    bool started = legPlayback && (int32_t)(now - playbackOut.startAt) >= 0;
+    playbackTimer = now + (started ? PLAYBACK_HEARTBEAT : 10);
+  }
+  return true;
+}
 
-    // fall to bird
-    if (moveTimePassed(moveTime += 3000))
-    {
-      kP = 1.8;
-      pBow(25);
-    }
+void updateMoves()
+{
+  if (move == relax)
+  {
+    kP = 0;
+  }
 
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 1.2;
-      pBow(15);
-    }
-    if (moveTimePassed(moveTime += 2000))
-    {
-      kP = 2;
-      pStand();
-    }
+  if (move == stop)
+  {
+    kP = 2;
+    lTargetPositionDegrees = dataIn.lInput;
+    rTargetPositionDegrees = dataIn.rInput;
 
-    // swimming
-    if (moveTimePassed(moveTime += 4500))
-    {
-      kP = 2;
-      pKickRight(-20);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 2;
-      pKickLeft(-20);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 2;
-      pKickRight(-20);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 2;
-      pKickLeft(-20);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 2;
-      pKickRight(-20);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 2;
-      pKickLeft(-20);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-
-    // cloth hanger
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 1.6;
-      pStand();
-    }
-    if (moveTimePassed(moveTime += 3000))
-    {
-      kP = 0.3;
-      pBow(90);
-    }
-    if (moveTimePassed(moveTime += 5000))
-    {
-      kP = 2;
-      pBow(76);
-    }
-
-    // kick naar bolkje
-
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 1.2;
-      pKickRight(90);
-    }
-    if (moveTimePassed(moveTime += 1500))
-    {
-      kP = 0.7;
-      pStepRight(75);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 1;
-      pStepRight(60);
-    }
-    if (moveTimePassed(moveTime += 500))
-    {
-      kP = 1.2;
-      pStepRight(50);
-    }
-    if (moveTimePassed(moveTime += 500))
-    {
-      kP = 1;
-      pStepRight(35);
-    }
-    if (moveTimePassed(moveTime += 500))
-    {
-      kP = 1.8;
-      pStepRight(10);
-    }
-
-    // swim in bolk
-
-    if (moveTimePassed(moveTime += 1500))
-    {
-      kP = 1;
-      pStepLeft(10);
-    }
-    if (moveTimePassed(moveTime += 1500))
-    {
-      kP = 1;
-      pStepRight(10);
-    }
-    if (moveTimePassed(moveTime += 800))
-    {
-      kP = 1.2;
-      pStepLeft(10);
-    }
-    if (moveTimePassed(moveTime += 800))
-    {
-      kP = 1.2;
-      pStepRight(10);
-    }
-
-    // to knees
-    if (moveTimePassed(moveTime += 4000))
-    {
-      kP = 1;
-      pStepLeft(10);
-    }
-
-    if (moveTimePassed(moveTime += 800))
-    {
-      kP = 0.5;
-      pStepLeft(45);
-    }
-    if (moveTimePassed(moveTime += 800))
-    {
-      kP = 0.5;
-      pStepLeft(75);
-    }
-    if (moveTimePassed(moveTime += 800))
-    {
-      kP = 0.7;
-      pStepLeft(90);
-    }
-    if (moveTimePassed(moveTime += 3000))
-    {
-      kP = 0.5;
-      pKickRight(90);
-    }
-    if (moveTimePassed(moveTime += 1500))
-    {
-      kP = 0.6;
-      pBow(90);
-    }
-
-    // back to bird
-
-    if (moveTimePassed(moveTime += 3000))
-    {
-      kP = 1.4;
-      pKickRight(45);
-    }
-    if (moveTimePassed(moveTime += 500))
-    {
-      kP = 1.4;
-      pKickRight(90);
-    }
-    if (moveTimePassed(moveTime += 2500))
-    {
-      kP = 1;
-      pStand();
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 2.2;
-      pStand();
-    }
-
-    // back to standing
-    if (moveTimePassed(moveTime += 6000))
-    {
-      kP = 2;
-      pBow(15);
-    }
-
-    if (moveTimePassed(moveTime += 10000))
-    {
-      kP = 2;
-      pBow(10);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 1.8;
-      pBow(5);
-    }
-    if (moveTimePassed(moveTime += 1000))
-    {
-      kP = 1.6;
-      pStand();
-    }
-
-    // current total time: 76s
-    // Serial.print("acroyoga sequence total time: ");
-    // Serial.println(moveTime);
-  }
-
-  // --------------------------------
-  // MARK: - TEXT SEQUENCE 0
-
-  if (move == textSequence0)
-  {
-    kP = 0.6;
-    pBow(45);
-
-    if (moveTimePassed(7600))
-    {
-      kP = 0.2;
-      pStand();
-    }
-
-    // raise left
-    if (moveTimePassed(9250))
-    {
-      kP = 0.4;
-      pKickLeft(90);
-    }
-    if (moveTimePassed(9550))
-    {
-      kP = 0.6;
-      pKickLeft(90);
-    }
-    if (moveTimePassed(9950))
-    {
-      kP = 1;
-      pKickLeft(90);
-    }
-
-    // swing excited
-    if (moveTimePassed(19750))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 120;
-    }
-    if (moveTimePassed(20550))
-    {
-      kP = 0.8;
-      rTargetPositionDegrees = 220;
-    }
-    if (moveTimePassed(21190))
-    {
-      kP = 0.8;
-      rTargetPositionDegrees = 120;
-    }
-
-    if (moveTimePassed(29800))
-    {
-      kP = 1.2;
-      rTargetPositionDegrees = 90;
-    }
-
-    // lower left
-
-    if (moveTimePassed(37680))
-    {
-      kP = 0.2;
-      lTargetPositionDegrees = 180;
-    }
-
-    // swing left
-
-    if (moveTimePassed(41760))
-    {
-      kP = 0.8;
-      lTargetPositionDegrees = 120;
-    }
-
-    if (moveTimePassed(42350))
-    {
-      kP = 0.8;
-      lTargetPositionDegrees = 220;
-    }
-    if (moveTimePassed(43250))
-    {
-      kP = 0.2;
-      lTargetPositionDegrees = 180;
-    }
-
-    // left back
-
-    if (moveTimePassed(50830))
-    {
-      kP = 0.7;
-      lTargetPositionDegrees = 235;
-    }
-
-    if (moveTimePassed(56360))
-    {
-      kP = 0.2;
-      pStepRight(15);
-    }
-
-    // hello people bow
-
-    if (moveTimePassed(59920))
-    {
-      kP = 0.7;
-      pBow(60);
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(textSequence1);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - TEXT SEQUENCE 1 (+10s)
-
-  if (move == textSequence1)
-  {
-    kP = 0.8;
-    pBow(60);
-
-    // hello people bows
-
-    if (moveTimePassed(1500))
-    {
-      kP = 1.6;
-      pBow(90);
-    }
-
-    if (moveTimePassed(2860))
-    {
-      kP = 0.2;
-      pBow(70);
-    }
-
-    if (moveTimePassed(3305))
-    {
-      kP = 1.8;
-      pBow(90);
-    }
-
-    if (moveTimePassed(4500))
-    {
-      kP = 0.2;
-      pBow(70);
-    }
-
-    if (moveTimePassed(4900))
-    {
-      kP = 1.8;
-      pBow(90);
-    }
-
-    if (moveTimePassed(6150))
-    {
-      kP = 0.2;
-      pBow(70);
-    }
-
-    if (moveTimePassed(7070))
-    {
-      kP = 1.8;
-      pBow(90);
-    }
-
-    if (moveTimePassed(8080))
-    {
-      kP = 0.2;
-      pBow(70);
-    }
-
-    if (moveTimePassed(8700))
-    {
-      kP = 1.8;
-      pBow(90);
-    }
-
-    if (moveTimePassed(9880))
-    {
-      kP = 0.2;
-      pBow(70);
-    }
-
-    if (moveTimePassed(10600))
-    {
-      kP = 1.8;
-      pBow(90);
-    }
-
-    if (moveTimePassed(12560))
-    {
-      kP = 0.2;
-      pBow(70);
-    }
-
-    if (moveTimePassed(13640))
-    {
-      kP = 1.8;
-      pBow(90);
-    }
-
-    if (moveTimePassed(14680))
-    {
-      kP = 0.2;
-      pBow(70);
-    }
-
-    // wiggle
-
-    if (moveTimePassed(15800))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 90;
-      lTargetPositionDegrees = 60;
-    }
-
-    if (moveTimePassed(16130))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 60;
-      lTargetPositionDegrees = 90;
-    }
-
-    if (moveTimePassed(16430))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 90;
-      lTargetPositionDegrees = 60;
-    }
-
-    if (moveTimePassed(17680))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 60;
-      lTargetPositionDegrees = 90;
-    }
-
-    if (moveTimePassed(17940))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 90;
-      lTargetPositionDegrees = 60;
-    }
-
-    if (moveTimePassed(18230))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 60;
-      lTargetPositionDegrees = 90;
-    }
-
-    if (moveTimePassed(19090))
-    {
-      kP = 1.2;
-      pBow(90);
-    }
-
-    if (moveTimePassed(21700))
-    {
-      kP = 0.4;
-      pBow(15);
-    }
-
-    // but wait
-
-    if (moveTimePassed(56770))
-    {
-      kP = 1.8;
-      pBow(45);
-    }
-
-    if (moveTimePassed(58070))
-    {
-      kP = 0.2;
-      pStand();
-    }
-
-    if (moveTimePassed(61000))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    if (moveTimePassed(70000))
-    {
-      startMove(musicSequence0);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 0 intro
-
-  if (move == musicSequence0)
-  {
-
-    // bow
-    kP = 1;
-    pBow(10);
-
-    if (moveTimePassed(2200))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    // raise leg, walk.
-
-    if (moveTimePassed(6300))
-    {
-      kP = 1;
-      pKickRight(45);
-    }
-
-    if (moveTimePassed(8670))
-    {
-      kP = 1.4;
-      pStepRight(15);
-    }
-
-    if (moveTimePassed(9570))
-    {
-      kP = 1.4;
-      pStepLeft(15);
-    }
-
-    if (moveTimePassed(10560))
-    {
-      kP = 1.4;
-      pStepRight(15);
-    }
-
-    if (moveTimePassed(11470))
-    {
-      kP = 1.6;
-      pStand();
-    }
-
-    // raise leg, walk.
-
-    if (moveTimePassed(14600))
-    {
-      kP = 1.2;
-      pKickLeft(55);
-    }
-
-    if (moveTimePassed(16550))
-    {
-      kP = 1.4;
-      pStepLeft(20);
-    }
-
-    if (moveTimePassed(17600))
-    {
-      kP = 1.4;
-      pStepRight(20);
-    }
-
-    if (moveTimePassed(18650))
-    {
-      kP = 1.4;
-      pStepLeft(20);
-    }
-
-    if (moveTimePassed(19600))
-    {
-      kP = 1.6;
-      pStand();
-    }
-
-    // breathe
-
-    if (moveTimePassed(20700))
-    {
-      kP = 0.8;
-      pBow(15);
-    }
-
-    if (moveTimePassed(22800))
-    {
-      kP = 1;
-      pBow(4);
-    }
-
-    // walk, pirouette
-
-    if (moveTimePassed(24800))
-    {
-      kP = 1.4;
-      pStepRight(20);
-    }
-
-    if (moveTimePassed(25900))
-    {
-      kP = 1.4;
-      pStepLeft(20);
-    }
-
-    if (moveTimePassed(26900))
-    {
-      kP = 1.4;
-      pStepRight(20);
-    }
-
-    if (moveTimePassed(27900))
-    {
-      kP = 1.4;
-      pStepLeft(20);
-    }
-
-    if (moveTimePassed(28900))
-    {
-      kP = 1.8;
-      pStand();
-    }
-    // pirouette
-
-    if (moveTimePassed(29900))
-    {
-      kP = 3;
-      rTargetPositionDegrees = 200;
-      lTargetPositionDegrees = 170;
-    }
-
-    if (moveTimePassed(30900))
-    {
-      kP = 2;
-      pKickRight(90);
-    }
-    if (moveTimePassed(31350))
-    {
-      kP = 2;
-      pBow(10);
-    }
-    if (moveTimePassed(31700))
-    {
-      kP = 1.8;
-      pStand();
-    }
-
-    // breathe
-    if (moveTimePassed(32870))
-    {
-      kP = 0.8;
-      pBow(15);
-    }
-    if (moveTimePassed(34950))
-    {
-      kP = 1;
-      pBow(4);
-    }
-
-    // jump
-
-    if (moveTimePassed(37150))
-    {
-      kP = 0.6;
-      pBow(45);
-    }
-    if (moveTimePassed(38280))
-    {
-      kP = 4;
-      pBow(-10);
-    }
-    if (moveTimePassed(39000))
-    {
-      kP = 2;
-      pBow(10);
-    }
-    if (moveTimePassed(40200))
-    {
-      kP = 0.8;
-      pStand();
-    }
-
-    // step step flip
-    if (moveTimePassed(43550))
-    {
-      kP = 1.4;
-      pStepRight(20);
-    }
-
-    if (moveTimePassed(44600))
-    {
-      kP = 1.6;
-      pStepLeft(10);
-    }
-
-    if (moveTimePassed(45900))
-    {
-      kP = 3;
-      rTargetPositionDegrees = 90;
-      lTargetPositionDegrees = 190;
-    }
-
-    if (moveTimePassed(46100))
-    {
-      kP = 2;
-      pStepRight(90);
-    }
-
-    if (moveTimePassed(46900))
-    {
-      kP = 1.5;
-      pBow(20);
-    }
-
-    if (moveTimePassed(49840))
-    {
-      kP = 0.8;
-      pStand();
-    }
-
-    // again step step flip
-
-    if (moveTimePassed(54090))
-    {
-      kP = 1.4;
-      pStepRight(20);
-    }
-
-    if (moveTimePassed(55120))
-    {
-      kP = 1.6;
-      pStepLeft(10);
-    }
-
-    if (moveTimePassed(56500))
-    {
-      kP = 3;
-      rTargetPositionDegrees = 90;
-      lTargetPositionDegrees = 190;
-    }
-
-    if (moveTimePassed(56700))
-    {
-      kP = 2;
-      pStepRight(90);
-    }
-
-    if (moveTimePassed(57500))
-    {
-      kP = 1.5;
-      pBow(20);
-    }
-
-    if (moveTimePassed(58500))
-    {
-      kP = 0.8;
-      pStand();
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(musicSequence1);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 1 yoga
-
-  if (move == musicSequence1)
-  {
-
-    kP = 0.8;
-    pStand();
-
-    // bow
-
-    if (moveTimePassed(600))
-    {
-      kP = 0.5;
-      pBow(45);
-    }
-
-    if (moveTimePassed(3160))
-    {
-      kP = 0.8;
-      pStand();
-    }
-
-    // snoek
-
-    // fall to bird
-    if (moveTimePassed(8200))
-    {
-      kP = 1.8;
-      pBow(25);
-    }
-
-    if (moveTimePassed(9200))
-    {
-      kP = 1.2;
-      pBow(15);
-    }
-    if (moveTimePassed(11200))
-    {
-      kP = 2;
-      pStand();
-    }
-
-    // swimming
-    if (moveTimePassed(12100))
-    {
-      kP = 2;
-      pKickRight(-20);
-    }
-    if (moveTimePassed(13000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(14000))
-    {
-      kP = 2;
-      pKickLeft(-20);
-    }
-    if (moveTimePassed(15000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(15985))
-    {
-      kP = 2;
-      pKickRight(-20);
-    }
-    if (moveTimePassed(17000))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(17890))
-    {
-      kP = 2;
-      pKickLeft(-20);
-    }
-    if (moveTimePassed(18900))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(19750))
-    {
-      kP = 2;
-      pKickRight(-20);
-    }
-    if (moveTimePassed(20800))
-    {
-      kP = 0.5;
-      pStand();
-    }
-    if (moveTimePassed(21665))
-    {
-      kP = 2;
-      pKickLeft(-20);
-    }
-    if (moveTimePassed(22650))
-    {
-      kP = 0.5;
-      pStand();
-    }
-
-    // cloth hanger
-    if (moveTimePassed(25240))
-    {
-      kP = 0.3;
-      pBow(90);
-    }
-    if (moveTimePassed(28800))
-    {
-      kP = 2;
-      pBow(76);
-    }
-
-    // kick naar bolkje
-
-    if (moveTimePassed(29860))
-    {
-      kP = 1.2;
-      pKickRight(90);
-    }
-    if (moveTimePassed(33270))
-    {
-      kP = 0.7;
-      pStepRight(75);
-    }
-    if (moveTimePassed(35460))
-    {
-      kP = 1;
-      pStepRight(60);
-    }
-    if (moveTimePassed(36000))
-    {
-      kP = 1.2;
-      pStepRight(50);
-    }
-    if (moveTimePassed(36500))
-    {
-      kP = 1;
-      pStepRight(35);
-    }
-    if (moveTimePassed(37000))
-    {
-      kP = 1.8;
-      pStepRight(10);
-    }
-
-    // swim in bolk
-
-    if (moveTimePassed(38500))
-    {
-      kP = 1;
-      pStepLeft(10);
-    }
-    if (moveTimePassed(40000))
-    {
-      kP = 1;
-      pStepRight(10);
-    }
-    if (moveTimePassed(40800))
-    {
-      kP = 1.2;
-      pStepLeft(10);
-    }
-    if (moveTimePassed(41600))
-    {
-      kP = 1.2;
-      pStepRight(10);
-    }
-
-    // to knees
-    if (moveTimePassed(43600))
-    {
-      kP = 1;
-      pStepLeft(10);
-    }
-
-    if (moveTimePassed(44400))
-    {
-      kP = 0.5;
-      pStepLeft(45);
-    }
-    if (moveTimePassed(45200))
-    {
-      kP = 0.5;
-      pStepLeft(75);
-    }
-    if (moveTimePassed(46000))
-    {
-      kP = 0.7;
-      pStepLeft(90);
-    }
-    if (moveTimePassed(48590))
-    {
-      kP = 0.5;
-      pKickRight(90);
-    }
-    if (moveTimePassed(52600))
-    {
-      kP = 0.6;
-      pBow(90);
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(musicSequence2);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 2 floor
-  if (move == musicSequence2)
-  {
-    kP = 0.6;
-    pBow(90);
-
-    // back to bird
-
-    if (moveTimePassed(450))
-    {
-      kP = 1.4;
-      pKickRight(45);
-    }
-    if (moveTimePassed(950))
-    {
-      kP = 1.4;
-      pKickRight(90);
-    }
-    if (moveTimePassed(4600))
-    {
-      kP = 1;
-      pStand();
-    }
-    if (moveTimePassed(9400))
-    {
-      kP = 2.2;
-      pStand();
-    }
-
-    // back to standing
-    if (moveTimePassed(11140))
-    {
-      kP = 2;
-      pBow(15);
-    }
-
-    if (moveTimePassed(19870))
-    {
-      kP = 2;
-      pBow(10);
-    }
-    if (moveTimePassed(22000))
-    {
-      kP = 1.8;
-      pBow(5);
-    }
-    if (moveTimePassed(24300))
-    {
-      kP = 1.6;
-      pStand();
-    }
-
-    // val naar achteren
-
-    if (moveTimePassed(32470))
-    {
-      kP = 1.6;
-      pBow(-15);
-    }
-
-    if (moveTimePassed(33470))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    if (moveTimePassed(38880))
-    {
-      kP = 1.6;
-      pKickRight(90);
-    }
-
-    if (moveTimePassed(39400))
-    {
-      kP = 2;
-      pKickRight(90);
-    }
-
-    if (moveTimePassed(43740))
-    {
-      kP = 1.2;
-      pKickRight(80);
-    }
-    if (moveTimePassed(43840))
-    {
-      kP = 1.2;
-      pKickRight(70);
-    }
-    if (moveTimePassed(43940))
-    {
-      kP = 1.0;
-      pKickRight(60);
-    }
-    if (moveTimePassed(44040))
-    {
-      kP = 1.0;
-      pKickRight(40);
-    }
-    if (moveTimePassed(44140))
-    {
-      kP = 1.0;
-      pKickRight(20);
-    }
-
-    if (moveTimePassed(44200))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    // zit
-
-    if (moveTimePassed(46870))
-    {
-      kP = 0.2;
-      pBow(45);
-    }
-
-    if (moveTimePassed(47250))
-    {
-      kP = 0.8;
-      pBow(90);
-    }
-
-    // lig
-
-    if (moveTimePassed(56370))
-    {
-      kP = 0.4;
-      pBow(25);
-    }
-    if (moveTimePassed(57370))
-    {
-      kP = 0.4;
-      pStand();
-    }
-
-    // rechts omhoog
-
-    if (moveTimePassed(59700))
-    {
-      kP = 0.6;
-      pKickRight(50);
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(musicSequence3);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 3 floor pt2
-
-  if (move == musicSequence3)
-  {
-    kP = 0.6;
-    pKickRight(50);
-
-    if (moveTimePassed(600))
-    {
-      kP = 0.85;
-      pKickRight(90);
-    }
-
-    // trap naar split
-
-    if (moveTimePassed(7600))
-    {
-      kP = 0.5;
-      rTargetPositionDegrees = 90;
-      lTargetPositionDegrees = 45;
-    }
-    if (moveTimePassed(8200))
-    {
-      kP = 0.5;
-      pBow(90);
-    }
-
-    if (moveTimePassed(8800))
-    {
-      kP = 0.6;
-      pStepLeft(80);
-    }
-    if (moveTimePassed(9800))
-    {
-      kP = 0.8;
-      pStepLeft(90);
-    }
-    if (moveTimePassed(10100))
-    {
-      kP = 1.2;
-      pStepLeft(90);
-    }
-
-    // split opduwen
-
-    if (moveTimePassed(17500))
-    {
-      kP = 3;
-      pStepLeft(45);
-    }
-
-    if (moveTimePassed(18000))
-    {
-      kP = 2;
-      pStepLeft(45);
-    }
-
-    if (moveTimePassed(20720))
-    {
-      kP = 0.6;
-      pStepLeft(90);
-    }
-    if (moveTimePassed(24430))
-    {
-      kP = 0.7;
-      pStepLeft(90);
-    }
-
-    // split wissel
-
-    if (moveTimePassed(31580))
-    {
-      kP = 0.5;
-      pKickLeft(90);
-    }
-
-    if (moveTimePassed(32580))
-    {
-      kP = 0.6;
-      pStepRight(80);
-    }
-
-    if (moveTimePassed(33100))
-    {
-      kP = 0.6;
-      pStepRight(90);
-    }
-
-    // naar rug
-
-    if (moveTimePassed(35650))
-    {
-      kP = 1;
-      pBow(30);
-    }
-
-    if (moveTimePassed(36200))
-    {
-      kP = 0.6;
-      rTargetPositionDegrees = 200;
-      lTargetPositionDegrees = 150;
-    }
-
-    if (moveTimePassed(37200))
-    {
-      kP = 1.2;
-      rTargetPositionDegrees = 180;
-      lTargetPositionDegrees = 170;
-    }
-
-    if (moveTimePassed(37500))
-    {
-      kP = 1.2;
-      pStand();
-    }
-
-    // rol naar zij
-
-    if (moveTimePassed(39700))
-    {
-      kP = 1.4;
-      pStepRight(25);
-    }
-
-    if (moveTimePassed(41550))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 120;
-      lTargetPositionDegrees = 210;
-    }
-
-    if (moveTimePassed(43700))
-    {
-      kP = 1.2;
-      rTargetPositionDegrees = 200;
-      lTargetPositionDegrees = 190;
-    }
-
-    if (moveTimePassed(44630))
-    {
-      kP = 1;
-      rTargetPositionDegrees = 130;
-      lTargetPositionDegrees = 200;
-    }
-
-    // buik
-    if (moveTimePassed(44630))
-    {
-      kP = 0.8;
-      pBow(-10);
-    }
-
-    // been omhoog
-
-    if (moveTimePassed(51950))
-    {
-      kP = 0.7;
-      pKickRight(-80);
-    }
-    if (moveTimePassed(54020))
-    {
-      kP = 0.8;
-      pBow(-80);
-    }
-    if (moveTimePassed(55020))
-    {
-      kP = 1.2;
-      pBow(-85);
-    }
-
-    // staan
-
-    if (moveTimePassed(58090))
-    {
-      kP = 0.5;
-      pStand();
-    }
-
-    if (moveTimePassed(59090))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(musicSequence4);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 4 standing acro
-
-  if (move == musicSequence4)
-  {
-    kP = 1.2;
-    pStand();
-
-    // walk
-    if (moveTimePassed(185))
-    {
-      kP = 1.4;
-      pStepRight(20);
-    }
-    if (moveTimePassed(1250))
-    {
-      pStepLeft(20);
-    }
-
-    if (moveTimePassed(2215))
-    {
-      pStepRight(20);
-    }
-    if (moveTimePassed(3265))
-    {
-      pStepLeft(20);
-    }
-
-    if (moveTimePassed(4305))
-    {
-      pStepRight(20);
-    }
-    if (moveTimePassed(5350))
-    {
-      pStepLeft(20);
-    }
-
-    if (moveTimePassed(6435))
-    {
-      kP = 1.7;
-      pStand();
-    }
-
-    // rug rol
-
-    if (moveTimePassed(9790))
-    {
-      kP = 0.8;
-      pBow(90);
-    }
-
-    if (moveTimePassed(11850))
-    {
-      kP = 1.3;
-      pBow(90);
-    }
-
-    if (moveTimePassed(15150))
-    {
-      kP = 0.6;
-      pStand();
-    }
-
-    // shoulder sit
-
-    if (moveTimePassed(21740))
-    {
-      kP = 0.8;
-      pBow(15);
-    }
-    if (moveTimePassed(22780))
-    {
-      kP = 0.8;
-      pBow(30);
-    }
-    if (moveTimePassed(24380))
-    {
-      kP = 1;
-      pBow(70);
-    }
-
-    // uitbouw
-
-    if (moveTimePassed(28780))
-    {
-      kP = 0.8;
-      pKickLeft(70);
-    }
-
-    if (moveTimePassed(30885))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    if (moveTimePassed(32120))
-    {
-      kP = 1;
-      pBow(-20);
-    }
-
-    if (moveTimePassed(35436))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    if (moveTimePassed(36975))
-    {
-      kP = 1;
-      lTargetPositionDegrees = 170;
-      rTargetPositionDegrees = 162;
-    }
-
-    if (moveTimePassed(37600))
-    {
-      kP = 1.8;
-      pStand();
-    }
-
-    // schouder snoek
-
-    if (moveTimePassed(40500))
-    {
-      kP = 1.8;
-      pKickRight(-14);
-    }
-
-    if (moveTimePassed(41100))
-    {
-      kP = 1.6;
-      pKickRight(80);
-    }
-
-    if (moveTimePassed(41400))
-    {
-      kP = 1.4;
-      pStepRight(90);
-    }
-
-    if (moveTimePassed(42100))
-    {
-      kP = 1.0;
-      pBow(30);
-    }
-
-    if (moveTimePassed(43000))
-    {
-      kP = 1.0;
-      pBow(-10);
-    }
-
-    // kopstand
-
-    if (moveTimePassed(48335))
-    {
-      kP = 0.2;
-      pBow(50);
-    }
-    if (moveTimePassed(48800))
-    {
-      kP = 0.5;
-      lTargetPositionDegrees = 110;
-      rTargetPositionDegrees = 90;
-    }
-
-    if (moveTimePassed(49999))
-    {
-      startMove(musicSequence5);
-      // jump in time, 50 second sequence to match with full act sound timing
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 5 fall
-
-  if (move == musicSequence5)
-  {
-
-    // starts going into headstand split
-
-    if (moveTimePassed(1925))
-    {
-      kP = 0.6;
-      lTargetPositionDegrees = 150;
-      rTargetPositionDegrees = 90;
-    }
-
-    if (moveTimePassed(3600))
-    {
-      kP = 0.6;
-      lTargetPositionDegrees = 275;
-      rTargetPositionDegrees = 90;
-    }
-
-    if (moveTimePassed(3900))
-    {
-      kP = 0.8;
-      lTargetPositionDegrees = 275;
-      rTargetPositionDegrees = 90;
-    }
-
-    if (moveTimePassed(10335))
-    {
-      kP = 1;
-      lTargetPositionDegrees = 267;
-      rTargetPositionDegrees = 120;
-    }
-
-    // coming down
-
-    if (moveTimePassed(14425))
-    {
-      kP = 0.8;
-      pBow(60);
-    }
-
-    if (moveTimePassed(15646))
-    {
-      kP = 1;
-      pBow(85);
-    }
-
-    if (moveTimePassed(16432))
-    {
-      kP = 0.4;
-      pStand();
-    }
-    if (moveTimePassed(17255))
-    {
-      kP = 1.2;
-      pStand();
-    }
-
-    // fall
-
-    if (moveTimePassed(19309))
-    {
-      kP = 0.6;
-      pBow(-10);
-    }
-    if (moveTimePassed(21050))
-    {
-      kP = 0.6;
-      pBow(10);
-    }
-    if (moveTimePassed(20709))
-    {
-      kP = 1.2;
-      pBow(10);
-    }
-
-    // I don't care 2
-
-    if (moveTimePassed(52500))
-    {
-      kP = 1.2;
-
-      lTargetPositionDegrees = 150;
-      rTargetPositionDegrees = 175;
-    }
-
-    if (moveTimePassed(53700))
-    {
-      kP = 1.2;
-
-      lTargetPositionDegrees = 205;
-      rTargetPositionDegrees = 170;
-    }
-    if (moveTimePassed(54100))
-    {
-      kP = 0.4;
-      lTargetPositionDegrees = 185;
-      rTargetPositionDegrees = 175;
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(musicSequence6);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 6 floor dialog
-
-  if (move == musicSequence6)
-  {
-
-    // I want to see them
-
-    if (moveTimePassed(2450))
-    {
-      kP = 0.9;
-      pBow(25);
-    }
-    if (moveTimePassed(4340))
-    {
-      kP = 0.9;
-      pBow(5);
-    }
-
-    if (moveTimePassed(8025))
-    {
-      kP = 0.9;
-      pKickRight(40);
-    }
-    if (moveTimePassed(8800))
-    {
-      kP = 0.8;
-      pStand();
-    }
-
-    if (moveTimePassed(14500))
-    {
-      kP = 1.5;
-      pKickRight(-10);
-    }
-    if (moveTimePassed(14930))
-    {
-      kP = 1.6;
-      pKickRight(40);
-    }
-    if (moveTimePassed(15280))
-    {
-      kP = 1.2;
-      pStepRight(12);
-    }
-
-    // hello people
-
-    if (moveTimePassed(22222))
-    {
-      kP = 1.4;
-      pStand();
-    }
-
-    if (moveTimePassed(29635))
-    {
-      kP = 1;
-      pKickRight(50);
-    }
-    if (moveTimePassed(31735))
-    {
-      kP = 1;
-      pStand();
-    }
-
-    // I'm ready
-
-    if (moveTimePassed(40575))
-    {
-      kP = 1;
-      pBow(15);
-    }
-    if (moveTimePassed(41600))
-    {
-      kP = 1.2;
-      pStand();
-    }
-
-    // finale
-
-    if (moveTimePassed(55485))
-    {
-      kP = 1.2;
-      pKickRight(30);
-    }
-
-    if (moveTimePassed(57240))
-    {
-      kP = 1.2;
-
-      lTargetPositionDegrees = 185;
-      rTargetPositionDegrees = 160;
-    }
-    if (moveTimePassed(59400))
-    {
-      kP = 1.2;
-
-      pBow(20);
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(musicSequence7);
-    }
-  }
-
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 7 finale
-
-  if (move == musicSequence7)
-  {
-
-    kP = 1.2;
-
-    pBow(20);
-
-    if (moveTimePassed(1765))
-    {
-      kP = 1;
-
-      lTargetPositionDegrees = 100;
-      rTargetPositionDegrees = 160;
-    }
-
-    if (moveTimePassed(6360))
-    {
-      kP = 1.6;
-
-      lTargetPositionDegrees = 110;
-      rTargetPositionDegrees = 170;
-    }
-
-    if (moveTimePassed(7435))
-    {
-      kP = 1.2;
-
-      pStand();
-    }
-
-    if (moveTimePassed(13204))
-    {
-      kP = 1;
-
-      pKickLeft(10);
-    }
-
-    if (moveTimePassed(13510))
-    {
-      kP = 1;
-
-      pKickLeft(20);
-    }
-
-    if (moveTimePassed(13800))
-    {
-      kP = 1;
-
-      pKickLeft(30);
-    }
-
-    if (moveTimePassed(14085))
-    {
-      kP = 1;
-
-      pKickLeft(40);
-    }
-
-    if (moveTimePassed(14390))
-    {
-      kP = 1;
-
-      pKickLeft(50);
-    }
-
-    if (moveTimePassed(14650))
-    {
-      kP = 1;
-
-      pKickLeft(65);
-    }
-
-    if (moveTimePassed(14960))
-    {
-      kP = 1.2;
-
-      pKickLeft(90);
-    }
-
-    // stand
-
-    if (moveTimePassed(14960))
-    {
-      kP = 0.4;
-
-      pStand();
-    }
-
-    if (moveTimePassed(19460))
-    {
-      kP = 1.2;
-
-      pStand();
-    }
-
-    // bows
-
-    if (moveTimePassed(23188))
-    {
-      kP = 0.6;
-
-      pBow(80);
-    }
-
-    if (moveTimePassed(24741))
-    {
-      kP = 1.0;
-
-      pStand();
-    }
-
-    // walk
-
-    if (moveTimePassed(28740))
-    {
-      kP = 1.6;
-      pStepRight(15);
-    }
-    if (moveTimePassed(29245))
-    {
-      kP = 1.5;
-      pStepLeft(15);
-    }
-    if (moveTimePassed(29995))
-    {
-      kP = 1.5;
-      pStepRight(15);
-    }
-    if (moveTimePassed(30680))
-    {
-      kP = 1.7;
-      pStand();
-    }
-
-    if (moveTimePassed(32190))
-    {
-      kP = 0.6;
-
-      pBow(80);
-    }
-
-    if (moveTimePassed(33765))
-    {
-      kP = 1.2;
-
-      pStand();
-    }
-
-    // mini bow
-
-    if (moveTimePassed(35975))
-    {
-      kP = 0.8;
-
-      pBow(10);
-    }
-
-    if (moveTimePassed(37870))
-    {
-      kP = 0.8;
-
-      pBow(1);
-    }
-
-    // hug
-
-    if (moveTimePassed(37870))
-    {
-      kP = 2;
-
-      pBow(20);
-    }
-
-    if (moveTimePassed(37870))
-    {
-      kP = 1;
-
-      pStand();
-    }
-
-    // walk
-
-    if (moveTimePassed(49526))
-    {
-      kP = 1.5;
-      pStepRight(15);
-    }
-    if (moveTimePassed(50250))
-    {
-      kP = 1.5;
-      pStepLeft(15);
-    }
-    if (moveTimePassed(51025))
-    {
-      kP = 1.5;
-      pStepRight(15);
-    }
-    if (moveTimePassed(51740))
-    {
-      kP = 1.5;
-      pStepLeft(15);
-    }
-    if (moveTimePassed(52515))
-    {
-      kP = 1.5;
-      pStepRight(15);
-    }
-    if (moveTimePassed(53245))
-    {
-      kP = 1.5;
-      pStepLeft(15);
-    }
-    if (moveTimePassed(53960))
-    {
-      kP = 1.5;
-      pStepRight(15);
-    }
-    if (moveTimePassed(54690))
-    {
-      kP = 1.5;
-      pStand();
-    }
-
-    if (moveTimePassed(60000))
-    {
-      startMove(musicSequence8);
-    }
+    // round to even
+    lTargetPositionDegrees = (lTargetPositionDegrees / 2) * 2;
+    rTargetPositionDegrees = (rTargetPositionDegrees / 2) * 2;
   }
 
-  // --------------------------------
-  // MARK: - MUSIC SEQUENCE 8 toilet
-
-  if (move == musicSequence8)
+  // every other move is a timeline, sequences chain into each other on their own
+  struct_timeline_state state;
+  if (timelinePlayer.update(musicClock.toShow(millis()), state))
   {
-
-    kP = 1.2;
-    pStand();
-
-    if (moveTimePassed(8090))
-    {
-      kP = 1.5;
-      pKickRight(80);
-    }
-    if (moveTimePassed(8790))
-    {
-      kP = 1.5;
-      pKickLeft(80);
-    }
-    if (moveTimePassed(9480))
-    {
-      kP = 1.5;
-      pBow(80);
-    }
-
-    if (moveTimePassed(10320))
-    {
-      kP = 0.2;
-      pStand();
-    }
-
-    // splits
-
-    if (moveTimePassed(17500))
-    {
-      kP = 2;
-      pStepRight(80);
-    }
-    if (moveTimePassed(18400))
-    {
-      kP = 2;
-      pStepLeft(80);
-    }
-    if (moveTimePassed(19300))
-    {
-      kP = 2;
-      pStepRight(90);
-    }
-    if (moveTimePassed(20200))
-    {
-      kP = 2;
-      pStepLeft(90);
-    }
-
-    // forward backward
-
-    if (moveTimePassed(21475))
-    {
-      kP = 2;
-      pBow(80);
-    }
-    if (moveTimePassed(22200))
-    {
-      kP = 2;
-      pBow(-80);
-    }
-
-    if (moveTimePassed(22600))
-    {
-      kP = 2;
-      pBow(90);
-    }
-    if (moveTimePassed(23455))
-    {
-      kP = 2;
-      pBow(-80);
-    }
-    if (moveTimePassed(23725))
-    {
-      kP = 2;
-      pBow(90);
-    }
-
-    if (moveTimePassed(24900))
-    {
-      kP = 0.3;
-      pStand();
-    }
+    move = moveOf(timelinePlayer.getCurrent());
+    kP = state.kP;
+    rTargetPositionDegrees = state.rTarget + 0.5f;
+    lTargetPositionDegrees = state.lTarget + 0.5f;
   }
 }
 
-bool moveTimePassed(uint32_t time) { return (moveTimer + time) > millis(); }
-
 // --------------
 // MARK: - Positions
 
@@ -3076,31 +1298,103 @@ void pKickLeft(int8_t degrees)
 // --------------
 // MARK: - Print
 
+// every 10 ms, when it is a job
 void printAll()
 {
-  if (printTimer < millis())
-  {
-    // Serial.print(analogRead(SLIDER_L_ARM));
-    // Serial.print(",");
-    // Serial.print(analogRead(JOYSTICK_L_X));
-    // Serial.print(",");
-    // Serial.print(analogRead(JOYSTICK_R_X));
-    // Serial.print(",");
-    // Serial.print(analogRead(JOYSTICK_R_Y));
-    // Serial.print(",");
-    // Serial.print(encoderPos);
-    // Serial.print(",");
-
-    // Serial.println(analogRead(BATTERY_V));
-
-    Serial.print(ads1115.readADC_SingleEnded(0));
-    Serial.print(",");
-    Serial.print(ads1115.readADC_SingleEnded(1));
-    Serial.print(",");
-    Serial.print(ads1115.readADC_SingleEnded(2));
-    Serial.print(",");
-    Serial.println(ads1115.readADC_SingleEnded(3));
-
-    printTimer = millis() + 10; // print every 10 ms
+  // Serial.print(analogRead(SLIDER_L_ARM));
+  // Serial.print(",");
+  // Serial.print(analogRead(JOYSTICK_L_X));
+  // Serial.print(",");
+  // Serial.print(analogRead(JOYSTICK_R_X));
+  // Serial.print(",");
+  // Serial.print(analogRead(JOYSTICK_R_Y));
+  // Serial.print(",");
+  // Serial.print(encoderPos);
+  // Serial.print(",");
+
+  // Serial.println(analogRead(BATTERY_V));
+
+  // last results of the non-blocking conversions in readADS(), channels 0..3
+  binaryLog.log(LOG_REMOTE_SLIDERS, 0, sliderRA, sliderRL, sliderLL, sliderLA);
+}
+
+void checkSerialCommands()
+{
+  if (!Serial.available())
+  {
+    return;
+  }
+
+  char command = Serial.read();
+
+  // t: dump the captured leg telemetry, for host/telemetryExport
+  if (command == 't')
+  {
+    telemetryCapture.startDump();
+  }
+
+  // u: load a show into flash, from host/showLoad
+  if (command == SHOW_LOAD_COMMAND)
+  {
+    // nothing may read the old image while it is overwritten
+    timelinePlayer.stop();
+    legPlayback = false;
+    sequenceLibrary = TimelineLibrary(sequences, MOVE_COUNT);
+    showStore.receive(Serial, binaryLog);
+    loadSequences();
+    move = stop;
+  }
+
+  // l: log the loop profiles, and start the remote's over; logDecode -p
+  // prints them as a table
+  if (command == 'l')
+  {
+#ifdef LOOP_PROFILER
+    struct_profile_stats stats[REMOTE_ZONE_COUNT];
+    for (uint8_t i = 0; i < REMOTE_ZONE_COUNT; i++)
+    {
+      loopProfiler.get(i, stats[i]);
+    }
+    logProfile(LOG_REMOTE_PROFILE, stats, REMOTE_ZONE_COUNT);
+    loopProfiler.reset();
+#endif
+    logProfile(LOG_REMOTE_LEG_PROFILE, legProfile, LEG_ZONE_COUNT);
+    binaryLog.log(LOG_REMOTE_LEG_LOAD, dataIn.loadLevel);
+  }
+
+  // x: dump the trace ring, for host/traceExport
+  if (command == 'x')
+  {
+#ifdef TRACE_EVENTS
+    traceRing.startDump();
+#endif
+  }
+
+  // r: record a take, p: replay it, s: stop either
+  if (command == 'r')
+  {
+    inputRecorder.record(millis(), remoteMode, binaryLog);
+  }
+
+  if (command == 'p')
+  {
+    startReplay();
+  }
+
+  if (command == 's')
+  {
+    inputRecorder.stop(binaryLog);
+  }
+}
+
+void logProfile(uint16_t id, const struct_profile_stats *stats, uint8_t zones)
+{
+  // a record per zone, cycles at 240 MHz; zones without samples are skipped
+  for (uint8_t i = 0; i < zones; i++)
+  {
+    if (stats[i].count)
+    {
+      binaryLog.log(id, i, stats[i].min, stats[i].mean, stats[i].max, stats[i].p99);
+    }
   }
 }
@@ -0,0 +1,99 @@
+#include <showStore.h>
+
+ShowStore::ShowStore() : partition(nullptr), image(nullptr), size(0), handle(0)
+{
+}
+
+bool ShowStore::init()
+{
+  partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                       (esp_partition_subtype_t)PARTITION_SUBTYPE, "shows");
+  if (!partition)
+  {
+    Serial.println("no show partition");
+    return false;
+  }
+  return map();
+}
+
+bool ShowStore::map()
+{
+  struct_timeline_image_header header;
+  if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK ||
+      !readTimelineImageHeader((const uint8_t *)&header, sizeof(header), header) ||
+      header.size > partition->size)
+  {
+    return false; // erased, or never loaded
+  }
+
+  const void *mapped;
+  if (esp_partition_mmap(partition, 0, header.size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK)
+  {
+    return false;
+  }
+  image = (const uint8_t *)mapped;
+  size = header.size;
+  return true;
+}
+
+void ShowStore::unmap()
+{
+  if (image)
+  {
+    spi_flash_munmap(handle);
+  }
+  image = nullptr;
+  size = 0;
+}
+
+bool ShowStore::load(TimelineLibrary &library)
+{
+  return image && library.load(image, size);
+}
+
+bool ShowStore::receive(Stream &in, BinaryLog &log)
+{
+  struct_timeline_image_header header;
+  uint32_t received = in.readBytes((uint8_t *)&header, sizeof(header));
+  if (!partition || received != sizeof(header) ||
+      !readTimelineImageHeader((const uint8_t *)&header, sizeof(header), header) ||
+      header.size < sizeof(header) || header.size > partition->size)
+  {
+    log.log(LOG_REMOTE_SHOW_LOAD, SHOW_LOAD_FAILED, received);
+    return false;
+  }
+
+  unmap();
+  size_t erase = (header.size + SPI_FLASH_SEC_SIZE - 1) & ~(SPI_FLASH_SEC_SIZE - 1);
+  if (esp_partition_erase_range(partition, 0, erase) != ESP_OK)
+  {
+    log.log(LOG_REMOTE_SHOW_LOAD, SHOW_LOAD_FAILED, received);
+    return false;
+  }
+  log.log(LOG_REMOTE_SHOW_LOAD, SHOW_LOAD_READY, received);
+
+  // the header goes in last, so an interrupted load leaves no image behind
+  uint8_t block[SHOW_LOAD_BLOCK];
+  while (received < header.size)
+  {
+    size_t n = min((uint32_t)SHOW_LOAD_BLOCK, header.size - received);
+    if (in.readBytes(block, n) != n ||
+        esp_partition_write(partition, received, block, n) != ESP_OK)
+    {
+      log.log(LOG_REMOTE_SHOW_LOAD, SHOW_LOAD_FAILED, received);
+      return false;
+    }
+    received += n;
+    log.log(LOG_REMOTE_SHOW_LOAD, SHOW_LOAD_READY, received);
+  }
+
+  TimelineLibrary check;
+  if (esp_partition_write(partition, 0, &header, sizeof(header)) != ESP_OK || !map() ||
+      !load(check))
+  {
+    log.log(LOG_REMOTE_SHOW_LOAD, SHOW_LOAD_FAILED, received);
+    return false;
+  }
+  log.log(LOG_REMOTE_SHOW_LOAD, SHOW_LOAD_DONE, size);
+  return true;
+}
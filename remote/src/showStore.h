@@ -0,0 +1,41 @@
+#ifndef SHOW_STORE_H
+#define SHOW_STORE_H
+
+#include <Arduino.h>
+#include <binaryLog.h>
+#include <esp_partition.h>
+#include <showLoad.h>
+#include <timelineLibrary.h>
+
+// Timeline library image in its own flash partition (see partitions.csv),
+// memory mapped, so timelines are read straight from flash without a copy in
+// RAM and a show can be changed without rebuilding the firmware.
+class ShowStore
+{
+public:
+  static const uint8_t PARTITION_SUBTYPE = 0x40; // first custom data subtype
+
+  ShowStore();
+  // finds and maps the partition, false if there is no partition or no image
+  bool init();
+
+  // loads the mapped image into library, which keeps the built-in timelines
+  // if there is none
+  bool load(TimelineLibrary &library);
+
+  // serial loader, after SHOW_LOAD_COMMAND; blocks until the image is in or
+  // the host stops sending. Anything loaded from the partition is invalid
+  // afterwards, load it again.
+  bool receive(Stream &in, BinaryLog &log);
+
+private:
+  const esp_partition_t *partition;
+  const uint8_t *image;
+  size_t size;
+  spi_flash_mmap_handle_t handle;
+
+  bool map();
+  void unmap();
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include <telemetryCapture.h>
+
+// two values to a log record value, host/telemetryExport splits them again
+static int32_t pack(int16_t low, int16_t high)
+{
+  return (int32_t)((uint32_t)(uint16_t)high << 16 | (uint16_t)low);
+}
+
+TelemetryCapture::TelemetryCapture(size_t capacity)
+    : capacity(capacity), buffer(nullptr), head(0), used(0), dumping(false),
+      hasSequence(false), lastSequence(0), lostFrames(0), decoder(), joint(TELEMETRY_JOINTS), dumpCount(0),
+      lastDrain(0), budget(0)
+{
+}
+
+void TelemetryCapture::init()
+{
+  buffer = (uint8_t *)malloc(capacity);
+  if (!buffer)
+  {
+    capacity = 0;
+    Serial.println("telemetry capture disabled, out of memory");
+  }
+}
+
+void TelemetryCapture::store(const uint8_t *frame, size_t len)
+{
+  // frames are stored as [length][bytes], oldest ones make room
+  if (len == 0 || len > 255 || len + 1 > capacity)
+  {
+    return;
+  }
+
+  TelemetryDecoder decoder;
+  if (!decoder.begin(frame, len))
+  {
+    return;
+  }
+
+  // the WiFi task stores while loop() clears or starts a dump, possibly on
+  // the other core
+  portENTER_CRITICAL(&mux);
+  if (dumping)
+  {
+    portEXIT_CRITICAL(&mux);
+    return;
+  }
+  if (hasSequence && decoder.getSequence() != (uint16_t)(lastSequence + 1))
+  {
+    lostFrames += (uint16_t)(decoder.getSequence() - lastSequence - 1);
+  }
+  lastSequence = decoder.getSequence();
+  hasSequence = true;
+
+  while (used + len + 1 > capacity)
+  {
+    drop();
+  }
+
+  buffer[(head + used) % capacity] = len;
+  for (size_t i = 0; i < len; i++)
+  {
+    buffer[(head + used + 1 + i) % capacity] = frame[i];
+  }
+  used += len + 1;
+  portEXIT_CRITICAL(&mux);
+}
+
+void TelemetryCapture::clear()
+{
+  portENTER_CRITICAL(&mux);
+  head = 0;
+  used = 0;
+  hasSequence = false;
+  lostFrames = 0;
+  portEXIT_CRITICAL(&mux);
+}
+
+void TelemetryCapture::startDump()
+{
+  portENTER_CRITICAL(&mux);
+  bool started = dumping;
+  dumping = true;
+  portEXIT_CRITICAL(&mux);
+  if (started)
+  {
+    return;
+  }
+
+  decoder = TelemetryDecoder();
+  joint = TELEMETRY_JOINTS;
+  dumpCount = 0;
+  lastDrain = millis();
+  budget = 0;
+}
+
+bool TelemetryCapture::drain(BinaryLog &log)
+{
+  if (!dumping)
+  {
+    return false;
+  }
+
+  uint32_t now = millis();
+  budget += (now - lastDrain) * DRAIN_PER_MS;
+  budget = budget < 16 ? budget : 16;
+  lastDrain = now;
+
+  // store() does not touch the ring until dumping is cleared
+  while (joint < TELEMETRY_JOINTS || nextSample())
+  {
+    if (!budget)
+    {
+      return true;
+    }
+
+    const struct_telemetry_joint &j = sample.joints[joint];
+    if (!log.log(LOG_REMOTE_TELEMETRY, joint, sample.micros,
+                 pack(j.position, j.velocity), pack(j.setpoint, j.output),
+                 pack(j.duty, sample.loopMicros)))
+    {
+      return true; // the log ring is full, again next time
+    }
+    budget--;
+    joint++;
+  }
+
+  if (!log.log(LOG_REMOTE_TELEMETRY_DONE, 0, dumpCount, lostFrames))
+  {
+    return true;
+  }
+  clear();
+  portENTER_CRITICAL(&mux);
+  dumping = false;
+  portEXIT_CRITICAL(&mux);
+  return false;
+}
+
+bool TelemetryCapture::nextSample()
+{
+  while (!decoder.next(sample))
+  {
+    if (!used)
+    {
+      return false;
+    }
+    uint8_t len = peek(0);
+    for (size_t i = 0; i < len; i++)
+    {
+      frame[i] = peek(1 + i);
+    }
+    drop();
+    decoder.begin(frame, len);
+  }
+  joint = 0;
+  dumpCount++;
+  return true;
+}
+
+uint32_t TelemetryCapture::getLostFrames()
+{
+  return lostFrames;
+}
+
+void TelemetryCapture::drop()
+{
+  size_t len = peek(0) + 1;
+  head = (head + len) % capacity;
+  used -= len;
+}
+
+uint8_t TelemetryCapture::peek(size_t offset)
+{
+  return buffer[(head + offset) % capacity];
+}
@@ -0,0 +1,55 @@
+#ifndef TELEMETRY_CAPTURE_H
+#define TELEMETRY_CAPTURE_H
+
+#include <Arduino.h>
+#include <binaryLog.h>
+#include <telemetryFrame.h>
+
+// Keeps the last few seconds of leg telemetry frames, still compressed, so a
+// 1 kHz trace of a move can be looked at afterwards.
+//
+// startDump() stops capturing and drain() then writes the samples out through
+// the binary log, a joint per record, for host/telemetryExport to turn into
+// CSV.
+class TelemetryCapture
+{
+public:
+  static const uint8_t DRAIN_PER_MS = 2; // records, leaves the serial line room for the rest
+
+  TelemetryCapture(size_t capacity);
+  void init();
+  // called from the ESP-NOW receive callback
+  void store(const uint8_t *frame, size_t len);
+  void clear();
+  // stops capturing until the frames are out
+  void startDump();
+  // every loop, logs a few samples at a time; true while dumping
+  bool drain(BinaryLog &log);
+  uint32_t getLostFrames();
+
+private:
+  size_t capacity;
+  uint8_t *buffer;
+  size_t head;
+  size_t used;
+  bool dumping; // store() leaves the ring to drain() while set
+  bool hasSequence;
+  uint16_t lastSequence;
+  uint32_t lostFrames;
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+  // the frame being drained
+  uint8_t frame[255];
+  TelemetryDecoder decoder;
+  struct_telemetry_sample sample;
+  uint8_t joint; // next one to log, TELEMETRY_JOINTS when the sample is out
+  uint32_t dumpCount;
+  uint32_t lastDrain; // ms
+  uint32_t budget;
+
+  bool nextSample();
+  void drop();
+  uint8_t peek(size_t offset);
+};
+
+#endif
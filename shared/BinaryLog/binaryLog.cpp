@@ -0,0 +1,163 @@
+#include <binaryLog.h>
+#include <cobs.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+static uint32_t logMicros()
+{
+#ifdef ARDUINO
+  return micros();
+#else
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static uint8_t checksum(const uint8_t *data, size_t len)
+{
+  uint8_t sum = 0;
+  for (size_t i = 0; i < len; i++)
+  {
+    sum = (sum << 1 | sum >> 7) ^ data[i];
+  }
+  return sum;
+}
+
+BinaryLog::BinaryLog() : head(0), tail(0), dropped(0)
+{
+  for (uint32_t i = 0; i < CAPACITY; i++)
+  {
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool BinaryLog::log(uint16_t id, uint16_t arg, int32_t v0, int32_t v1, int32_t v2, int32_t v3)
+{
+  struct_log_record record = {logMicros(), id, arg, {v0, v1, v2, v3}};
+  if (push(record))
+  {
+    return true;
+  }
+  dropped.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+bool BinaryLog::push(const struct_log_record &record)
+{
+  // bounded queue after Dmitry Vyukov: each cell's sequence tells producers
+  // and the consumer whose turn it is, head is claimed with a CAS
+  uint32_t pos = head.load(std::memory_order_relaxed);
+  Cell *cell;
+  for (;;)
+  {
+    cell = &cells[pos & (CAPACITY - 1)];
+    uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+    int32_t diff = (int32_t)(seq - pos);
+    if (diff == 0)
+    {
+      if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      return false; // full
+    }
+    else
+    {
+      pos = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->record = record;
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+bool BinaryLog::pop(struct_log_record &record)
+{
+  Cell *cell = &cells[tail & (CAPACITY - 1)];
+  uint32_t seq = cell->sequence.load(std::memory_order_acquire);
+  if ((int32_t)(seq - (tail + 1)) < 0)
+  {
+    return false; // empty, or a producer is still writing this cell
+  }
+
+  record = cell->record;
+  cell->sequence.store(tail + CAPACITY, std::memory_order_release);
+  tail++;
+  return true;
+}
+
+size_t BinaryLog::drain(uint8_t *out, size_t capacity)
+{
+  size_t n = 0;
+  uint8_t raw[sizeof(struct_log_record) + 1];
+
+  while (n + MAX_FRAME_SIZE <= capacity)
+  {
+    struct_log_record record;
+    uint32_t lost = dropped.exchange(0, std::memory_order_relaxed);
+    if (lost)
+    {
+      record = {logMicros(), LOG_DROPPED, 0, {(int32_t)lost, 0, 0, 0}};
+    }
+    else if (!pop(record))
+    {
+      break;
+    }
+
+    memcpy(raw, &record, sizeof(record));
+    raw[sizeof(record)] = checksum(raw, sizeof(record));
+    n += cobsEncode(raw, sizeof(raw), out + n);
+    out[n++] = 0;
+  }
+
+  return n;
+}
+
+bool decodeLogFrame(const uint8_t *frame, size_t len, struct_log_record &record)
+{
+  uint8_t raw[sizeof(struct_log_record) + 1];
+  if (cobsDecode(frame, len, raw, sizeof(raw)) != sizeof(raw))
+  {
+    return false;
+  }
+  if (checksum(raw, sizeof(record)) != raw[sizeof(record)])
+  {
+    return false;
+  }
+  memcpy(&record, raw, sizeof(record));
+  return true;
+}
+
+#ifdef ARDUINO
+void BinaryLog::startTask(Print &out, UBaseType_t priority)
+{
+  this->out = &out;
+  xTaskCreate(task, "binaryLog", 2048, this, priority, nullptr);
+}
+
+void BinaryLog::task(void *self)
+{
+  BinaryLog *log = (BinaryLog *)self;
+  static uint8_t buffer[512];
+
+  for (;;)
+  {
+    size_t n = log->drain(buffer, sizeof(buffer));
+    if (n)
+    {
+      log->out->write(buffer, n);
+    }
+    else
+    {
+      vTaskDelay(1);
+    }
+  }
+}
+#endif
@@ -0,0 +1,62 @@
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <logRecord.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+// Lock-free multi-producer ring of log records. log() never blocks and never
+// allocates, so it is safe from loop(), WiFi callbacks and ISRs alike. One
+// consumer drains it into COBS frames.
+class BinaryLog
+{
+public:
+  static const uint16_t CAPACITY = 256; // power of two
+  static const size_t MAX_FRAME_SIZE = sizeof(struct_log_record) + 3;
+
+  BinaryLog();
+
+  // returns false, and counts a drop, if the ring is full
+  bool log(uint16_t id, uint16_t arg = 0, int32_t v0 = 0, int32_t v1 = 0,
+           int32_t v2 = 0, int32_t v3 = 0);
+
+  // single consumer: encodes whole frames into out, returns bytes written
+  size_t drain(uint8_t *out, size_t capacity);
+
+#ifdef ARDUINO
+  // starts a low priority task that writes the frames to out
+  void startTask(Print &out, UBaseType_t priority = 1);
+#endif
+
+private:
+  struct Cell
+  {
+    std::atomic<uint32_t> sequence;
+    struct_log_record record;
+  };
+
+  Cell cells[CAPACITY];
+  std::atomic<uint32_t> head;
+  uint32_t tail;
+  std::atomic<uint32_t> dropped;
+
+  bool push(const struct_log_record &record);
+  bool pop(struct_log_record &record);
+
+#ifdef ARDUINO
+  Print *out;
+  static void task(void *self);
+#endif
+};
+
+// Decodes one frame (without the zero delimiter), returns false on bad
+// length or checksum, e.g. plain text printed between frames.
+bool decodeLogFrame(const uint8_t *frame, size_t len, struct_log_record &record);
+
+#endif
@@ -0,0 +1,65 @@
+#include <cobs.h>
+
+size_t cobsEncode(const uint8_t *in, size_t len, uint8_t *out)
+{
+  size_t codeIndex = 0;
+  size_t n = 1;
+  uint8_t code = 1;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    if (in[i] == 0)
+    {
+      out[codeIndex] = code;
+      codeIndex = n++;
+      code = 1;
+      continue;
+    }
+
+    out[n++] = in[i];
+    if (++code == 0xFF)
+    {
+      out[codeIndex] = code;
+      codeIndex = n++;
+      code = 1;
+    }
+  }
+
+  out[codeIndex] = code;
+  return n;
+}
+
+size_t cobsDecode(const uint8_t *in, size_t len, uint8_t *out, size_t capacity)
+{
+  size_t n = 0;
+  size_t i = 0;
+
+  while (i < len)
+  {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > len)
+    {
+      return 0;
+    }
+
+    for (uint8_t j = 1; j < code; j++)
+    {
+      if (n >= capacity || in[i] == 0)
+      {
+        return 0;
+      }
+      out[n++] = in[i++];
+    }
+
+    if (code != 0xFF && i < len)
+    {
+      if (n >= capacity)
+      {
+        return 0;
+      }
+      out[n++] = 0;
+    }
+  }
+
+  return n;
+}
@@ -0,0 +1,14 @@
+#ifndef COBS_H
+#define COBS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Consistent Overhead Byte Stuffing, frames never contain a zero byte so a
+// zero can delimit them. out needs len + len / 254 + 1 bytes.
+size_t cobsEncode(const uint8_t *in, size_t len, uint8_t *out);
+
+// Decodes one frame without its delimiter, returns 0 on malformed input.
+size_t cobsDecode(const uint8_t *in, size_t len, uint8_t *out, size_t capacity);
+
+#endif
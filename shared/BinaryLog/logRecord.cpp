@@ -0,0 +1,58 @@
+#include <logRecord.h>
+
+const char *logIdName(uint16_t id)
+{
+  switch (id)
+  {
+  case LOG_DROPPED:
+    return "dropped";
+  case LOG_TRACE_EVENT:
+    return "traceEvent";
+  case LOG_TRACE_TASK:
+    return "traceTask";
+  case LOG_TRACE_DONE:
+    return "traceDone";
+  case LOG_HEAP:
+    return "heap";
+  case LOG_HEAP_TASK:
+    return "heapTask";
+  case LOG_LEG_POSITIONS:
+    return "legPositions";
+  case LOG_LEG_BUTTONS:
+    return "legButtons";
+  case LOG_LEG_TEACH:
+    return "legTeach";
+  case LOG_LEG_TEACH_KEYFRAME:
+    return "legTeachKeyframe";
+  case LOG_LEG_PROFILE:
+    return "legProfile";
+  case LOG_LEG_JOB:
+    return "legJob";
+  case LOG_LEG_LOAD:
+    return "legLoad";
+  case LOG_REMOTE_RECEIVED:
+    return "remoteReceived";
+  case LOG_REMOTE_SLIDERS:
+    return "remoteSliders";
+  case LOG_REMOTE_SHOW_LOAD:
+    return "remoteShowLoad";
+  case LOG_REMOTE_TAKE:
+    return "remoteTake";
+  case LOG_REMOTE_JOB:
+    return "remoteJob";
+  case LOG_REMOTE_TELEMETRY:
+    return "remoteTelemetry";
+  case LOG_REMOTE_TELEMETRY_DONE:
+    return "remoteTelemetryDone";
+  case LOG_REMOTE_PROFILE:
+    return "remoteProfile";
+  case LOG_REMOTE_LEG_PROFILE:
+    return "remoteLegProfile";
+  case LOG_REMOTE_LEG_LOAD:
+    return "remoteLegLoad";
+  case LOG_REMOTE_SHOW:
+    return "remoteShow";
+  default:
+    return "unknown";
+  }
+}
@@ -0,0 +1,57 @@
+#ifndef LOG_RECORD_H
+#define LOG_RECORD_H
+
+#include <stdint.h>
+
+// Fixed-size binary log record. On the wire every record is COBS encoded
+// with a trailing checksum byte and terminated by a zero byte.
+
+enum LogId : uint16_t
+{
+  LOG_DROPPED = 1, // v0 = records lost because the ring was full
+
+  // trace dumps, see shared/Profiler/traceRing.h
+  LOG_TRACE_EVENT = 10, // arg = TraceId, v0 = cycles, v1 = task, v2 = TracePhase | core << 8
+  LOG_TRACE_TASK,       // v0 = task, v1..v3 = its name, 12 chars at most
+  LOG_TRACE_DONE,       // v0 = events in the dump
+
+  // heap reports, see shared/Profiler/heapMonitor.h
+  LOG_HEAP = 20,  // arg = steady, v0..v2 = free, min free, largest block bytes, v3 = allocations by no task
+  LOG_HEAP_TASK,  // arg = stack high-water bytes, v0..v1 = allocations, since steady, v2..v3 = name, 8 chars
+
+  // leg
+  LOG_LEG_POSITIONS = 100, // v0..v1 = raw right/left, v2..v3 = tenths of a degree
+  LOG_LEG_BUTTONS,         // arg = upL | downL << 1 | yellow << 2 | upR << 3 | downR << 4
+  LOG_LEG_TEACH,           // arg = keyframes, v0 = samples, v1 = bytes, v2 = ms, v3 = tolerance x100
+  LOG_LEG_TEACH_KEYFRAME,  // arg = index, v0 = ms, v1..v2 = right/left degrees, v3 = kP x100
+  LOG_LEG_PROFILE,         // arg = LegZone, v0..v3 = min, mean, max, p99 cycles
+  LOG_LEG_JOB,             // arg = job, v0..v1 = misses, overruns, v2..v3 = max us run, late
+  LOG_LEG_LOAD,            // arg = shed level, v0 = min control slack us, v1 = lost ticks
+
+  // remote
+  LOG_REMOTE_RECEIVED = 200, // arg = bytes, v0..v1 = leg inputs in tenths of a degree
+  LOG_REMOTE_SLIDERS,        // v0..v3 = ads channels 0..3
+  LOG_REMOTE_SHOW_LOAD,      // arg = ShowLoadStatus, v0 = bytes
+  LOG_REMOTE_TAKE,           // arg = TakeState, v0 = bytes, v1 = records
+  LOG_REMOTE_JOB,            // as LOG_LEG_JOB
+  LOG_REMOTE_TELEMETRY,      // arg = joint, v0 = micros, v1..v3 = position | velocity << 16,
+                             // setpoint | output << 16, duty | loopMicros << 16
+  LOG_REMOTE_TELEMETRY_DONE, // v0 = samples in the dump, v1 = frames lost before it
+  LOG_REMOTE_PROFILE,        // arg = RemoteZone, v0..v3 = min, mean, max, p99 cycles
+  LOG_REMOTE_LEG_PROFILE,    // arg = LegZone, as the leg last reported it, v0..v3 as above
+  LOG_REMOTE_LEG_LOAD,       // arg = the leg's shed level, as it last reported it
+  LOG_REMOTE_SHOW,           // arg = 1 from the show partition, 0 built in, v0 = timelines,
+                             // v1 = upload image bytes, 0 if it is too big to upload
+};
+
+typedef struct struct_log_record
+{
+  uint32_t micros;
+  uint16_t id;
+  uint16_t arg;
+  int32_t values[4];
+} struct_log_record;
+
+const char *logIdName(uint16_t id);
+
+#endif
@@ -0,0 +1,30 @@
+#include <cues.h>
+
+#include <string.h>
+
+// also the running order of the cue list on the remote, in the order the
+// keypad has them
+const struct_cue cues[] = {
+    // name, move, ms into it
+    {"stand", stand, 0},
+    {"music 0", musicSequence0, 0},
+    {"music 1", musicSequence1, 0},
+    {"music 2", musicSequence2, 0},
+    {"acro", musicSequence4, 0},
+    {"rehearsal", musicSequence6, 51000},
+    {"text", textSequence0, 0},
+};
+
+const uint8_t cueCount = sizeof(cues) / sizeof(cues[0]);
+
+const struct_cue *findCue(const char *name)
+{
+  for (uint8_t i = 0; i < cueCount; i++)
+  {
+    if (!strcmp(cues[i].name, name))
+    {
+      return &cues[i];
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,21 @@
+#ifndef CUES_H
+#define CUES_H
+
+#include <sequences.h>
+
+// A named point in the show to rehearse from: a move and the ms into it,
+// which may lie in a move the first one chains into.
+typedef struct struct_cue
+{
+  const char *name;
+  moveList move;
+  uint32_t position;
+} struct_cue;
+
+extern const struct_cue cues[];
+extern const uint8_t cueCount;
+
+// nullptr if there is no cue of that name
+const struct_cue *findCue(const char *name);
+
+#endif
@@ -0,0 +1,500 @@
+#include <sequences.h>
+
+// Extracted from the old updateMoves() if-chain: each keyframe holds the full
+// state from its time on, so the last keyframe that has passed wins, like the
+// last passed moveTimePassed() block did.
+
+const uint16_t forwardLimit = 90;
+const uint16_t backwardLimit = 270;
+
+// --------------------------------
+// MARK: - stand
+
+const struct_keyframe standKeyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 60, INTERP_STEP},
+    {300, 180, 180, 100, INTERP_STEP},
+    {600, 180, 180, 150, INTERP_STEP},
+    {1000, 180, 180, 200, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - walk
+
+const struct_keyframe walkKeyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 160, 200, 140, INTERP_STEP},
+    {800, 200, 160, 140, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - walkLarge
+
+// long strides on smooth curves instead of steps
+const struct_keyframe walkLargeKeyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 150, 210, 140, INTERP_STEP},
+    {450, 180, 180, 140, INTERP_HERMITE},
+    {900, 210, 150, 140, INTERP_HERMITE},
+    {1350, 180, 180, 140, INTERP_HERMITE},
+    {1800, 150, 210, 140, INTERP_HERMITE},
+};
+
+// --------------------------------
+// MARK: - pirouette
+
+const struct_keyframe pirouetteKeyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 140, INTERP_STEP},
+    {2000, 200, 170, 300, INTERP_STEP},
+    {3000, 90, 180, 200, INTERP_STEP},
+    {3450, 170, 170, 200, INTERP_STEP},
+    {3800, 180, 180, 180, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - acroyogaSequence
+
+const struct_keyframe acroyogaSequenceKeyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 140, INTERP_STEP},
+    {3000, 155, 155, 180, INTERP_STEP},
+    {4000, 165, 165, 120, INTERP_STEP},
+    {6000, 180, 180, 200, INTERP_STEP},
+    {10500, 200, 180, 200, INTERP_STEP},
+    {11500, 180, 180, 50, INTERP_STEP},
+    {12500, 180, 200, 200, INTERP_STEP},
+    {13500, 180, 180, 50, INTERP_STEP},
+    {14500, 200, 180, 200, INTERP_STEP},
+    {15500, 180, 180, 50, INTERP_STEP},
+    {16500, 180, 200, 200, INTERP_STEP},
+    {17500, 180, 180, 50, INTERP_STEP},
+    {18500, 200, 180, 200, INTERP_STEP},
+    {19500, 180, 180, 50, INTERP_STEP},
+    {20500, 180, 200, 200, INTERP_STEP},
+    {21500, 180, 180, 50, INTERP_STEP},
+    {22500, 180, 180, 160, INTERP_STEP},
+    {25500, 90, 90, 30, INTERP_STEP},
+    {30500, 104, 104, 200, INTERP_STEP},
+    {31500, 90, 180, 120, INTERP_STEP},
+    {33000, 105, 255, 70, INTERP_STEP},
+    {34000, 120, 240, 100, INTERP_STEP},
+    {34500, 130, 230, 120, INTERP_STEP},
+    {35000, 145, 215, 100, INTERP_STEP},
+    {35500, 170, 190, 180, INTERP_STEP},
+    {37000, 190, 170, 100, INTERP_STEP},
+    {38500, 170, 190, 100, INTERP_STEP},
+    {39300, 190, 170, 120, INTERP_STEP},
+    {40100, 170, 190, 120, INTERP_STEP},
+    {44100, 190, 170, 100, INTERP_STEP},
+    {44900, 225, 135, 50, INTERP_STEP},
+    {45700, 255, 105, 50, INTERP_STEP},
+    {46500, 270, 90, 70, INTERP_STEP},
+    {49500, 90, 180, 50, INTERP_STEP},
+    {51000, 90, 90, 60, INTERP_STEP},
+    {54000, 135, 180, 140, INTERP_STEP},
+    {54500, 90, 180, 140, INTERP_STEP},
+    {57000, 180, 180, 100, INTERP_STEP},
+    {58000, 180, 180, 220, INTERP_STEP},
+    {64000, 165, 165, 200, INTERP_STEP},
+    {74000, 170, 170, 200, INTERP_STEP},
+    {75000, 175, 175, 180, INTERP_STEP},
+    {76000, 180, 180, 160, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - jump
+
+const struct_keyframe jumpKeyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 140, INTERP_STEP},
+    {2000, 135, 135, 60, INTERP_STEP},
+    {3000, 190, 190, 400, INTERP_STEP},
+    {3800, 170, 170, 200, INTERP_STEP},
+    {6000, 180, 180, 80, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - flip
+
+const struct_keyframe flipKeyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 140, INTERP_STEP},
+    {2000, 165, 165, 100, INTERP_STEP},
+    {3000, 180, 180, 200, INTERP_STEP},
+    {3300, 90, 180, 300, INTERP_STEP},
+    {3500, 90, 270, 200, INTERP_STEP},
+    {4300, 160, 160, 150, INTERP_STEP},
+    {5500, 180, 180, 150, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 0 intro
+
+const struct_keyframe musicSequence0Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 170, 170, 100, INTERP_STEP},
+    {2200, 180, 180, 100, INTERP_STEP},
+    {6300, 135, 180, 100, INTERP_STEP},
+    {8670, 165, 195, 140, INTERP_STEP},
+    {9570, 195, 165, 140, INTERP_STEP},
+    {10560, 165, 195, 140, INTERP_STEP},
+    {11470, 180, 180, 160, INTERP_STEP},
+    {14600, 180, 125, 120, INTERP_STEP},
+    {16550, 200, 160, 140, INTERP_STEP},
+    {17600, 160, 200, 140, INTERP_STEP},
+    {18650, 200, 160, 140, INTERP_STEP},
+    {19600, 180, 180, 160, INTERP_STEP},
+    {20700, 165, 165, 80, INTERP_STEP},
+    {22800, 176, 176, 100, INTERP_STEP},
+    {24800, 160, 200, 140, INTERP_STEP},
+    {25900, 200, 160, 140, INTERP_STEP},
+    {26900, 160, 200, 140, INTERP_STEP},
+    {27900, 200, 160, 140, INTERP_STEP},
+    {28900, 180, 180, 180, INTERP_STEP},
+    {29900, 200, 170, 300, INTERP_STEP},
+    {30900, 90, 180, 200, INTERP_STEP},
+    {31350, 170, 170, 200, INTERP_STEP},
+    {31700, 180, 180, 180, INTERP_STEP},
+    {32870, 165, 165, 80, INTERP_STEP},
+    {34950, 176, 176, 100, INTERP_STEP},
+    {37150, 135, 135, 60, INTERP_STEP},
+    {38280, 190, 190, 400, INTERP_STEP},
+    {39000, 170, 170, 200, INTERP_STEP},
+    {40200, 180, 180, 80, INTERP_STEP},
+    {43550, 160, 200, 140, INTERP_STEP},
+    {44600, 190, 170, 160, INTERP_STEP},
+    {45900, 90, 190, 300, INTERP_STEP},
+    {46100, 90, 270, 200, INTERP_STEP},
+    {46900, 160, 160, 150, INTERP_STEP},
+    {49840, 180, 180, 80, INTERP_STEP},
+    {54090, 160, 200, 140, INTERP_STEP},
+    {55120, 190, 170, 160, INTERP_STEP},
+    {56500, 90, 190, 300, INTERP_STEP},
+    {56700, 90, 270, 200, INTERP_STEP},
+    {57500, 160, 160, 150, INTERP_STEP},
+    {58500, 180, 180, 80, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 1 yoga
+
+const struct_keyframe musicSequence1Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 80, INTERP_STEP},
+    {600, 135, 135, 50, INTERP_STEP},
+    {3160, 180, 180, 80, INTERP_STEP},
+    {8200, 155, 155, 180, INTERP_STEP},
+    {9200, 165, 165, 120, INTERP_STEP},
+    {11200, 180, 180, 200, INTERP_STEP},
+    {12100, 200, 180, 200, INTERP_STEP},
+    {13000, 180, 180, 50, INTERP_STEP},
+    {14000, 180, 200, 200, INTERP_STEP},
+    {15000, 180, 180, 50, INTERP_STEP},
+    {15985, 200, 180, 200, INTERP_STEP},
+    {17000, 180, 180, 50, INTERP_STEP},
+    {17890, 180, 200, 200, INTERP_STEP},
+    {18900, 180, 180, 50, INTERP_STEP},
+    {19750, 200, 180, 200, INTERP_STEP},
+    {20800, 180, 180, 50, INTERP_STEP},
+    {21665, 180, 200, 200, INTERP_STEP},
+    {22650, 180, 180, 50, INTERP_STEP},
+    {25240, 90, 90, 30, INTERP_STEP},
+    {28800, 104, 104, 200, INTERP_STEP},
+    {29860, 90, 180, 120, INTERP_STEP},
+    {33270, 105, 255, 70, INTERP_STEP},
+    {35460, 120, 240, 100, INTERP_STEP},
+    {36000, 130, 230, 120, INTERP_STEP},
+    {36500, 145, 215, 100, INTERP_STEP},
+    {37000, 170, 190, 180, INTERP_STEP},
+    {38500, 190, 170, 100, INTERP_STEP},
+    {40000, 170, 190, 100, INTERP_STEP},
+    {40800, 190, 170, 120, INTERP_STEP},
+    {41600, 170, 190, 120, INTERP_STEP},
+    {43600, 190, 170, 100, INTERP_STEP},
+    {44400, 225, 135, 50, INTERP_STEP},
+    {45200, 255, 105, 50, INTERP_STEP},
+    {46000, 270, 90, 70, INTERP_STEP},
+    {48590, 90, 180, 50, INTERP_STEP},
+    {52600, 90, 90, 60, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 2 floor
+
+const struct_keyframe musicSequence2Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 90, 90, 60, INTERP_STEP},
+    {450, 135, 180, 140, INTERP_STEP},
+    {950, 90, 180, 140, INTERP_STEP},
+    {4600, 180, 180, 100, INTERP_STEP},
+    {9400, 180, 180, 220, INTERP_STEP},
+    {11140, 165, 165, 200, INTERP_STEP},
+    {19870, 170, 170, 200, INTERP_STEP},
+    {22000, 175, 175, 180, INTERP_STEP},
+    {24300, 180, 180, 160, INTERP_STEP},
+    {32470, 195, 195, 160, INTERP_STEP},
+    {33470, 180, 180, 100, INTERP_STEP},
+    {38880, 90, 180, 160, INTERP_STEP},
+    {39400, 90, 180, 200, INTERP_STEP},
+    {43740, 100, 180, 120, INTERP_STEP},
+    {43840, 110, 180, 120, INTERP_STEP},
+    {43940, 120, 180, 100, INTERP_STEP},
+    {44040, 140, 180, 100, INTERP_STEP},
+    {44140, 160, 180, 100, INTERP_STEP},
+    {44200, 180, 180, 100, INTERP_STEP},
+    {46870, 135, 135, 20, INTERP_STEP},
+    {47250, 90, 90, 80, INTERP_STEP},
+    {56370, 155, 155, 40, INTERP_STEP},
+    {57370, 180, 180, 40, INTERP_STEP},
+    {59700, 130, 180, 60, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 3 floor pt2
+
+const struct_keyframe musicSequence3Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 130, 180, 60, INTERP_STEP},
+    {600, 90, 180, 85, INTERP_STEP},
+    {7600, 90, 45, 50, INTERP_STEP},
+    {8200, 90, 90, 50, INTERP_STEP},
+    {8800, 260, 100, 60, INTERP_STEP},
+    {9800, 270, 90, 80, INTERP_STEP},
+    {10100, 270, 90, 120, INTERP_STEP},
+    {17500, 225, 135, 300, INTERP_STEP},
+    {18000, 225, 135, 200, INTERP_STEP},
+    {20720, 270, 90, 60, INTERP_STEP},
+    {24430, 270, 90, 70, INTERP_STEP},
+    {31580, 180, 90, 50, INTERP_STEP},
+    {32580, 100, 260, 60, INTERP_STEP},
+    {33100, 90, 270, 60, INTERP_STEP},
+    {35650, 150, 150, 100, INTERP_STEP},
+    {36200, 200, 150, 60, INTERP_STEP},
+    {37200, 180, 170, 120, INTERP_STEP},
+    {37500, 180, 180, 120, INTERP_STEP},
+    {39700, 155, 205, 140, INTERP_STEP},
+    {41550, 120, 210, 100, INTERP_STEP},
+    {43700, 200, 190, 120, INTERP_STEP},
+    {44630, 190, 190, 80, INTERP_STEP},
+    {51950, 260, 180, 70, INTERP_STEP},
+    {54020, 260, 260, 80, INTERP_STEP},
+    {55020, 265, 265, 120, INTERP_STEP},
+    {58090, 180, 180, 50, INTERP_STEP},
+    {59090, 180, 180, 100, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 4 standing acro
+
+const struct_keyframe musicSequence4Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 120, INTERP_STEP},
+    {185, 160, 200, 140, INTERP_STEP},
+    {1250, 200, 160, 140, INTERP_STEP},
+    {2215, 160, 200, 140, INTERP_STEP},
+    {3265, 200, 160, 140, INTERP_STEP},
+    {4305, 160, 200, 140, INTERP_STEP},
+    {5350, 200, 160, 140, INTERP_STEP},
+    {6435, 180, 180, 170, INTERP_STEP},
+    {9790, 90, 90, 80, INTERP_STEP},
+    {11850, 90, 90, 130, INTERP_STEP},
+    {15150, 180, 180, 60, INTERP_STEP},
+    {21740, 165, 165, 80, INTERP_STEP},
+    {22780, 150, 150, 80, INTERP_STEP},
+    {24380, 110, 110, 100, INTERP_STEP},
+    {28780, 180, 110, 80, INTERP_STEP},
+    {30885, 180, 180, 100, INTERP_STEP},
+    {32120, 200, 200, 100, INTERP_STEP},
+    {35436, 180, 180, 100, INTERP_STEP},
+    {36975, 162, 170, 100, INTERP_STEP},
+    {37600, 180, 180, 180, INTERP_STEP},
+    {40500, 194, 180, 180, INTERP_STEP},
+    {41100, 100, 180, 160, INTERP_STEP},
+    {41400, 90, 270, 140, INTERP_STEP},
+    {42100, 150, 150, 100, INTERP_STEP},
+    {43000, 190, 190, 100, INTERP_STEP},
+    {48335, 130, 130, 20, INTERP_STEP},
+    {48800, 90, 110, 50, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 5 fall
+
+const struct_keyframe musicSequence5Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {1925, 90, 150, 60, INTERP_STEP},
+    {3600, 90, 275, 60, INTERP_STEP},
+    {3900, 90, 275, 80, INTERP_STEP},
+    {10335, 120, 267, 100, INTERP_STEP},
+    {14425, 120, 120, 80, INTERP_STEP},
+    {15646, 95, 95, 100, INTERP_STEP},
+    {16432, 180, 180, 40, INTERP_STEP},
+    {17255, 180, 180, 120, INTERP_STEP},
+    {19309, 190, 190, 60, INTERP_STEP},
+    {20709, 170, 170, 120, INTERP_STEP},
+    {52500, 175, 150, 120, INTERP_STEP},
+    {53700, 170, 205, 120, INTERP_STEP},
+    {54100, 175, 185, 40, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 6 floor dialog
+
+const struct_keyframe musicSequence6Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {2450, 155, 155, 90, INTERP_STEP},
+    {4340, 175, 175, 90, INTERP_STEP},
+    {8025, 140, 180, 90, INTERP_STEP},
+    {8800, 180, 180, 80, INTERP_STEP},
+    {14500, 190, 180, 150, INTERP_STEP},
+    {14930, 140, 180, 160, INTERP_STEP},
+    {15280, 168, 192, 120, INTERP_STEP},
+    {22222, 180, 180, 140, INTERP_STEP},
+    {29635, 130, 180, 100, INTERP_STEP},
+    {31735, 180, 180, 100, INTERP_STEP},
+    {40575, 165, 165, 100, INTERP_STEP},
+    {41600, 180, 180, 120, INTERP_STEP},
+    {55485, 150, 180, 120, INTERP_STEP},
+    {57240, 160, 185, 120, INTERP_STEP},
+    {59400, 160, 160, 120, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 7 finale
+
+const struct_keyframe musicSequence7Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 160, 160, 120, INTERP_STEP},
+    {1765, 160, 100, 100, INTERP_STEP},
+    {6360, 170, 110, 160, INTERP_STEP},
+    {7435, 180, 180, 120, INTERP_STEP},
+    {13204, 180, 170, 100, INTERP_STEP},
+    {13510, 180, 160, 100, INTERP_STEP},
+    {13800, 180, 150, 100, INTERP_STEP},
+    {14085, 180, 140, 100, INTERP_STEP},
+    {14390, 180, 130, 100, INTERP_STEP},
+    {14650, 180, 115, 100, INTERP_STEP},
+    {14960, 180, 180, 40, INTERP_STEP},
+    {19460, 180, 180, 120, INTERP_STEP},
+    {23188, 100, 100, 60, INTERP_STEP},
+    {24741, 180, 180, 100, INTERP_STEP},
+    {28740, 165, 195, 160, INTERP_STEP},
+    {29245, 195, 165, 150, INTERP_STEP},
+    {29995, 165, 195, 150, INTERP_STEP},
+    {30680, 180, 180, 170, INTERP_STEP},
+    {32190, 100, 100, 60, INTERP_STEP},
+    {33765, 180, 180, 120, INTERP_STEP},
+    {35975, 170, 170, 80, INTERP_STEP},
+    {37870, 180, 180, 100, INTERP_STEP},
+    {49526, 165, 195, 150, INTERP_STEP},
+    {50250, 195, 165, 150, INTERP_STEP},
+    {51025, 165, 195, 150, INTERP_STEP},
+    {51740, 195, 165, 150, INTERP_STEP},
+    {52515, 165, 195, 150, INTERP_STEP},
+    {53245, 195, 165, 150, INTERP_STEP},
+    {53960, 165, 195, 150, INTERP_STEP},
+    {54690, 180, 180, 150, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - MUSIC SEQUENCE 8 toilet
+
+const struct_keyframe musicSequence8Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 180, 180, 120, INTERP_STEP},
+    {8090, 100, 180, 150, INTERP_STEP},
+    {8790, 180, 100, 150, INTERP_STEP},
+    {9480, 100, 100, 150, INTERP_STEP},
+    {10320, 180, 180, 20, INTERP_STEP},
+    {17500, 100, 260, 200, INTERP_STEP},
+    {18400, 260, 100, 200, INTERP_STEP},
+    {19300, 90, 270, 200, INTERP_STEP},
+    {20200, 270, 90, 200, INTERP_STEP},
+    {21475, 100, 100, 200, INTERP_STEP},
+    {22200, 260, 260, 200, INTERP_STEP},
+    {22600, 90, 90, 200, INTERP_STEP},
+    {23455, 260, 260, 200, INTERP_STEP},
+    {23725, 90, 90, 200, INTERP_STEP},
+    {24900, 180, 180, 30, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - TEXT SEQUENCE 0
+
+const struct_keyframe textSequence0Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 135, 135, 60, INTERP_STEP},
+    {7600, 180, 180, 20, INTERP_STEP},
+    {9250, 180, 90, 40, INTERP_STEP},
+    {9550, 180, 90, 60, INTERP_STEP},
+    {9950, 180, 90, 100, INTERP_STEP},
+    {19750, 120, 90, 100, INTERP_STEP},
+    {20550, 220, 90, 80, INTERP_STEP},
+    {21190, 120, 90, 80, INTERP_STEP},
+    {29800, 90, 90, 120, INTERP_STEP},
+    {37680, 90, 180, 20, INTERP_STEP},
+    {41760, 90, 120, 80, INTERP_STEP},
+    {42350, 90, 220, 80, INTERP_STEP},
+    {43250, 90, 180, 20, INTERP_STEP},
+    {50830, 90, 235, 70, INTERP_STEP},
+    {56360, 165, 195, 20, INTERP_STEP},
+    {59920, 120, 120, 70, INTERP_STEP},
+};
+
+// --------------------------------
+// MARK: - TEXT SEQUENCE 1 (+10s)
+
+const struct_keyframe textSequence1Keyframes[] = {
+    // time, right, left, kP x100, interpolation
+    {0, 120, 120, 80, INTERP_STEP},
+    {1500, 90, 90, 160, INTERP_STEP},
+    {2860, 110, 110, 20, INTERP_STEP},
+    {3305, 90, 90, 180, INTERP_STEP},
+    {4500, 110, 110, 20, INTERP_STEP},
+    {4900, 90, 90, 180, INTERP_STEP},
+    {6150, 110, 110, 20, INTERP_STEP},
+    {7070, 90, 90, 180, INTERP_STEP},
+    {8080, 110, 110, 20, INTERP_STEP},
+    {8700, 90, 90, 180, INTERP_STEP},
+    {9880, 110, 110, 20, INTERP_STEP},
+    {10600, 90, 90, 180, INTERP_STEP},
+    {12560, 110, 110, 20, INTERP_STEP},
+    {13640, 90, 90, 180, INTERP_STEP},
+    {14680, 110, 110, 20, INTERP_STEP},
+    {15800, 90, 60, 100, INTERP_STEP},
+    {16130, 60, 90, 100, INTERP_STEP},
+    {16430, 90, 60, 100, INTERP_STEP},
+    {17680, 60, 90, 100, INTERP_STEP},
+    {17940, 90, 60, 100, INTERP_STEP},
+    {18230, 60, 90, 100, INTERP_STEP},
+    {19090, 90, 90, 120, INTERP_STEP},
+    {21700, 165, 165, 40, INTERP_STEP},
+    {56770, 135, 135, 180, INTERP_STEP},
+    {58070, 180, 180, 20, INTERP_STEP},
+    {61000, 180, 180, 100, INTERP_STEP},
+};
+
+const struct_timeline sequences[MOVE_COUNT] = {
+    {"stop", nullptr, 0, 0, -1},
+    {"relax", nullptr, 0, 0, -1},
+    {"stand", standKeyframes, KEYFRAME_COUNT(standKeyframes), 0, -1},
+    {"walk", walkKeyframes, KEYFRAME_COUNT(walkKeyframes), 1600, walk},
+    {"walkLarge", walkLargeKeyframes, KEYFRAME_COUNT(walkLargeKeyframes), 1800, walkLarge},
+    {"pirouette", pirouetteKeyframes, KEYFRAME_COUNT(pirouetteKeyframes), 0, -1},
+    {"acroyogaSequence", acroyogaSequenceKeyframes, KEYFRAME_COUNT(acroyogaSequenceKeyframes), 0, -1},
+    {"jump", jumpKeyframes, KEYFRAME_COUNT(jumpKeyframes), 0, -1},
+    {"flip", flipKeyframes, KEYFRAME_COUNT(flipKeyframes), 0, -1},
+    {"musicSequence0", musicSequence0Keyframes, KEYFRAME_COUNT(musicSequence0Keyframes), 60000, musicSequence1},
+    {"musicSequence1", musicSequence1Keyframes, KEYFRAME_COUNT(musicSequence1Keyframes), 60000, musicSequence2},
+    {"musicSequence2", musicSequence2Keyframes, KEYFRAME_COUNT(musicSequence2Keyframes), 60000, musicSequence3},
+    {"musicSequence3", musicSequence3Keyframes, KEYFRAME_COUNT(musicSequence3Keyframes), 60000, musicSequence4},
+    {"musicSequence4", musicSequence4Keyframes, KEYFRAME_COUNT(musicSequence4Keyframes), 49999, musicSequence5},
+    {"musicSequence5", musicSequence5Keyframes, KEYFRAME_COUNT(musicSequence5Keyframes), 60000, musicSequence6},
+    {"musicSequence6", musicSequence6Keyframes, KEYFRAME_COUNT(musicSequence6Keyframes), 60000, musicSequence7},
+    {"musicSequence7", musicSequence7Keyframes, KEYFRAME_COUNT(musicSequence7Keyframes), 60000, musicSequence8},
+    {"musicSequence8", musicSequence8Keyframes, KEYFRAME_COUNT(musicSequence8Keyframes), 0, -1},
+    {"musicSequence9", nullptr, 0, 0, -1},
+    {"textSequence0", textSequence0Keyframes, KEYFRAME_COUNT(textSequence0Keyframes), 60000, textSequence1},
+    {"textSequence1", textSequence1Keyframes, KEYFRAME_COUNT(textSequence1Keyframes), 70000, musicSequence0},
+};
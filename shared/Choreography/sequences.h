@@ -0,0 +1,40 @@
+#ifndef SEQUENCES_H
+#define SEQUENCES_H
+
+#include <timeline.h>
+
+// Built-in show content, one timeline per move. stop and relax follow the
+// leg live and have no keyframes.
+enum moveList
+{
+  stop,
+  relax,
+  stand,
+  walk,
+  walkLarge,
+  pirouette,
+  acroyogaSequence,
+  jump,
+  flip,
+  musicSequence0,
+  musicSequence1,
+  musicSequence2,
+  musicSequence3,
+  musicSequence4,
+  musicSequence5,
+  musicSequence6,
+  musicSequence7,
+  musicSequence8,
+  musicSequence9,
+  textSequence0,
+  textSequence1,
+  MOVE_COUNT
+};
+
+extern const struct_timeline sequences[MOVE_COUNT];
+
+// joint range the poses are clamped to, in degrees
+extern const uint16_t forwardLimit;
+extern const uint16_t backwardLimit;
+
+#endif
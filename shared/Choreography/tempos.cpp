@@ -0,0 +1,31 @@
+#include <tempos.h>
+
+// The music sequences were timed by hand against the recordings, at about a
+// beat a second, and have no tempo changes of their own.
+const struct_tempo_map tempoMaps[] = {
+    // move, reference bpm, changes, count
+    {musicSequence0, 60, nullptr, 0},
+    {musicSequence1, 60, nullptr, 0},
+    {musicSequence2, 60, nullptr, 0},
+    {musicSequence3, 60, nullptr, 0},
+    {musicSequence4, 60, nullptr, 0},
+    {musicSequence5, 60, nullptr, 0},
+    {musicSequence6, 60, nullptr, 0},
+    {musicSequence7, 60, nullptr, 0},
+    {musicSequence8, 60, nullptr, 0},
+    {musicSequence9, 60, nullptr, 0},
+};
+
+const uint8_t tempoMapCount = sizeof(tempoMaps) / sizeof(tempoMaps[0]);
+
+const struct_tempo_map *findTempoMap(moveList move)
+{
+  for (uint8_t i = 0; i < tempoMapCount; i++)
+  {
+    if (tempoMaps[i].move == move)
+    {
+      return &tempoMaps[i];
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,23 @@
+#ifndef TEMPOS_H
+#define TEMPOS_H
+
+#include <musicClock.h>
+#include <sequences.h>
+
+// The music a move is timed to: keyframe times are ms at the reference
+// tempo, the changes are where the track itself speeds up or slows down.
+typedef struct struct_tempo_map
+{
+  moveList move;
+  float reference; // bpm
+  const struct_tempo_change *changes;
+  uint8_t count;
+} struct_tempo_map;
+
+extern const struct_tempo_map tempoMaps[];
+extern const uint8_t tempoMapCount;
+
+// nullptr if the move is not timed to music
+const struct_tempo_map *findTempoMap(moveList move);
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef ANGLE_H
+#define ANGLE_H
+
+#include <stdint.h>
+
+// A joint angle in AS5600 counts, 4096 to the turn, as the encoder reads it.
+// Sums and differences wrap by masking, so the control path needs neither
+// fmod() nor floats; degrees are for the LCD, the radio and the logs.
+//
+// a - b is the shortest way from b to a, -2048..2047 counts, and a < b when
+// that is negative, which holds within half a turn. getCounts() is the plain
+// 0..4095 from the top, for what must not take the short way round.
+class Angle
+{
+public:
+  static const uint16_t COUNTS = 4096; // a turn
+  static const uint16_t MASK = COUNTS - 1;
+
+  constexpr Angle() : counts(0)
+  {
+  }
+
+  static constexpr Angle fromCounts(int32_t counts)
+  {
+    return Angle(counts & MASK);
+  }
+  static constexpr Angle fromWholeDegrees(uint16_t degrees)
+  {
+    return fromCounts(((uint32_t)degrees * COUNTS + 180) / 360);
+  }
+  // to the nearest count
+  static Angle fromDegrees(float degrees);
+
+  constexpr uint16_t getCounts() const
+  {
+    return counts;
+  }
+  float toDegrees() const
+  {
+    return counts * (360.f / COUNTS);
+  }
+  // for the telemetry and the log, rounded
+  constexpr int16_t toTenths() const
+  {
+    return ((uint32_t)counts * 3600 + COUNTS / 2) / COUNTS;
+  }
+
+  constexpr Angle operator+(int32_t delta) const
+  {
+    return fromCounts(counts + delta);
+  }
+  constexpr Angle operator-(int32_t delta) const
+  {
+    return fromCounts(counts - delta);
+  }
+  constexpr int16_t operator-(Angle other) const
+  {
+    return ((counts - other.counts + COUNTS / 2) & MASK) - COUNTS / 2;
+  }
+
+  constexpr bool operator==(Angle other) const
+  {
+    return counts == other.counts;
+  }
+  constexpr bool operator!=(Angle other) const
+  {
+    return counts != other.counts;
+  }
+  constexpr bool operator<(Angle other) const
+  {
+    return *this - other < 0;
+  }
+  constexpr bool operator>(Angle other) const
+  {
+    return *this - other > 0;
+  }
+
+private:
+  explicit constexpr Angle(uint16_t counts) : counts(counts)
+  {
+  }
+
+  uint16_t counts;
+};
+
+inline Angle Angle::fromDegrees(float degrees)
+{
+  float counts = degrees * (COUNTS / 360.f);
+  return fromCounts((int32_t)(counts < 0 ? counts - 0.5f : counts + 0.5f));
+}
+
+#endif
@@ -0,0 +1,88 @@
+#include <floatPid.h>
+
+FloatPid::FloatPid(float *input, float *output, float *setpoint, float kP, float kI, float kD)
+    : input(input), output(output), setpoint(setpoint), kp(0), ki(0), kd(0), outMin(0),
+      outMax(255), sampleTime(100), lastTime(0), outputSum(0), lastInput(0), running(false),
+      sampled(false)
+{
+  setTunings(kP, kI, kD);
+}
+
+void FloatPid::start()
+{
+  if (running)
+  {
+    return;
+  }
+  outputSum = clamp(*output);
+  lastInput = *input;
+  running = true;
+}
+
+void FloatPid::stop()
+{
+  running = false;
+}
+
+void FloatPid::setOutputLimits(float min, float max)
+{
+  if (min >= max)
+  {
+    return;
+  }
+  outMin = min;
+  outMax = max;
+  if (running)
+  {
+    *output = clamp(*output);
+    outputSum = clamp(outputSum);
+  }
+}
+
+void FloatPid::setSampleTime(uint32_t ms)
+{
+  if (!ms)
+  {
+    return;
+  }
+  float ratio = (float)ms / sampleTime;
+  ki *= ratio;
+  kd /= ratio;
+  sampleTime = ms;
+}
+
+void FloatPid::setTunings(float kP, float kI, float kD)
+{
+  if (kP < 0 || kI < 0 || kD < 0)
+  {
+    return;
+  }
+  float seconds = sampleTime / 1000.f;
+  kp = kP;
+  ki = kI * seconds;
+  kd = kD / seconds;
+}
+
+bool FloatPid::compute(uint32_t now)
+{
+  // the first sample is due straight away, as with PID_v1
+  if (!running || (sampled && now - lastTime < sampleTime))
+  {
+    return false;
+  }
+  float in = *input;
+  float error = *setpoint - in;
+  float dInput = in - lastInput;
+  outputSum = clamp(outputSum + ki * error);
+
+  *output = clamp(kp * error + outputSum - kd * dInput);
+  lastInput = in;
+  lastTime = now;
+  sampled = true;
+  return true;
+}
+
+float FloatPid::clamp(float value)
+{
+  return value > outMax ? outMax : value < outMin ? outMin : value;
+}
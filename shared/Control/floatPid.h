@@ -0,0 +1,48 @@
+#ifndef FLOAT_PID_H
+#define FLOAT_PID_H
+
+#include <stdint.h>
+
+// PID_v1 (br3ttb) in float: proportional on error, derivative on
+// measurement, the integral clamped to the output limits, DIRECT only. The
+// ESP32 has a single precision FPU and does every double in software; the
+// leg ran this until it went to integer angles with IntPid, and
+// host/numericCheck still holds both against the double version.
+//
+// It reads and writes through pointers, as PID_v1 does, so swapping one for
+// the other leaves the callers alone. The time comes from the caller, in ms.
+class FloatPid
+{
+public:
+  FloatPid(float *input, float *output, float *setpoint, float kP, float kI, float kD);
+
+  // PID_v1's SetMode(AUTOMATIC): carries on from the current output
+  void start();
+  // SetMode(MANUAL), the output stays as it is
+  void stop();
+  void setOutputLimits(float min, float max);
+  void setSampleTime(uint32_t ms);
+  // per second, negative ones are ignored
+  void setTunings(float kP, float kI, float kD);
+
+  // a new output once the sample time has passed, returns whether there was
+  bool compute(uint32_t now);
+
+private:
+  float *input;
+  float *output;
+  float *setpoint;
+
+  float kp, ki, kd; // ki and kd per sample
+  float outMin, outMax;
+  uint32_t sampleTime; // ms
+  uint32_t lastTime;
+  float outputSum;
+  float lastInput;
+  bool running;
+  bool sampled;
+
+  float clamp(float value);
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include <intPid.h>
+
+static const float SCALE = (float)(1LL << IntPid::FRACTION) * 360 / Angle::COUNTS;
+
+static int64_t toFixed(float gain)
+{
+  return (int64_t)(gain * SCALE + 0.5f);
+}
+
+IntPid::IntPid(int16_t range, uint16_t sampleTime)
+    : limit((int64_t)range << FRACTION), sampleTime(sampleTime), kP(-1), kI(-1), kD(-1), kp(0),
+      ki(0), kd(0), outputSum(0), output(0), lastTime(0), running(false), sampled(false)
+{
+}
+
+void IntPid::setTunings(float kP, float kI, float kD)
+{
+  if (kP < 0 || kI < 0 || kD < 0 || (kP == this->kP && kI == this->kI && kD == this->kD))
+  {
+    return;
+  }
+  this->kP = kP;
+  this->kI = kI;
+  this->kD = kD;
+  float seconds = sampleTime / 1000.f;
+  kp = toFixed(kP);
+  ki = toFixed(kI * seconds);
+  kd = toFixed(kD / seconds);
+}
+
+void IntPid::start(Angle input, int32_t output)
+{
+  if (running)
+  {
+    return;
+  }
+  this->output = output;
+  outputSum = clamp((int64_t)output << (FRACTION - OUTPUT_FRACTION));
+  lastInput = input;
+  running = true;
+}
+
+void IntPid::stop()
+{
+  running = false;
+}
+
+bool IntPid::compute(Angle setpoint, Angle input, uint32_t now)
+{
+  if (!running || (sampled && now - lastTime < sampleTime))
+  {
+    return false;
+  }
+  int32_t error = (int32_t)setpoint.getCounts() - input.getCounts();
+  int32_t dInput = (int32_t)input.getCounts() - lastInput.getCounts();
+  outputSum = clamp(outputSum + term(ki, error));
+
+  output = clamp(term(kp, error) + outputSum - term(kd, dInput)) >> (FRACTION - OUTPUT_FRACTION);
+  lastInput = input;
+  lastTime = now;
+  sampled = true;
+  return true;
+}
+
+int32_t IntPid::getOutput()
+{
+  return output;
+}
+
+int64_t IntPid::clamp(int64_t value)
+{
+  return value > limit ? limit : value < -limit ? -limit : value;
+}
+
+int64_t IntPid::term(int64_t gain, int32_t counts)
+{
+  // a quarter of the range each, so three of them still add up
+  const int64_t MAX = INT64_MAX / 4;
+  int64_t product;
+  if (__builtin_mul_overflow(gain, (int64_t)counts, &product) || product > MAX || product < -MAX)
+  {
+    return (gain < 0) == (counts < 0) ? MAX : -MAX;
+  }
+  return product;
+}
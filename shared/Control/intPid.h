@@ -0,0 +1,62 @@
+#ifndef INT_PID_H
+#define INT_PID_H
+
+#include <angle.h>
+#include <stdint.h>
+
+// FloatPid's algorithm on Angles, in integers: proportional on error,
+// derivative on measurement, the integral clamped to the output limits.
+// The terms add up in 64-bit fixed point with FRACTION bits, which the
+// ESP32 does in a few 32-bit multiplies; a term too large for them
+// saturates, far past the output limits.
+//
+// The error is getCounts() apart, not the short way round: a joint either
+// side of the top is driven back the long way, as the float PID did.
+//
+// The gains are per degree and per second, as FloatPid takes them, so the
+// remote's kP works unchanged. They are converted to fixed point when they
+// change, not every sample.
+class IntPid
+{
+public:
+  static const uint8_t FRACTION = 32;        // bits of the sums
+  static const uint8_t OUTPUT_FRACTION = 16; // bits of getOutput()
+  static const int32_t ONE = 1 << OUTPUT_FRACTION; // an output of 1 PWM
+
+  // the output is -range..range PWM, a sample every sampleTime ms
+  IntPid(int16_t range, uint16_t sampleTime);
+
+  // negative ones are ignored
+  void setTunings(float kP, float kI, float kD);
+  // carries on from output, PWM << OUTPUT_FRACTION
+  void start(Angle input, int32_t output = 0);
+  void stop();
+
+  // a new output once the sample time has passed, returns whether there was
+  bool compute(Angle setpoint, Angle input, uint32_t now);
+  int32_t getOutput();
+
+  // whole PWM, truncated towards 0 as a float converts
+  static int16_t toPwm(int32_t output)
+  {
+    return output / ONE;
+  }
+
+private:
+  int64_t limit; // range << FRACTION
+  uint16_t sampleTime;
+  float kP, kI, kD;  // as given
+  int64_t kp, ki, kd; // PWM << FRACTION per count, per count and sample, per count a sample
+
+  int64_t outputSum;
+  int32_t output;
+  Angle lastInput;
+  uint32_t lastTime;
+  bool running;
+  bool sampled;
+
+  int64_t clamp(int64_t value);
+  static int64_t term(int64_t gain, int32_t counts);
+};
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef MOTOR_CONTROLLER_H
+#define MOTOR_CONTROLLER_H
+
+#include <angle.h>
+#include <intPid.h>
+#include <stdint.h>
+
+// The duty controlMotorPID() writes for an IntPid output, positive = backward
+// channel: 0 within +-1 PWM, past Joint::DEADBAND beyond it as Arduino's
+// map() puts it, and lastDuty for exactly +-1.
+template <typename Pwm, typename Joint>
+int16_t deadbandDuty(int32_t output, int16_t lastDuty)
+{
+  if (output == IntPid::ONE || output == -IntPid::ONE)
+  {
+    return lastDuty;
+  }
+  if (output > -IntPid::ONE && output < IntPid::ONE)
+  {
+    return 0;
+  }
+  int32_t pwm = IntPid::toPwm(output);
+  int32_t magnitude = pwm < 0 ? -pwm : pwm;
+  magnitude = magnitude * (Pwm::RANGE - Joint::DEADBAND) / Pwm::RANGE + Joint::DEADBAND;
+  return pwm < 0 ? -magnitude : magnitude;
+}
+
+// A joint's PID, from a position Source to a PWM Sink, with the deadband
+// and the range of a robot profile (shared/Robot/robotProfile.h).
+//
+// Source has Angle getPosition(). Sink has begin() and write(int16_t duty),
+// -RANGE..RANGE with positive the backward channel: LedcPwm and McpwmPwm on
+// the leg, RecordingPwm on the host. The calls resolve at compile time and
+// inline, so a stateless sink costs what a direct ledcWrite() does.
+//
+// The Sink is a member, the Source is shared: main.cpp reads the raw
+// encoder counts as well.
+template <typename Profile, typename Joint, typename Sink, typename Source>
+class MotorController
+{
+public:
+  typedef typename Profile::Pwm Pwm;
+
+  explicit MotorController(Source &source) : source(source), pid(Pwm::RANGE, 1)
+  {
+    pid.setTunings(Kp, Ki, Kd);
+    pid.start(source.getPosition());
+  }
+
+  void begin()
+  {
+    sink.begin();
+  }
+
+  // restarts the PID from the source's position, with a zero output
+  void start()
+  {
+    pid.stop();
+    pid.start(source.getPosition());
+  }
+
+  // now in ms, as for IntPid
+  void update(uint32_t now)
+  {
+    updatePid(now);
+    updateMotor();
+  }
+
+  // the two halves of update(), for a loop that times them apart; true if
+  // the PID computed, on its sample time
+  bool updatePid(uint32_t now)
+  {
+    return pid.compute(pidTarget, source.getPosition(), now);
+  }
+
+  void updateMotor()
+  {
+    duty = deadbandDuty<Pwm, Joint>(pid.getOutput(), duty);
+    sink.write(duty);
+  }
+
+  void setTarget(Angle target)
+  {
+    pidTarget = target;
+  }
+
+  void setKp(float Kp)
+  {
+    this->Kp = Kp;
+    pid.setTunings(this->Kp, this->Ki, this->Kd);
+  }
+
+  void setKi(float Ki)
+  {
+    this->Ki = Ki;
+    pid.setTunings(this->Kp, this->Ki, this->Kd);
+  }
+
+  void setKd(float Kd)
+  {
+    this->Kd = Kd;
+    pid.setTunings(this->Kp, this->Ki, this->Kd);
+  }
+
+  void setTunings(float Kp, float Ki, float Kd)
+  {
+    this->Kp = Kp;
+    this->Ki = Ki;
+    this->Kd = Kd;
+    pid.setTunings(Kp, Ki, Kd);
+  }
+
+  Angle getTarget()
+  {
+    return pidTarget;
+  }
+  float getKp()
+  {
+    return Kp;
+  }
+  float getKi()
+  {
+    return Ki;
+  }
+  float getKd()
+  {
+    return Kd;
+  }
+  int32_t getOutput()
+  {
+    return pid.getOutput();
+  }
+  int16_t getDuty()
+  {
+    return duty;
+  }
+  Sink &getSink()
+  {
+    return sink;
+  }
+
+private:
+  Angle pidTarget;
+  // Kp = proportional gain, Ki = integral gain, Kd = derivative gain
+  float Kp = 1, Ki = 0, Kd = 0;
+  int16_t duty = 0;
+
+  Source &source;
+  Sink sink;
+  IntPid pid;
+};
+
+#endif
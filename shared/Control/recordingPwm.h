@@ -0,0 +1,59 @@
+#ifndef RECORDING_PWM_H
+#define RECORDING_PWM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A MotorController sink off the robot: keeps the duties written, the first
+// CAPACITY of them, for the host checks and benchmarks (host/motorCheck).
+class RecordingPwm
+{
+public:
+  static const size_t CAPACITY = 1024;
+
+  void begin()
+  {
+    began = true;
+  }
+
+  void write(int16_t duty)
+  {
+    if (count < CAPACITY)
+    {
+      duties[count] = duty;
+    }
+    count++;
+    last = duty;
+  }
+
+  void clear()
+  {
+    count = 0;
+  }
+
+  bool isBegun()
+  {
+    return began;
+  }
+  // all writes, also those past CAPACITY
+  size_t getCount()
+  {
+    return count;
+  }
+  int16_t get(size_t index)
+  {
+    return duties[index];
+  }
+  int16_t getLast()
+  {
+    return last;
+  }
+
+private:
+  int16_t duties[CAPACITY];
+  size_t count = 0;
+  int16_t last = 0;
+  bool began = false;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include <inputTake.h>
+#include <string.h>
+
+static size_t putVarint(uint8_t *out, uint32_t v)
+{
+  size_t n = 0;
+  while (v >= 0x80)
+  {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+static bool getVarint(const uint8_t *data, size_t len, size_t &offset, uint32_t &value)
+{
+  uint32_t v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7)
+  {
+    if (offset >= len)
+    {
+      return false;
+    }
+    uint8_t b = data[offset++];
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80))
+    {
+      value = v;
+      return true;
+    }
+  }
+  return false;
+}
+
+static uint32_t zigzag(int32_t value)
+{
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t v)
+{
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+void InputTakeEncoder::begin(uint32_t now)
+{
+  memset(&previous, 0, sizeof(previous));
+  start = now;
+  last = now;
+  records = 0;
+}
+
+size_t InputTakeEncoder::add(const struct_input_sample &sample, uint32_t now, uint8_t *out)
+{
+  uint8_t mask = 0;
+  for (uint8_t i = 0; i < INPUT_CHANNELS; i++)
+  {
+    if (sample.channels[i] != previous.channels[i])
+    {
+      mask |= 1 << i;
+    }
+  }
+  if (!mask && !sample.key)
+  {
+    return 0;
+  }
+
+  // the lowest bit of the time says a key byte follows
+  size_t n = putVarint(out, (now - last) << 1 | (sample.key ? 1 : 0));
+  out[n++] = mask;
+  for (uint8_t i = 0; i < INPUT_CHANNELS; i++)
+  {
+    if (mask & (1 << i))
+    {
+      n += putVarint(out + n, zigzag((int32_t)sample.channels[i] - previous.channels[i]));
+    }
+  }
+  if (sample.key)
+  {
+    out[n++] = sample.key;
+  }
+
+  memcpy(previous.channels, sample.channels, sizeof(previous.channels));
+  last = now;
+  records++;
+  return n;
+}
+
+uint32_t InputTakeEncoder::getRecords()
+{
+  return records;
+}
+
+uint32_t InputTakeEncoder::getDuration()
+{
+  return last - start;
+}
+
+void InputTakeDecoder::begin(const uint8_t *data, size_t len)
+{
+  this->data = data;
+  this->len = len;
+  offset = 0;
+  time = 0;
+  memset(&previous, 0, sizeof(previous));
+}
+
+bool InputTakeDecoder::next(struct_input_sample &sample, uint32_t &time)
+{
+  uint32_t token;
+  if (!getVarint(data, len, offset, token) || offset >= len)
+  {
+    offset = len; // end, or truncated
+    return false;
+  }
+  uint8_t mask = data[offset++];
+
+  struct_input_sample decoded = previous;
+  for (uint8_t i = 0; i < INPUT_CHANNELS; i++)
+  {
+    uint32_t delta;
+    if (!(mask & (1 << i)))
+    {
+      continue;
+    }
+    if (!getVarint(data, len, offset, delta))
+    {
+      offset = len;
+      return false;
+    }
+    decoded.channels[i] = previous.channels[i] + unzigzag(delta);
+  }
+  decoded.key = 0;
+  if (token & 1)
+  {
+    if (offset >= len)
+    {
+      offset = len;
+      return false;
+    }
+    decoded.key = data[offset++];
+  }
+
+  this->time += token >> 1;
+  time = this->time;
+  previous = decoded;
+  sample = decoded;
+  return true;
+}
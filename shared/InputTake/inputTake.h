@@ -0,0 +1,68 @@
+#ifndef INPUT_TAKE_H
+#define INPUT_TAKE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A take is the remote's raw input stream, recorded so it can be fed back
+// through the same pipeline later. Every loop that changes something adds a
+// record: the time since the previous record, a mask of the channels that
+// changed, their zigzag varint deltas and the key pressed, if any. A take
+// only decodes from its start.
+
+const uint32_t INPUT_TAKE_MAGIC = 0x454B4154; // "TAKE"
+const uint16_t INPUT_TAKE_VERSION = 1;
+const uint8_t INPUT_CHANNELS = 8; // sliders RA, RL, LL, LA, joysticks LX, LY, RX, RY
+const size_t INPUT_TAKE_MAX_RECORD_SIZE = 5 + 1 + 3 * INPUT_CHANNELS + 1;
+
+typedef struct struct_input_sample
+{
+  int16_t channels[INPUT_CHANNELS]; // ads counts, then analogRead() counts
+  char key;                         // 0 = no key, as Keypad's NO_KEY
+} struct_input_sample;
+
+typedef struct struct_input_take_header
+{
+  uint32_t magic;
+  uint16_t version;
+  uint8_t mode;      // remote mode the take started in
+  uint8_t sequence;  // one more than the previous take's, the newer one wins
+  uint32_t size;     // bytes of records
+  uint32_t records;
+  uint32_t duration; // ms from the start to the last record
+} struct_input_take_header;
+
+class InputTakeEncoder
+{
+public:
+  void begin(uint32_t now);
+  // writes the record for the sample at now to out, which must hold
+  // INPUT_TAKE_MAX_RECORD_SIZE bytes; returns 0 if nothing changed
+  size_t add(const struct_input_sample &sample, uint32_t now, uint8_t *out);
+  uint32_t getRecords();
+  uint32_t getDuration();
+
+private:
+  struct_input_sample previous;
+  uint32_t start;
+  uint32_t last;
+  uint32_t records;
+};
+
+class InputTakeDecoder
+{
+public:
+  // data holds the records, as counted in the header
+  void begin(const uint8_t *data, size_t len);
+  // the input from the next record on, time is ms since the start
+  bool next(struct_input_sample &sample, uint32_t &time);
+
+private:
+  const uint8_t *data;
+  size_t len;
+  size_t offset;
+  uint32_t time;
+  struct_input_sample previous;
+};
+
+#endif
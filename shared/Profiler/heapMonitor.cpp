@@ -0,0 +1,200 @@
+#include <heapMonitor.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_system.h>
+#include <rom/ets_sys.h>
+#endif
+
+#ifdef HEAP_MONITOR
+HeapMonitor heapMonitor;
+
+// linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc, see env:debug
+extern "C"
+{
+  void *__real_malloc(size_t size);
+  void *__real_calloc(size_t count, size_t size);
+  void *__real_realloc(void *pointer, size_t size);
+
+  void *__wrap_malloc(size_t size)
+  {
+    heapMonitor.count(__builtin_return_address(0));
+    return __real_malloc(size);
+  }
+
+  void *__wrap_calloc(size_t count, size_t size)
+  {
+    heapMonitor.count(__builtin_return_address(0));
+    return __real_calloc(count, size);
+  }
+
+  void *__wrap_realloc(void *pointer, size_t size)
+  {
+    heapMonitor.count(__builtin_return_address(0));
+    return __real_realloc(pointer, size);
+  }
+}
+#endif
+
+static void *currentTask()
+{
+#ifdef ARDUINO
+  // the global constructors allocate before there are tasks
+  if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+  {
+    return nullptr;
+  }
+  return xTaskGetCurrentTaskHandle();
+#else
+  return (void *)1;
+#endif
+}
+
+static const char *taskName(void *handle)
+{
+#ifdef ARDUINO
+  return pcTaskGetName((TaskHandle_t)handle);
+#else
+  return "host";
+#endif
+}
+
+// arg = stack high-water mark, v0..v1 = allocations, v2..v3 = the name
+static void logTask(BinaryLog &log, const char *name, uint32_t stack, uint32_t allocations,
+                    uint32_t steady)
+{
+  int32_t packed[2] = {};
+  strncpy((char *)packed, name, sizeof(packed));
+  log.log(LOG_HEAP_TASK, stack < 0xFFFF ? stack : 0xFFFF, allocations, steady, packed[0], packed[1]);
+}
+
+HeapMonitor::Task *HeapMonitor::find(void *handle, bool claim)
+{
+  // entries are claimed in order and never given back
+  for (uint8_t i = 0; i < MAX_TASKS; i++)
+  {
+    void *current = tasks[i].handle.load(std::memory_order_acquire);
+    if (current == handle)
+    {
+      return &tasks[i];
+    }
+    if (current)
+    {
+      continue;
+    }
+    if (!claim)
+    {
+      return nullptr;
+    }
+    if (tasks[i].handle.compare_exchange_strong(current, handle) || current == handle)
+    {
+      return &tasks[i];
+    }
+  }
+  return nullptr;
+}
+
+void HeapMonitor::watch()
+{
+  Task *task = find(currentTask(), true);
+  if (task)
+  {
+    task->watched = true;
+  }
+}
+
+void HeapMonitor::steady()
+{
+  isSteadyState.store(true);
+}
+
+bool HeapMonitor::isSteady()
+{
+  return isSteadyState.load(std::memory_order_relaxed);
+}
+
+void HeapMonitor::count(void *caller)
+{
+  void *handle = currentTask();
+  Task *task = handle ? find(handle, true) : nullptr;
+  if (!task)
+  {
+    unknown.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  task->allocations.fetch_add(1, std::memory_order_relaxed);
+  if (!isSteady())
+  {
+    return;
+  }
+  task->steady.fetch_add(1, std::memory_order_relaxed);
+#ifdef HEAP_MONITOR_STRICT
+  if (task->watched)
+  {
+    fail(*task, caller);
+  }
+#else
+  (void)caller;
+#endif
+}
+
+void HeapMonitor::fail(const Task &task, void *caller)
+{
+#ifdef ARDUINO
+  // no Serial, it could allocate again
+  ets_printf("\nheap allocation in steady state: task %s, caller %p\n",
+             taskName(task.handle.load()), caller);
+#endif
+  abort();
+}
+
+void HeapMonitor::report(BinaryLog &log)
+{
+#ifdef ARDUINO
+  log.log(LOG_HEAP, isSteady(), esp_get_free_heap_size(), esp_get_minimum_free_heap_size(),
+          heap_caps_get_largest_free_block(MALLOC_CAP_8BIT), unknown.load());
+
+#if configUSE_TRACE_FACILITY
+  // every live task, those that never allocated too; 0 if there are more
+  // than MAX_TASKS of them
+  static TaskStatus_t status[MAX_TASKS];
+  UBaseType_t live = uxTaskGetSystemState(status, MAX_TASKS, nullptr);
+  for (UBaseType_t i = 0; i < live; i++)
+  {
+    Task *task = find(status[i].xHandle, false);
+    logTask(log, status[i].pcTaskName, status[i].usStackHighWaterMark,
+            task ? task->allocations.load() : 0, task ? task->steady.load() : 0);
+  }
+  if (live)
+  {
+    return;
+  }
+#endif
+#else
+  log.log(LOG_HEAP, isSteady(), 0, 0, 0, unknown.load());
+#endif
+
+  // the tasks that allocated; a system task may be gone by now, so only the
+  // watched ones have their stack looked at
+  for (uint8_t i = 0; i < MAX_TASKS; i++)
+  {
+    const Task &task = tasks[i];
+    void *handle = task.handle.load(std::memory_order_acquire);
+    if (!handle)
+    {
+      break;
+    }
+    uint32_t stack = 0xFFFF;
+#ifdef ARDUINO
+    if (task.watched)
+    {
+      stack = uxTaskGetStackHighWaterMark((TaskHandle_t)handle);
+    }
+#endif
+    logTask(log, task.watched ? taskName(handle) : "", stack, task.allocations.load(),
+            task.steady.load());
+  }
+}
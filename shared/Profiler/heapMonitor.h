@@ -0,0 +1,62 @@
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <atomic>
+#include <stdint.h>
+
+#include <binaryLog.h>
+
+// Counts the heap allocations of every task, so anything that allocates once
+// the firmware is running shows up. Build with -D HEAP_MONITOR and the
+// linker's --wrap for malloc, calloc and realloc (env:debug): every
+// allocation, new and String included, comes through count() first.
+//
+// Allocations before steady() are setup's and only counted. After it the
+// tasks that called watch() must not allocate at all; with
+// -D HEAP_MONITOR_STRICT the first one that does stops the firmware with the
+// task's name and the caller's address. WiFi and the other system tasks
+// allocate as they like, their counts are only reported.
+//
+// report() logs the free heap, its low-water mark and the largest free block,
+// then every task's allocations and stack high-water mark.
+//
+// There is no constructor: malloc runs before the global constructors do, so
+// the monitor has to be usable zero-initialized.
+
+class HeapMonitor
+{
+public:
+  static const uint8_t MAX_TASKS = 24;
+
+  // the calling task, e.g. loop()'s from setup()
+  void watch();
+  void steady();
+  bool isSteady();
+
+  // from the malloc wrappers
+  void count(void *caller);
+
+  void report(BinaryLog &log);
+
+private:
+  struct Task
+  {
+    std::atomic<void *> handle;
+    std::atomic<uint32_t> allocations; // since boot
+    std::atomic<uint32_t> steady;      // since steady()
+    bool watched;
+  };
+
+  Task tasks[MAX_TASKS];
+  std::atomic<uint32_t> unknown; // before the scheduler, or past MAX_TASKS
+  std::atomic<bool> isSteadyState;
+
+  Task *find(void *handle, bool claim);
+  void fail(const Task &task, void *caller);
+};
+
+#ifdef HEAP_MONITOR
+extern HeapMonitor heapMonitor;
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+#include <loopProfiler.h>
+#include <string.h>
+
+// four buckets per octave, values below 4 get one each
+static uint8_t bucketOf(uint32_t cycles)
+{
+  if (cycles < 4)
+  {
+    return cycles;
+  }
+  uint8_t msb = 31 - __builtin_clz(cycles);
+  return msb * 4 + ((cycles >> (msb - 2)) & 3);
+}
+
+// the largest value that falls in the bucket
+static uint32_t bucketTop(uint8_t bucket)
+{
+  if (bucket < 4)
+  {
+    return bucket;
+  }
+  uint8_t msb = bucket / 4;
+  return (((uint64_t)(4 + bucket % 4 + 1)) << (msb - 2)) - 1;
+}
+
+LoopProfiler::LoopProfiler(const char *const *names, uint8_t zones)
+    : names(names), zones(zones < MAX_ZONES ? zones : MAX_ZONES), lastTick(0), cursor(0)
+{
+  reset();
+}
+
+void LoopProfiler::reset()
+{
+  memset(stats, 0, sizeof(stats));
+  for (uint8_t i = 0; i < MAX_ZONES; i++)
+  {
+    stats[i].min = UINT32_MAX;
+  }
+}
+
+void LoopProfiler::add(uint8_t zone, uint32_t cycles)
+{
+  if (zone >= zones)
+  {
+    return;
+  }
+  Zone &z = stats[zone];
+  z.count++;
+  z.sum += cycles;
+  z.min = cycles < z.min ? cycles : z.min;
+  z.max = cycles > z.max ? cycles : z.max;
+
+  uint16_t &bucket = z.buckets[bucketOf(cycles)];
+  if (bucket == UINT16_MAX)
+  {
+    // keeps the shape, and lets recent samples weigh a little more
+    for (uint8_t i = 0; i < BUCKETS; i++)
+    {
+      z.buckets[i] /= 2;
+    }
+  }
+  bucket++;
+}
+
+void LoopProfiler::tick(uint8_t zone)
+{
+  uint32_t now = profileCycles();
+  if (lastTick)
+  {
+    add(zone, now - lastTick);
+  }
+  lastTick = now;
+}
+
+bool LoopProfiler::get(uint8_t zone, struct_profile_stats &out)
+{
+  out.zone = zone;
+  if (zone >= zones || !stats[zone].count)
+  {
+    out.count = out.min = out.mean = out.max = out.p99 = 0;
+    return false;
+  }
+  const Zone &z = stats[zone];
+  out.count = z.count;
+  out.min = z.min;
+  out.mean = z.sum / z.count;
+  out.max = z.max;
+
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < BUCKETS; i++)
+  {
+    total += z.buckets[i];
+  }
+  uint32_t below = total - total / 100; // samples at or under the p99
+  uint32_t seen = 0;
+  out.p99 = z.max;
+  for (uint8_t i = 0; i < BUCKETS; i++)
+  {
+    seen += z.buckets[i];
+    if (seen >= below)
+    {
+      uint32_t top = bucketTop(i);
+      out.p99 = top < z.max ? top : z.max;
+      break;
+    }
+  }
+  return true;
+}
+
+void LoopProfiler::next(struct_profile_stats &out)
+{
+  get(cursor, out);
+  cursor = (cursor + 1) % zones;
+}
+
+uint8_t LoopProfiler::getZones()
+{
+  return zones;
+}
+
+const char *LoopProfiler::getName(uint8_t zone)
+{
+  return zone < zones ? names[zone] : "";
+}
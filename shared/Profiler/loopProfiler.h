@@ -0,0 +1,86 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <stdint.h>
+
+#include <protocol.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+// Cycle counts of the stages of loop(), per zone: min, mean, max and a p99
+// from a histogram with four buckets per octave, in fixed memory.
+//
+// Build with -D LOOP_PROFILER to turn it on. Without it PROFILE() is only the
+// statement it wraps, and nothing else here needs to be compiled in.
+//
+//   PROFILE(loopProfiler, LEG_ZONE_PID, updatePID());
+//
+// Zones may nest, a zone then includes the ones inside it.
+
+#ifdef LOOP_PROFILER
+#define PROFILE(profiler, zone, statement)                                                         \
+  do                                                                                               \
+  {                                                                                                \
+    uint32_t profileStart = profileCycles();                                                       \
+    statement;                                                                                     \
+    (profiler).add(zone, profileCycles() - profileStart);                                          \
+  } while (0)
+// cycles since the last tick, once per loop() gives the whole loop
+#define PROFILE_TICK(profiler, zone) (profiler).tick(zone)
+#else
+#define PROFILE(profiler, zone, statement) statement
+#define PROFILE_TICK(profiler, zone)
+#endif
+
+inline uint32_t profileCycles()
+{
+#ifdef ARDUINO
+  return ESP.getCycleCount();
+#else
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+class LoopProfiler
+{
+public:
+  static const uint8_t MAX_ZONES = 16;
+  static const uint8_t BUCKETS = 128; // up to 2^32 cycles
+
+  LoopProfiler(const char *const *names, uint8_t zones);
+
+  void add(uint8_t zone, uint32_t cycles);
+  void tick(uint8_t zone);
+  void reset();
+
+  // false if the zone has no samples yet
+  bool get(uint8_t zone, struct_profile_stats &stats);
+  // the zones in turn, for sending or logging one at a time
+  void next(struct_profile_stats &stats);
+
+  uint8_t getZones();
+  const char *getName(uint8_t zone);
+
+private:
+  struct Zone
+  {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t buckets[BUCKETS]; // halved together when one would overflow
+  };
+
+  const char *const *names;
+  uint8_t zones;
+  Zone stats[MAX_ZONES];
+  uint32_t lastTick;
+  uint8_t cursor;
+};
+
+#endif
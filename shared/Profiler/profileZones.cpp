@@ -0,0 +1,11 @@
+#include <profileZones.h>
+
+const char *const legZoneNames[LEG_ZONE_COUNT] = {
+    "loop", "led", "positions", "buttons", "lcd", "battery", "playback",
+    "pid", "motors", "teach", "telemetry", "send", "print",
+};
+
+const char *const remoteZoneNames[REMOTE_ZONE_COUNT] = {
+    "loop", "battery", "encoder", "lcd", "switch", "cueList", "led",
+    "ads", "inputs", "buttons", "moves", "send", "serial",
+};
@@ -0,0 +1,48 @@
+#ifndef PROFILE_ZONES_H
+#define PROFILE_ZONES_H
+
+#include <stdint.h>
+
+// The profiled stages of each firmware's loop(), shared so the remote can
+// name the zones the leg reports.
+
+enum LegZone : uint8_t
+{
+  LEG_ZONE_LOOP,
+  LEG_ZONE_LED,
+  LEG_ZONE_POSITIONS,
+  LEG_ZONE_BUTTONS,
+  LEG_ZONE_LCD,
+  LEG_ZONE_BATTERY,
+  LEG_ZONE_PLAYBACK,
+  LEG_ZONE_PID,
+  LEG_ZONE_MOTORS,
+  LEG_ZONE_TEACH,
+  LEG_ZONE_TELEMETRY,
+  LEG_ZONE_SEND,
+  LEG_ZONE_PRINT,
+  LEG_ZONE_COUNT,
+};
+
+enum RemoteZone : uint8_t
+{
+  REMOTE_ZONE_LOOP,
+  REMOTE_ZONE_BATTERY,
+  REMOTE_ZONE_ENCODER,
+  REMOTE_ZONE_LCD,
+  REMOTE_ZONE_SWITCH,
+  REMOTE_ZONE_CUE_LIST,
+  REMOTE_ZONE_LED,
+  REMOTE_ZONE_ADS,
+  REMOTE_ZONE_INPUTS,
+  REMOTE_ZONE_BUTTONS, // includes moves
+  REMOTE_ZONE_MOVES,
+  REMOTE_ZONE_SEND,
+  REMOTE_ZONE_SERIAL,
+  REMOTE_ZONE_COUNT,
+};
+
+extern const char *const legZoneNames[LEG_ZONE_COUNT];
+extern const char *const remoteZoneNames[REMOTE_ZONE_COUNT];
+
+#endif
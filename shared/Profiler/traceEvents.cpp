@@ -0,0 +1,6 @@
+#include <traceEvents.h>
+
+const char *const traceNames[TRACE_ID_COUNT] = {
+    "radioReceive", "radioSent", "radioSend", "radioLost", "i2cEncoderR", "i2cEncoderL",
+    "i2cExpander",  "i2cAds",    "i2cKeypad", "pidR",      "pidL",        "lcdFlush",
+};
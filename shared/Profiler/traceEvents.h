@@ -0,0 +1,36 @@
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+#include <stdint.h>
+
+// What the trace ring records, on both firmwares, shared so host/traceExport
+// can name them.
+
+enum TraceId : uint16_t
+{
+  TRACE_RADIO_RECEIVE, // ESP-NOW receive callback
+  TRACE_RADIO_SENT,    // ESP-NOW send callback
+  TRACE_RADIO_SEND,    // transport.send()
+  TRACE_RADIO_LOST,    // mark, a send that was not delivered
+  TRACE_I2C_ENCODER_R, // mux port and AS5600 angle
+  TRACE_I2C_ENCODER_L,
+  TRACE_I2C_EXPANDER,
+  TRACE_I2C_ADS,
+  TRACE_I2C_KEYPAD,
+  TRACE_PID_R,
+  TRACE_PID_L,
+  TRACE_LCD_FLUSH,
+  TRACE_ID_COUNT,
+};
+
+enum TracePhase : uint8_t
+{
+  TRACE_PHASE_BEGIN,
+  TRACE_PHASE_END,
+  TRACE_PHASE_MARK,
+  TRACE_PHASE_CLOCK, // micros() at that cycle count in place of the task, CPU MHz as the id
+};
+
+extern const char *const traceNames[TRACE_ID_COUNT];
+
+#endif
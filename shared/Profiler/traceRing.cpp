@@ -0,0 +1,223 @@
+#include <traceRing.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+#ifdef TRACE_EVENTS
+TraceRing traceRing;
+#endif
+
+static uint8_t traceCore()
+{
+#ifdef ARDUINO
+  return xPortGetCoreID();
+#else
+  return 0;
+#endif
+}
+
+static uint32_t traceTask()
+{
+#ifdef ARDUINO
+  return (uint32_t)xTaskGetCurrentTaskHandle();
+#else
+  return 0;
+#endif
+}
+
+static uint32_t traceMicros()
+{
+#ifdef ARDUINO
+  return micros();
+#else
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// cycles per microsecond, profileCycles() counts nanoseconds on the host
+static uint16_t traceMHz()
+{
+#ifdef ARDUINO
+  return ESP.getCpuFreqMHz();
+#else
+  return 1000;
+#endif
+}
+
+TraceRing::TraceRing()
+    : recording(true), dumping(false), dumpCore(CORES), dumpIndex(0), dumpEnd(0), dumpCount(0),
+      lastDrain(0), budget(0), taskCount(0)
+{
+  for (uint8_t core = 0; core < CORES; core++)
+  {
+    Ring &ring = rings[core];
+    for (uint16_t i = 0; i < CAPACITY; i++)
+    {
+      ring.cells[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    ring.head.store(0, std::memory_order_relaxed);
+    ring.lastClock = 0;
+    ring.lastClockIndex = -(uint32_t)CAPACITY; // the first event brings one
+    ring.dumped = 0;
+  }
+}
+
+void TraceRing::record(uint16_t id, uint8_t phase)
+{
+  if (!recording.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  uint32_t cycles = profileCycles();
+  uint8_t core = traceCore();
+  Ring &ring = rings[core];
+
+  // the cycle counters of the two cores are not in step, a clock event now
+  // and then, and every quarter ring, ties each to micros() for the host
+  uint32_t head = ring.head.load(std::memory_order_relaxed);
+  if (cycles - ring.lastClock > CLOCK_CYCLES || head - ring.lastClockIndex >= CAPACITY / 4)
+  {
+    ring.lastClock = cycles;
+    ring.lastClockIndex = head;
+    push(ring, {cycles, traceMicros(), traceMHz(), TRACE_PHASE_CLOCK, core});
+  }
+  push(ring, {cycles, traceTask(), id, phase, core});
+}
+
+void TraceRing::push(Ring &ring, const struct_trace_event &event)
+{
+  // only tasks on this core write this ring, one preempting another gets the
+  // next index; the oldest event is overwritten, the sequence tells a reader
+  // whether the cell holds the event it expects
+  uint32_t index = ring.head.fetch_add(1, std::memory_order_relaxed);
+  Cell &cell = ring.cells[index & (CAPACITY - 1)];
+  cell.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  cell.event = event;
+  cell.sequence.store(index + 1, std::memory_order_release);
+}
+
+bool TraceRing::read(Ring &ring, uint32_t index, struct_trace_event &event)
+{
+  Cell &cell = ring.cells[index & (CAPACITY - 1)];
+  uint32_t before = cell.sequence.load(std::memory_order_acquire);
+  event = cell.event;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint32_t after = cell.sequence.load(std::memory_order_relaxed);
+  return before == index + 1 && after == index + 1;
+}
+
+void TraceRing::startDump()
+{
+  if (dumping)
+  {
+    return;
+  }
+  recording.store(false, std::memory_order_relaxed);
+  dumping = true;
+  dumpCount = 0;
+  taskCount = 0;
+  lastDrain = traceMicros() / 1000;
+  budget = 0;
+  startCore(0);
+}
+
+void TraceRing::startCore(uint8_t core)
+{
+  dumpCore = core;
+  if (core >= CORES)
+  {
+    return;
+  }
+  Ring &ring = rings[core];
+  dumpEnd = ring.head.load(std::memory_order_acquire);
+  dumpIndex = dumpEnd - ring.dumped > CAPACITY ? dumpEnd - CAPACITY : ring.dumped;
+}
+
+bool TraceRing::drain(BinaryLog &log)
+{
+  if (!dumping)
+  {
+    return false;
+  }
+
+  uint32_t now = traceMicros() / 1000;
+  budget += (now - lastDrain) * DRAIN_PER_MS;
+  budget = budget < 16 ? budget : 16;
+  lastDrain = now;
+
+  while (dumpCore < CORES)
+  {
+    Ring &ring = rings[dumpCore];
+    if (dumpIndex == dumpEnd)
+    {
+      ring.dumped = dumpEnd;
+      startCore(dumpCore + 1);
+      continue;
+    }
+    if (!budget)
+    {
+      return true;
+    }
+
+    struct_trace_event event;
+    if (!read(ring, dumpIndex, event))
+    {
+      dumpIndex++; // overwritten, or still being written when recording stopped
+      continue;
+    }
+    if (event.phase != TRACE_PHASE_CLOCK && !logTask(log, event.task))
+    {
+      return true;
+    }
+    if (!log.log(LOG_TRACE_EVENT, event.id, event.cycles, event.task,
+                 event.phase | event.core << 8))
+    {
+      return true; // the log ring is full, again next time
+    }
+    budget--;
+    dumpIndex++;
+    dumpCount++;
+  }
+
+  if (!log.log(LOG_TRACE_DONE, 0, dumpCount))
+  {
+    return true;
+  }
+  dumping = false;
+  recording.store(true, std::memory_order_relaxed);
+  return false;
+}
+
+bool TraceRing::logTask(BinaryLog &log, uint32_t task)
+{
+  for (uint8_t i = 0; i < taskCount; i++)
+  {
+    if (tasks[i] == task)
+    {
+      return true;
+    }
+  }
+  if (taskCount == MAX_TASKS)
+  {
+    return true; // left unnamed
+  }
+
+  int32_t name[3] = {0, 0, 0};
+#ifdef ARDUINO
+  if (task)
+  {
+    strncpy((char *)name, pcTaskGetTaskName((TaskHandle_t)task), sizeof(name));
+  }
+#endif
+  if (!log.log(LOG_TRACE_TASK, 0, task, name[0], name[1], name[2]))
+  {
+    return false;
+  }
+  tasks[taskCount++] = task;
+  return true;
+}
@@ -0,0 +1,127 @@
+#ifndef TRACE_RING_H
+#define TRACE_RING_H
+
+#include <atomic>
+#include <stdint.h>
+
+#include <binaryLog.h>
+#include <loopProfiler.h>
+#include <traceEvents.h>
+
+// Begin, end and mark events with the cycle count, core and task they
+// happened on, in a ring per core, so what overlapped what can be seen
+// afterwards: an I2C read stalling while a radio callback runs on the other
+// core, say.
+//
+// Build with -D TRACE_EVENTS to turn it on, without it the macros are empty
+// (or only the statement) and there is no ring.
+//
+//   TRACE(TRACE_PID_R, pidComputed = rPID.Compute());
+//   TRACE_SCOPE(TRACE_RADIO_RECEIVE); // to the end of the block
+//   TRACE_MARK(TRACE_RADIO_LOST);
+//
+// startDump() freezes the rings and drain() then writes them out through the
+// binary log, for host/traceExport to turn into Chrome trace JSON.
+
+#ifdef TRACE_EVENTS
+#define TRACE(id, statement)                                                                       \
+  do                                                                                               \
+  {                                                                                                \
+    traceRing.record(id, TRACE_PHASE_BEGIN);                                                       \
+    statement;                                                                                     \
+    traceRing.record(id, TRACE_PHASE_END);                                                         \
+  } while (0)
+#define TRACE_SCOPE_NAME(line) traceScope##line
+#define TRACE_SCOPE_LINE(id, line) TraceScope TRACE_SCOPE_NAME(line)(id)
+#define TRACE_SCOPE(id) TRACE_SCOPE_LINE(id, __LINE__)
+#define TRACE_MARK(id) traceRing.record(id, TRACE_PHASE_MARK)
+#else
+#define TRACE(id, statement) statement
+#define TRACE_SCOPE(id)
+#define TRACE_MARK(id)
+#endif
+
+typedef struct struct_trace_event
+{
+  uint32_t cycles;
+  uint32_t task; // handle, or micros for a clock event
+  uint16_t id;   // TraceId
+  uint8_t phase; // TracePhase
+  uint8_t core;
+} struct_trace_event;
+
+class TraceRing
+{
+public:
+  static const uint16_t CAPACITY = 512; // events per core, power of two
+  static const uint8_t CORES = 2;
+  static const uint8_t MAX_TASKS = 16;        // named in a dump
+  static const uint32_t CLOCK_CYCLES = 1 << 28; // between clock events, about a second
+  static const uint8_t DRAIN_PER_MS = 2;      // leaves the serial line room for the rest
+
+  TraceRing();
+
+  // wait-free, from any task on either core; nothing while dumping
+  void record(uint16_t id, uint8_t phase);
+
+  // stops recording until the events since the last dump are out
+  void startDump();
+  // every loop, logs a few events at a time; true while dumping
+  bool drain(BinaryLog &log);
+
+private:
+  struct Cell
+  {
+    std::atomic<uint32_t> sequence; // index + 1 once written
+    struct_trace_event event;
+  };
+
+  struct Ring
+  {
+    Cell cells[CAPACITY];
+    std::atomic<uint32_t> head;
+    uint32_t lastClock;      // cycles
+    uint32_t lastClockIndex; // so there is always one in the ring
+    uint32_t dumped;         // up to this index
+  };
+
+  Ring rings[CORES];
+  std::atomic<bool> recording;
+
+  bool dumping;
+  uint8_t dumpCore;
+  uint32_t dumpIndex;
+  uint32_t dumpEnd;
+  uint32_t dumpCount;
+  uint32_t lastDrain; // ms
+  uint32_t budget;
+  uint32_t tasks[MAX_TASKS];
+  uint8_t taskCount;
+
+  void push(Ring &ring, const struct_trace_event &event);
+  bool read(Ring &ring, uint32_t index, struct_trace_event &event);
+  void startCore(uint8_t core);
+  bool logTask(BinaryLog &log, uint32_t task);
+};
+
+#ifdef TRACE_EVENTS
+extern TraceRing traceRing;
+
+class TraceScope
+{
+public:
+  TraceScope(uint16_t id) : id(id)
+  {
+    traceRing.record(id, TRACE_PHASE_BEGIN);
+  }
+  ~TraceScope()
+  {
+    traceRing.record(id, TRACE_PHASE_END);
+  }
+
+private:
+  uint16_t id;
+};
+#endif
+
+#endif
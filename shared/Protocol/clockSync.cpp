@@ -0,0 +1,39 @@
+#include <clockSync.h>
+
+void ClockSync::add(uint32_t remoteMillis, uint32_t localMillis)
+{
+  samples[next] = (int32_t)(remoteMillis - localMillis);
+  next = (next + 1) % WINDOW;
+  if (count < WINDOW)
+  {
+    count++;
+  }
+
+  // both clocks wrap, so compare the differences relative to the newest one
+  int32_t newest = samples[(next + WINDOW - 1) % WINDOW];
+  int32_t best = 0;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    int32_t d = (int32_t)((uint32_t)samples[i] - (uint32_t)newest);
+    if (d > best)
+    {
+      best = d;
+    }
+  }
+  offset = (int32_t)((uint32_t)newest + (uint32_t)best);
+}
+
+bool ClockSync::isSynced()
+{
+  return count > 0;
+}
+
+uint32_t ClockSync::toLocal(uint32_t remoteMillis)
+{
+  return remoteMillis - offset;
+}
+
+uint32_t ClockSync::toRemote(uint32_t localMillis)
+{
+  return localMillis + offset;
+}
@@ -0,0 +1,28 @@
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <stdint.h>
+
+// Estimates the offset between the remote's millis() and ours from the
+// timestamps in received messages. A message can only arrive late, never
+// early, so the largest remote - local difference over a recent window is
+// the one with the least radio delay in it, and the best estimate.
+class ClockSync
+{
+public:
+  static const uint8_t WINDOW = 32; // messages
+
+  void add(uint32_t remoteMillis, uint32_t localMillis);
+  bool isSynced();
+
+  uint32_t toLocal(uint32_t remoteMillis);
+  uint32_t toRemote(uint32_t localMillis);
+
+private:
+  int32_t samples[WINDOW];
+  uint8_t count = 0;
+  uint8_t next = 0;
+  int32_t offset = 0;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+// Packets exchanged between the leg and the remote. Both firmwares and the
+// host tools include this, so the layouts can not drift apart.
+
+// Cycle counts of one profiled zone of a loop (see shared/Profiler)
+const uint8_t PROFILE_NONE = 0xFF; // built without LOOP_PROFILER
+
+typedef struct struct_profile_stats
+{
+  uint8_t zone;
+  uint32_t count;
+  uint32_t min;
+  uint32_t mean;
+  uint32_t max;
+  uint32_t p99;
+} struct_profile_stats;
+
+// leg -> remote, sent every 5 ms, optionally followed by a telemetry frame
+typedef struct struct_leg_data
+{
+  float rP;
+  float rI;
+  float rD;
+
+  float rInput;
+  float lInput;
+
+  uint32_t timelineCrc;     // of the uploaded library, 0 = none
+  uint16_t uploadNextChunk; // first chunk still missing, UPLOAD_DONE if none
+  int16_t playingTimeline;  // -1 = following the remote's targets
+  uint8_t loadLevel;        // of the leg's LoadGovernor, 0 = nothing shed
+
+  struct_profile_stats profile; // the leg's zones, one per packet in turn
+
+} struct_leg_data;
+
+// Every remote -> leg message starts with a header, so the leg can tell them
+// apart and keep its clock in step with the remote's.
+enum MessageType : uint8_t
+{
+  MSG_CONTROL = 1,
+  MSG_UPLOAD_BEGIN,
+  MSG_UPLOAD_CHUNK,
+  MSG_PLAYBACK,
+};
+
+typedef struct struct_remote_header
+{
+  uint8_t type;
+  uint32_t millis; // remote's clock when sent
+} struct_remote_header;
+
+// remote -> leg, sent every 2 ms unless the leg is playing on its own
+typedef struct struct_remote_data
+{
+  struct_remote_header header;
+
+  int16_t joystickLX;
+  int16_t joystickLY;
+  int16_t joystickRX;
+  int16_t joystickRY;
+
+  int16_t sliderLL;
+  int16_t sliderLA;
+  int16_t sliderRL;
+  int16_t sliderRA;
+
+  int16_t encoderPos;
+  bool encoderSwDown;
+
+  char key;
+
+  int8_t batteryPercent;
+
+  float rP;
+  float rI;
+  float rD;
+
+  float lP;
+  float lI;
+  float lD;
+
+  uint16_t rTargetPositionDegrees;
+  uint16_t lTargetPositionDegrees;
+
+} struct_remote_data;
+
+// A timeline library image (see timelineLibrary.h) goes over in chunks. The
+// leg reports the first chunk it is missing, and the crc of the image once it
+// has all of them and the image checks out.
+
+const uint32_t UPLOAD_MAX_SIZE = 16384; // the leg's image buffer
+const uint8_t UPLOAD_CHUNK_SIZE = 232; // a chunk message stays within one ESP-NOW frame
+const uint16_t UPLOAD_DONE = 0xFFFF;
+
+typedef struct struct_upload_begin
+{
+  struct_remote_header header;
+  uint32_t size;
+  uint32_t crc;
+} struct_upload_begin;
+
+typedef struct struct_upload_chunk
+{
+  struct_remote_header header;
+  uint16_t index;
+  uint8_t len;
+  uint8_t data[UPLOAD_CHUNK_SIZE];
+} struct_upload_chunk;
+
+// Starts or stops playback of an uploaded timeline on the leg. The same
+// command is repeated as a heartbeat, sequence tells a new one apart.
+enum PlaybackCommand : uint8_t
+{
+  PLAYBACK_STOP,
+  PLAYBACK_START, // timeline from position, at startAt
+};
+
+typedef struct struct_playback
+{
+  struct_remote_header header;
+  uint8_t command;
+  uint8_t sequence;
+  int16_t timeline;
+  uint32_t startAt;  // remote's clock
+  uint32_t position; // ms into the timeline at startAt
+  // show time the timelines play on, clockShow + (t - clockAt) * rate from
+  // clockAt on, all on the remote's clock. Follows the music's tempo.
+  uint32_t clockAt;
+  uint32_t clockShow;
+  float rate;
+} struct_playback;
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SHOW_LOAD_H
+#define SHOW_LOAD_H
+
+#include <stdint.h>
+
+// Loading a timeline library image (see timelineLibrary.h) into the remote's
+// show partition over USB serial, with host/showLoad.
+//
+// The host sends SHOW_LOAD_COMMAND, the image header, then the rest of the
+// image in blocks of SHOW_LOAD_BLOCK bytes. The remote answers every step
+// with a LOG_REMOTE_SHOW_LOAD record in its binary log, and the host waits
+// for it before sending the next block, so the serial buffer never overflows.
+
+const char SHOW_LOAD_COMMAND = 'u';
+const uint16_t SHOW_LOAD_BLOCK = 256;
+
+enum ShowLoadStatus : uint16_t
+{
+  SHOW_LOAD_READY,  // v0 = bytes received so far, send the next block
+  SHOW_LOAD_DONE,   // image written and checked, v0 = its size
+  SHOW_LOAD_FAILED, // v0 = bytes received, the partition holds no show now
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include <timelineReceiver.h>
+
+#include <string.h>
+
+TimelineReceiver::TimelineReceiver(float targetScale) : player(library, targetScale)
+{
+}
+
+void TimelineReceiver::receive(const uint8_t *data, size_t len, ClockSync &clock)
+{
+  if (!len)
+  {
+    return;
+  }
+  uint8_t type = data[0];
+  if (type == MSG_UPLOAD_BEGIN && len >= sizeof(struct_upload_begin))
+  {
+    struct_upload_begin begin;
+    memcpy(&begin, data, sizeof(begin));
+    beginUpload(begin);
+  }
+  if (type == MSG_UPLOAD_CHUNK && len >= offsetof(struct_upload_chunk, data))
+  {
+    struct_upload_chunk chunk;
+    memcpy(&chunk, data, len < sizeof(chunk) ? len : sizeof(chunk));
+    if (offsetof(struct_upload_chunk, data) + chunk.len <= len)
+    {
+      storeChunk(chunk);
+    }
+  }
+  if (type == MSG_PLAYBACK && len >= sizeof(struct_playback))
+  {
+    struct_playback playback;
+    memcpy(&playback, data, sizeof(playback));
+    handlePlayback(playback, clock);
+  }
+}
+
+void TimelineReceiver::beginUpload(const struct_upload_begin &begin)
+{
+  if (begin.crc == crc || (begin.crc == imageCrc && nextChunk != UPLOAD_DONE))
+  {
+    return; // already have it, or already receiving it
+  }
+
+  // the image is about to be overwritten
+  player.stop();
+  playing = false;
+  pending = false;
+  library.clear();
+  crc = 0;
+
+  if (begin.size > CAPACITY)
+  {
+    nextChunk = UPLOAD_DONE;
+    return;
+  }
+  imageSize = begin.size;
+  imageCrc = begin.crc;
+  memset(received, 0, sizeof(received));
+  nextChunk = 0;
+}
+
+void TimelineReceiver::storeChunk(const struct_upload_chunk &chunk)
+{
+  if (nextChunk == UPLOAD_DONE)
+  {
+    return;
+  }
+  uint32_t offset = (uint32_t)chunk.index * UPLOAD_CHUNK_SIZE;
+  if (offset + chunk.len > imageSize || chunk.len > UPLOAD_CHUNK_SIZE)
+  {
+    return;
+  }
+  memcpy(image + offset, chunk.data, chunk.len);
+  received[chunk.index / 32] |= 1UL << (chunk.index % 32);
+
+  uint16_t chunks = (imageSize + UPLOAD_CHUNK_SIZE - 1) / UPLOAD_CHUNK_SIZE;
+  while (nextChunk < chunks && received[nextChunk / 32] & (1UL << (nextChunk % 32)))
+  {
+    nextChunk++;
+  }
+  if (nextChunk < chunks)
+  {
+    return;
+  }
+
+  nextChunk = UPLOAD_DONE;
+  struct_timeline_image_header header;
+  if (readTimelineImageHeader(image, imageSize, header) && header.crc == imageCrc &&
+      library.load(image, imageSize))
+  {
+    crc = imageCrc;
+  }
+}
+
+void TimelineReceiver::handlePlayback(const struct_playback &playback, ClockSync &clock)
+{
+  if (playback.command != PLAYBACK_STOP)
+  {
+    // the same offset applies to show time as to the remote's millis()
+    musicClock.set(clock.toLocal(playback.clockAt), clock.toLocal(playback.clockShow),
+                   playback.rate);
+  }
+  if (playback.sequence == lastSequence && (playing || pending))
+  {
+    return; // heartbeat of the command already applied
+  }
+  lastSequence = playback.sequence;
+
+  if (playback.command == PLAYBACK_STOP)
+  {
+    player.stop();
+    playing = false;
+    pending = false;
+    return;
+  }
+  if (!crc || playback.timeline < 0 || playback.timeline >= library.getSize())
+  {
+    return;
+  }
+  command = playback;
+  startAt = clock.toLocal(playback.startAt);
+  pending = true;
+}
+
+bool TimelineReceiver::update(uint32_t now, const struct_timeline_state &current,
+                              struct_timeline_state &state)
+{
+  if (pending && (int32_t)(now - startAt) >= 0)
+  {
+    uint32_t show = musicClock.toShow(now);
+    uint32_t showStart = musicClock.toShow(startAt);
+    if (!command.position)
+    {
+      player.start(command.timeline, showStart, current);
+    }
+    else
+    {
+      // ramps from the current targets, so jumping into the middle of a
+      // move does not jerk the legs
+      player.seek(command.timeline, show - showStart + command.position, show, current);
+    }
+    playing = true;
+    pending = false;
+  }
+
+  if (!playing)
+  {
+    if (pending)
+    {
+      state = current; // hold until the agreed start time
+      return true;
+    }
+    return false;
+  }
+  if (!player.update(musicClock.toShow(now), state))
+  {
+    state = current; // hold until the first keyframe
+  }
+  return true;
+}
+
+uint32_t TimelineReceiver::getCrc()
+{
+  return crc;
+}
+
+uint16_t TimelineReceiver::getNextChunk()
+{
+  return nextChunk;
+}
+
+int16_t TimelineReceiver::getPlaying()
+{
+  return playing ? player.getCurrent() : -1;
+}
@@ -0,0 +1,57 @@
+#ifndef TIMELINE_RECEIVER_H
+#define TIMELINE_RECEIVER_H
+
+#include <clockSync.h>
+#include <musicClock.h>
+#include <protocol.h>
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The leg's end of TimelineUpload and of the playback commands: puts the
+// uploaded image together, checks it, and plays its timelines from the start
+// time agreed on the remote's clock. Knows nothing of the radio or of tasks,
+// LegPlayback wraps it on the leg and host/legNode drives it over UDP.
+class TimelineReceiver
+{
+public:
+  static const size_t CAPACITY = UPLOAD_MAX_SIZE;
+  static const uint16_t CHUNKS = (CAPACITY + UPLOAD_CHUNK_SIZE - 1) / UPLOAD_CHUNK_SIZE;
+
+  // targetScale as TimelinePlayer's
+  TimelineReceiver(float targetScale = 1);
+
+  // an upload or playback message, with the remote's clock as it stands
+  void receive(const uint8_t *data, size_t len, ClockSync &clock);
+  // writes the state at now, returns false if the remote's targets apply
+  bool update(uint32_t now, const struct_timeline_state &current, struct_timeline_state &state);
+
+  uint32_t getCrc();
+  uint16_t getNextChunk();
+  int16_t getPlaying();
+
+private:
+  alignas(4) uint8_t image[CAPACITY];
+  uint32_t received[(CHUNKS + 31) / 32];
+  uint32_t imageSize = 0;
+  uint32_t imageCrc = 0;
+  uint32_t crc = 0;
+  uint16_t nextChunk = UPLOAD_DONE;
+
+  TimelineLibrary library;
+  TimelinePlayer player;
+  MusicClock musicClock; // the remote's, for the tempo of music moves
+  bool playing = false;
+  bool pending = false; // a command waiting for its start time
+  struct_playback command;
+  uint32_t startAt; // local clock
+  uint8_t lastSequence = 0;
+
+  void beginUpload(const struct_upload_begin &begin);
+  void storeChunk(const struct_upload_chunk &chunk);
+  void handlePlayback(const struct_playback &playback, ClockSync &clock);
+};
+
+#endif
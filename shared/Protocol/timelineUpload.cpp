@@ -0,0 +1,79 @@
+#include <timelineUpload.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+TimelineUpload::TimelineUpload(TimelineLibrary &library)
+    : library(library), image(nullptr), size(0), crc(0), cursor(0)
+{
+}
+
+void TimelineUpload::init()
+{
+  // again whenever the library changes, into the same buffer: a show load
+  // happens while running, which must not allocate
+  crc = 0;
+  cursor = 0;
+  if (!image)
+  {
+    image = (uint8_t *)malloc(UPLOAD_MAX_SIZE);
+  }
+  size = image ? library.encode(image, UPLOAD_MAX_SIZE) : 0;
+
+  // a size of 0 disables the upload, the caller logs it
+  struct_timeline_image_header header;
+  if (!size || !readTimelineImageHeader(image, size, header))
+  {
+    size = 0;
+    return;
+  }
+  crc = header.crc;
+}
+
+uint32_t TimelineUpload::getCrc()
+{
+  return crc;
+}
+
+size_t TimelineUpload::getSize()
+{
+  return size;
+}
+
+bool TimelineUpload::isDone(const struct_leg_data &leg)
+{
+  return !size || leg.timelineCrc == crc;
+}
+
+uint16_t TimelineUpload::getChunks()
+{
+  return (size + UPLOAD_CHUNK_SIZE - 1) / UPLOAD_CHUNK_SIZE;
+}
+
+size_t TimelineUpload::prepare(const struct_leg_data &leg, uint32_t now, uint8_t *out)
+{
+  // the leg is not receiving this image (yet), (re)start
+  if (leg.uploadNextChunk == UPLOAD_DONE || leg.uploadNextChunk >= getChunks())
+  {
+    struct_upload_begin begin = {{MSG_UPLOAD_BEGIN, now}, (uint32_t)size, crc};
+    memcpy(out, &begin, sizeof(begin));
+    cursor = 0;
+    return sizeof(begin);
+  }
+
+  // after one pass, go back for what got lost
+  if (cursor >= getChunks() || cursor < leg.uploadNextChunk)
+  {
+    cursor = leg.uploadNextChunk;
+  }
+
+  struct_upload_chunk chunk;
+  chunk.header = {MSG_UPLOAD_CHUNK, now};
+  chunk.index = cursor;
+  size_t left = size - (size_t)cursor * UPLOAD_CHUNK_SIZE;
+  chunk.len = left < UPLOAD_CHUNK_SIZE ? left : UPLOAD_CHUNK_SIZE;
+  memcpy(chunk.data, image + (size_t)cursor * UPLOAD_CHUNK_SIZE, chunk.len);
+  memcpy(out, &chunk, sizeof(chunk));
+  cursor++;
+  return offsetof(struct_upload_chunk, data) + chunk.len;
+}
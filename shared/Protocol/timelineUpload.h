@@ -0,0 +1,37 @@
+#ifndef TIMELINE_UPLOAD_H
+#define TIMELINE_UPLOAD_H
+
+#include <protocol.h>
+#include <timelineLibrary.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Sends the built-in timelines to the leg as an image, so it can play them on
+// its own. Chunks go out in order, then whatever the leg still reports
+// missing, until the leg reports the crc of the image back. The leg's end is
+// TimelineReceiver.
+class TimelineUpload
+{
+public:
+  TimelineUpload(TimelineLibrary &library);
+  void init();
+
+  uint32_t getCrc();
+  // bytes of the image, 0 if the library does not fit
+  size_t getSize();
+  bool isDone(const struct_leg_data &leg);
+  // writes the next upload message, returns its size
+  size_t prepare(const struct_leg_data &leg, uint32_t now, uint8_t *out);
+
+private:
+  TimelineLibrary &library;
+  uint8_t *image;
+  size_t size;
+  uint32_t crc;
+  uint16_t cursor;
+
+  uint16_t getChunks();
+};
+
+#endif
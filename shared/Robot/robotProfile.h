@@ -0,0 +1,66 @@
+#ifndef ROBOT_PROFILE_H
+#define ROBOT_PROFILE_H
+
+#include <stdint.h>
+
+// A robot's wiring and calibration, as constants of a type: the motor
+// driver's PWM, a Joint per leg and the other pins. Encoder, the PWM sinks
+// and MotorController are templates on it, so every constant folds into the
+// code that uses it. Another robot is another profile like Acrobot, and the
+// Robot typedef at the bottom picks the one the leg is built for, and the
+// host tools model.
+
+struct AcrobotPwm
+{
+  // can be experimented with, see the supported frequencies and resolutions in
+  // https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-reference/peripherals/ledc.html
+  static constexpr uint32_t FREQUENCY = 24000; // Hz
+  static constexpr uint8_t RESOLUTION = 8;     // bits, will receive error on serial if set too high
+  static constexpr uint16_t RANGE = (1 << RESOLUTION) - 1;
+};
+
+struct AcrobotRightLeg
+{
+  static constexpr uint8_t FORWARD_PIN = 16;
+  static constexpr uint8_t BACKWARD_PIN = 17;
+  static constexpr uint8_t FORWARD_CHANNEL = 0; // LEDC
+  static constexpr uint8_t BACKWARD_CHANNEL = 1;
+  static constexpr uint8_t MCPWM_TIMER = 0;     // of unit 0, with -D MCPWM_DRIVE
+  static constexpr uint8_t DEADBAND = 44;   // PWM, less does not move the leg
+  static constexpr uint16_t NEUTRAL = 3107; // 4096 - position at very top, raw
+  static constexpr bool MIRRORED = false;   // the encoder counts the other way
+  static constexpr uint8_t MUX_PORT = 0;    // of the encoder
+};
+
+struct AcrobotLeftLeg
+{
+  static constexpr uint8_t FORWARD_PIN = 19;
+  static constexpr uint8_t BACKWARD_PIN = 18;
+  static constexpr uint8_t FORWARD_CHANNEL = 2;
+  static constexpr uint8_t BACKWARD_CHANNEL = 3;
+  static constexpr uint8_t MCPWM_TIMER = 1;
+  static constexpr uint8_t DEADBAND = 46;
+  static constexpr uint16_t NEUTRAL = 4004;
+  static constexpr bool MIRRORED = true;
+  static constexpr uint8_t MUX_PORT = 1;
+  static constexpr uint8_t ENCODER_PWM_PIN = 15; // the AS5600's PWM output
+};
+
+struct Acrobot
+{
+  typedef AcrobotPwm Pwm;
+  typedef AcrobotRightLeg RightLeg;
+  typedef AcrobotLeftLeg LeftLeg;
+
+  static constexpr uint8_t BATTERY_V_PIN = 32;
+  static constexpr uint8_t BUZZER_PIN = 26;
+  static constexpr uint8_t IR_PIN = 27;
+  static constexpr uint8_t LED_R_PIN = 14;
+  static constexpr uint8_t LED_G_PIN = 12;
+  static constexpr uint8_t LED_B_PIN = 13;
+  static constexpr uint8_t BOOT_SW_PIN = 23;
+};
+
+typedef Acrobot Robot;
+
+#endif
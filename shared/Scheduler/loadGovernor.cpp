@@ -0,0 +1,76 @@
+#include <loadGovernor.h>
+
+LoadGovernor::LoadGovernor(uint32_t period, uint8_t maxLevel)
+    : period(period), maxLevel(maxLevel), level(0), windowStart(0), lastTick(0),
+      windowMinSlack(INT32_MAX), windowLost(0), minSlack(0), lost(0), calmWindows(0), changed(0)
+{
+}
+
+bool LoadGovernor::update(uint64_t now, int32_t slack)
+{
+  if (!lastTick)
+  {
+    windowStart = lastTick = changed = now;
+  }
+
+  // the scheduler skips the ticks a job was too late for, they only show
+  // as a longer gap
+  uint64_t gap = now - lastTick;
+  if (gap > period + period / 2)
+  {
+    windowLost += (gap + period / 2) / period - 1;
+  }
+  lastTick = now;
+  windowMinSlack = slack < windowMinSlack ? slack : windowMinSlack;
+
+  if (slack < 0 && now - changed >= (uint64_t)SETTLE * period && change(now, 1))
+  {
+    return true;
+  }
+
+  if (now - windowStart < (uint64_t)WINDOW * period)
+  {
+    return false;
+  }
+  minSlack = windowMinSlack;
+  lost = windowLost;
+  windowStart = now;
+  windowMinSlack = INT32_MAX;
+  windowLost = 0;
+
+  bool calm = !lost && minSlack > (int32_t)(period * RESTORE_PERCENT / 100);
+  calmWindows = calm ? calmWindows + 1 : 0;
+  if (calmWindows >= RESTORE_WINDOWS)
+  {
+    calmWindows = 0;
+    return change(now, -1);
+  }
+  bool tight = lost || minSlack < (int32_t)(period * SHED_PERCENT / 100);
+  return tight && now - changed >= (uint64_t)SETTLE * period && change(now, 1);
+}
+
+bool LoadGovernor::change(uint64_t now, int8_t step)
+{
+  if ((step > 0 && level == maxLevel) || (step < 0 && level == 0))
+  {
+    return false;
+  }
+  level += step;
+  changed = now;
+  return true;
+}
+
+uint8_t LoadGovernor::getLevel()
+{
+  return level;
+}
+
+int32_t LoadGovernor::getMinSlack()
+{
+  return minSlack;
+}
+
+uint16_t LoadGovernor::getLostTicks()
+{
+  return lost;
+}
@@ -0,0 +1,51 @@
+#ifndef LOAD_GOVERNOR_H
+#define LOAD_GOVERNOR_H
+
+#include <stdint.h>
+
+// Keeps a periodic control job on time by shedding the work that can wait.
+//
+// After every tick it is given the job's slack (Scheduler::getSlack()). A
+// window of ticks that was short of slack, or that lost ticks to something
+// else running long, raises the level by one. A tick that is already late
+// raises it at once, unless the level just changed. Once RESTORE_WINDOWS
+// windows in a row had room to spare the level comes down by one. What each
+// level sheds is up to the caller.
+
+class LoadGovernor
+{
+public:
+  static const uint16_t WINDOW = 100;         // periods per decision
+  static const uint8_t SHED_PERCENT = 20;     // of the period, less slack than this sheds
+  static const uint8_t RESTORE_PERCENT = 50;  // more than this, every tick, restores
+  static const uint8_t RESTORE_WINDOWS = 20;  // in a row
+  static const uint16_t SETTLE = 20;          // periods after a change before a late tick sheds again
+
+  LoadGovernor(uint32_t period, uint8_t maxLevel);
+
+  // now in us; returns true when the level changed
+  bool update(uint64_t now, int32_t slack);
+
+  uint8_t getLevel();
+  // of the last whole window
+  int32_t getMinSlack();
+  uint16_t getLostTicks();
+
+private:
+  uint32_t period;
+  uint8_t maxLevel;
+  uint8_t level;
+
+  uint64_t windowStart;
+  uint64_t lastTick;
+  int32_t windowMinSlack;
+  uint16_t windowLost;
+  int32_t minSlack;
+  uint16_t lost;
+  uint8_t calmWindows;
+  uint64_t changed;
+
+  bool change(uint64_t now, int8_t step);
+};
+
+#endif
@@ -0,0 +1,251 @@
+#include <scheduler.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#include <thread>
+#endif
+
+uint64_t schedulerMicros()
+{
+#ifdef ARDUINO
+  return esp_timer_get_time();
+#else
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static void keepMax(uint32_t &max, uint64_t value)
+{
+  uint32_t clamped = value < UINT32_MAX ? value : UINT32_MAX;
+  max = clamped > max ? clamped : max;
+}
+
+Scheduler::Scheduler() : jobs(0), report(nullptr)
+{
+#ifdef ARDUINO
+  task = nullptr;
+  timer = nullptr;
+#endif
+}
+
+uint8_t Scheduler::add(const struct_job &job)
+{
+  if (jobs == MAX_JOBS)
+  {
+    return NO_JOB;
+  }
+  Entry &entry = entries[jobs];
+  memset(&entry, 0, sizeof(entry));
+  entry.job = job;
+
+  uint64_t now = schedulerMicros();
+  entry.recentStart = now;
+  if (job.period)
+  {
+    // on the period's grid, so a 1 ms job runs once in every millis()
+    entry.due = (now / job.period + 1) * job.period;
+    entry.armed = true;
+  }
+  return jobs++;
+}
+
+void Scheduler::start(uint8_t job, uint32_t delay)
+{
+  if (job < jobs)
+  {
+    entries[job].due = schedulerMicros() + delay;
+    entries[job].armed = true;
+  }
+}
+
+void Scheduler::stop(uint8_t job)
+{
+  if (job < jobs)
+  {
+    entries[job].armed = false;
+  }
+}
+
+bool Scheduler::isPending(uint8_t job)
+{
+  return job < jobs && entries[job].armed;
+}
+
+void Scheduler::setPeriod(uint8_t job, uint32_t period)
+{
+  if (job < jobs && period)
+  {
+    entries[job].job.period = period;
+  }
+}
+
+int32_t Scheduler::getSlack(uint8_t job)
+{
+  if (job >= jobs)
+  {
+    return 0;
+  }
+  const Entry &entry = entries[job];
+  int64_t slack = (int64_t)(entry.released + entry.job.period - schedulerMicros());
+  return slack < INT32_MIN ? INT32_MIN : slack > INT32_MAX ? INT32_MAX : slack;
+}
+
+uint32_t Scheduler::deadlineOf(const Entry &entry)
+{
+  if (entry.job.deadline)
+  {
+    return entry.job.deadline;
+  }
+  return entry.job.period ? entry.job.period : UINT32_MAX;
+}
+
+void Scheduler::onReport(JobReportFunction report)
+{
+  this->report = report;
+}
+
+uint8_t Scheduler::pick(uint64_t now)
+{
+  uint8_t best = NO_JOB;
+  uint64_t bestDeadline = 0;
+  for (uint8_t i = 0; i < jobs; i++)
+  {
+    const Entry &entry = entries[i];
+    if (!entry.armed || entry.due > now)
+    {
+      continue;
+    }
+    uint64_t deadline = entry.due + deadlineOf(entry);
+    if (best == NO_JOB || entry.job.priority > entries[best].job.priority ||
+        (entry.job.priority == entries[best].job.priority && deadline < bestDeadline))
+    {
+      best = i;
+      bestDeadline = deadline;
+    }
+  }
+  return best;
+}
+
+void Scheduler::run()
+{
+  uint64_t now = schedulerMicros();
+  uint8_t job;
+  while ((job = pick(now)) != NO_JOB)
+  {
+    Entry &entry = entries[job];
+    uint64_t late = now - entry.due;
+    uint32_t period = entry.job.period;
+    entry.released = entry.due;
+    if (period)
+    {
+      entry.due += period;
+      if (entry.due <= now)
+      {
+        entry.due += ((now - entry.due) / period + 1) * period; // skipped
+      }
+    }
+    else
+    {
+      entry.armed = false; // before it runs, so it can start itself again
+    }
+
+    entry.job.function(entry.job.context);
+    uint64_t end = schedulerMicros();
+    account(job, late, end - now, end);
+    now = end;
+  }
+  sleep(now);
+}
+
+void Scheduler::account(uint8_t job, uint64_t late, uint64_t ran, uint64_t now)
+{
+  Entry &entry = entries[job];
+  bool missed = late > deadlineOf(entry);
+  bool overran = entry.job.budget && ran > entry.job.budget;
+
+  struct_job_stats *stats[2] = {&entry.total, &entry.recent};
+  for (struct_job_stats *s : stats)
+  {
+    s->runs++;
+    s->misses += missed;
+    s->overruns += overran;
+    keepMax(s->maxRun, ran);
+    keepMax(s->maxLate, late);
+  }
+
+  if (now - entry.recentStart < REPORT_INTERVAL)
+  {
+    return;
+  }
+  if ((entry.recent.misses || entry.recent.overruns) && report)
+  {
+    report(job, entry.recent);
+  }
+  memset(&entry.recent, 0, sizeof(entry.recent));
+  entry.recentStart = now;
+}
+
+void Scheduler::sleep(uint64_t now)
+{
+  uint64_t next = now + MAX_SLEEP;
+  for (uint8_t i = 0; i < jobs; i++)
+  {
+    if (entries[i].armed && entries[i].due < next)
+    {
+      next = entries[i].due;
+    }
+  }
+  if (next < now + MIN_SLEEP)
+  {
+    return;
+  }
+  uint32_t wait = next - now;
+
+#ifdef ARDUINO
+  // a one-shot esp_timer wakes this task, finer than the 1 ms tick, and the
+  // core is free for the idle task and WiFi meanwhile
+  if (!timer)
+  {
+    task = xTaskGetCurrentTaskHandle();
+    esp_timer_create_args_t args = {};
+    args.callback = wake;
+    args.arg = this;
+    args.name = "scheduler";
+    esp_timer_create(&args, &timer);
+  }
+  esp_timer_stop(timer);
+  esp_timer_start_once(timer, wait);
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait / 1000 + 2));
+#else
+  std::this_thread::sleep_for(std::chrono::microseconds(wait));
+#endif
+}
+
+#ifdef ARDUINO
+void Scheduler::wake(void *self)
+{
+  xTaskNotifyGive(((Scheduler *)self)->task);
+}
+#endif
+
+bool Scheduler::get(uint8_t job, struct_job_stats &stats)
+{
+  if (job >= jobs)
+  {
+    return false;
+  }
+  stats = entries[job].total;
+  return true;
+}
+
+const char *Scheduler::getName(uint8_t job)
+{
+  return job < jobs ? entries[job].job.name : "";
+}
+
+uint8_t Scheduler::getJobs()
+{
+  return jobs;
+}
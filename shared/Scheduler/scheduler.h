@@ -0,0 +1,115 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_timer.h>
+#endif
+
+// Cooperative jobs for loop(), in place of xxxTimer < millis() checks.
+//
+// A job is periodic or one-shot and has a priority, a deadline and a run-time
+// budget. run() starts the jobs that are due one at a time, the highest
+// priority first and the one with the earliest deadline within a priority,
+// then sleeps until the next one is due instead of spinning.
+//
+// Time is 64-bit microseconds since boot, which does not wrap, so neither do
+// the schedules. A periodic job keeps to its period without drifting, and
+// skips the periods it was too late for rather than running them back to
+// back.
+//
+// A job that starts after its deadline is a miss, one that runs longer than
+// its budget an overrun. Both are counted, and reported to the onReport()
+// function at most once a REPORT_INTERVAL per job.
+
+typedef void (*JobFunction)(void *context);
+
+typedef struct struct_job
+{
+  const char *name;
+  JobFunction function;
+  void *context;
+  uint8_t priority;  // higher first
+  uint32_t period;   // us, 0 for a one-shot job, which runs once per start()
+  uint32_t deadline; // us after it is due that it has to start by, 0 = the period
+  uint32_t budget;   // us it may run for, 0 = no limit
+} struct_job;
+
+typedef struct struct_job_stats
+{
+  uint32_t runs;
+  uint32_t misses;
+  uint32_t overruns;
+  uint32_t maxRun;  // us
+  uint32_t maxLate; // us after it was due
+} struct_job_stats;
+
+// the stats of the last REPORT_INTERVAL of a job that missed or overran
+typedef void (*JobReportFunction)(uint8_t job, const struct_job_stats &stats);
+
+uint64_t schedulerMicros();
+
+class Scheduler
+{
+public:
+  static const uint8_t MAX_JOBS = 16;
+  static const uint8_t NO_JOB = 0xFF;
+  static const uint32_t REPORT_INTERVAL = 1000000; // us
+  static const uint32_t MIN_SLEEP = 100;           // us, shorter waits spin
+  static const uint32_t MAX_SLEEP = 100000;        // us, loop() still comes round
+
+  Scheduler();
+
+  // returns the job's number, NO_JOB if there are too many; a periodic job
+  // starts on the next multiple of its period, a one-shot job with start()
+  uint8_t add(const struct_job &job);
+  // (re)arms a job to be due delay us from now
+  void start(uint8_t job, uint32_t delay = 0);
+  void stop(uint8_t job);
+  bool isPending(uint8_t job);
+  // from the next time it runs, e.g. to shed load
+  void setPeriod(uint8_t job, uint32_t period);
+  // from inside a periodic job: us left until it is due again, negative
+  // when it already is
+  int32_t getSlack(uint8_t job);
+
+  // from loop(), returns after the jobs that were due and a sleep
+  void run();
+  void onReport(JobReportFunction report);
+
+  // since boot
+  bool get(uint8_t job, struct_job_stats &stats);
+  const char *getName(uint8_t job);
+  uint8_t getJobs();
+
+private:
+  struct Entry
+  {
+    struct_job job;
+    bool armed;
+    uint64_t due;
+    uint64_t released; // the due time it last ran for
+    struct_job_stats total;
+    struct_job_stats recent; // since the last report
+    uint64_t recentStart;
+  };
+
+  Entry entries[MAX_JOBS];
+  uint8_t jobs;
+  JobReportFunction report;
+
+  uint32_t deadlineOf(const Entry &entry);
+  uint8_t pick(uint64_t now);
+  void account(uint8_t job, uint64_t late, uint64_t ran, uint64_t now);
+  void sleep(uint64_t now);
+
+#ifdef ARDUINO
+  TaskHandle_t task;
+  esp_timer_handle_t timer;
+  static void wake(void *self);
+#endif
+};
+
+#endif
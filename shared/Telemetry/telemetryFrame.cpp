@@ -0,0 +1,153 @@
+#include <telemetryFrame.h>
+#include <string.h>
+
+static size_t putVarint(uint8_t *out, int32_t value)
+{
+  // zigzag, so small negative deltas stay small
+  uint32_t v = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+  size_t n = 0;
+  while (v >= 0x80)
+  {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+static bool getVarint(const uint8_t *data, size_t len, size_t &offset, int32_t &value)
+{
+  uint32_t v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7)
+  {
+    if (offset >= len)
+    {
+      return false;
+    }
+    uint8_t b = data[offset++];
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80))
+    {
+      value = (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TelemetryEncoder::begin(uint8_t *buffer, size_t capacity, uint16_t sequence)
+{
+  this->buffer = buffer;
+  this->capacity = capacity;
+  memset(&previous, 0, sizeof(previous));
+
+  struct_telemetry_header header = {TELEMETRY_TAG, 0, sequence};
+  memcpy(buffer, &header, sizeof(header));
+  size = sizeof(header);
+}
+
+bool TelemetryEncoder::add(const struct_telemetry_sample &sample)
+{
+  if (getCount() == 255)
+  {
+    return false;
+  }
+
+  uint8_t scratch[TELEMETRY_MAX_SAMPLE_SIZE];
+  size_t n = 0;
+  n += putVarint(scratch + n, (int32_t)(sample.micros - previous.micros));
+  n += putVarint(scratch + n, (int32_t)sample.loopMicros - previous.loopMicros);
+  for (uint8_t i = 0; i < TELEMETRY_JOINTS; i++)
+  {
+    const struct_telemetry_joint &j = sample.joints[i];
+    const struct_telemetry_joint &p = previous.joints[i];
+    n += putVarint(scratch + n, (int32_t)j.position - p.position);
+    n += putVarint(scratch + n, (int32_t)j.velocity - p.velocity);
+    n += putVarint(scratch + n, (int32_t)j.setpoint - p.setpoint);
+    n += putVarint(scratch + n, (int32_t)j.output - p.output);
+    n += putVarint(scratch + n, (int32_t)j.duty - p.duty);
+  }
+
+  if (size + n > capacity)
+  {
+    return false;
+  }
+
+  memcpy(buffer + size, scratch, n);
+  size += n;
+  buffer[1]++; // header count
+  previous = sample;
+  return true;
+}
+
+uint8_t TelemetryEncoder::getCount()
+{
+  return buffer[1];
+}
+
+size_t TelemetryEncoder::getSize()
+{
+  return size;
+}
+
+bool TelemetryDecoder::begin(const uint8_t *data, size_t len)
+{
+  struct_telemetry_header header;
+  if (len < sizeof(header))
+  {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.tag != TELEMETRY_TAG)
+  {
+    return false;
+  }
+
+  this->data = data;
+  this->len = len;
+  offset = sizeof(header);
+  remaining = header.count;
+  sequence = header.sequence;
+  memset(&previous, 0, sizeof(previous));
+  return true;
+}
+
+bool TelemetryDecoder::next(struct_telemetry_sample &sample)
+{
+  if (remaining == 0)
+  {
+    return false;
+  }
+
+  int32_t d[2 + 5 * TELEMETRY_JOINTS];
+  for (uint8_t i = 0; i < sizeof(d) / sizeof(d[0]); i++)
+  {
+    if (!getVarint(data, len, offset, d[i]))
+    {
+      remaining = 0; // truncated frame
+      return false;
+    }
+  }
+
+  sample.micros = previous.micros + (uint32_t)d[0];
+  sample.loopMicros = previous.loopMicros + d[1];
+  for (uint8_t i = 0; i < TELEMETRY_JOINTS; i++)
+  {
+    const int32_t *jd = d + 2 + 5 * i;
+    const struct_telemetry_joint &p = previous.joints[i];
+    sample.joints[i].position = p.position + jd[0];
+    sample.joints[i].velocity = p.velocity + jd[1];
+    sample.joints[i].setpoint = p.setpoint + jd[2];
+    sample.joints[i].output = p.output + jd[3];
+    sample.joints[i].duty = p.duty + jd[4];
+  }
+
+  previous = sample;
+  remaining--;
+  return true;
+}
+
+uint16_t TelemetryDecoder::getSequence()
+{
+  return sequence;
+}
@@ -0,0 +1,72 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Per-tick state of the leg, packed several samples per ESP-NOW frame.
+// Every field is delta-encoded against the previous sample in the same frame
+// as a zigzag varint, so a frame decodes on its own.
+
+const uint8_t TELEMETRY_TAG = 0xA7;
+const uint8_t TELEMETRY_JOINTS = 2; // 0 = right, 1 = left
+const size_t TELEMETRY_MAX_SAMPLE_SIZE = 5 * (2 + 5 * TELEMETRY_JOINTS);
+
+typedef struct struct_telemetry_joint
+{
+  int16_t position; // tenths of a degree
+  int16_t velocity; // degrees per second
+  int16_t setpoint; // tenths of a degree
+  int16_t output;   // PID output in PWM, -Robot::Pwm::RANGE..RANGE
+  int16_t duty;     // PWM duty written, positive = backward channel
+} struct_telemetry_joint;
+
+typedef struct struct_telemetry_sample
+{
+  uint32_t micros;     // timestamp of the PID compute
+  uint16_t loopMicros; // duration of the previous loop()
+  struct_telemetry_joint joints[TELEMETRY_JOINTS];
+} struct_telemetry_sample;
+
+typedef struct struct_telemetry_header
+{
+  uint8_t tag;
+  uint8_t count;     // samples in this frame
+  uint16_t sequence; // frame counter, gaps mean lost frames
+} struct_telemetry_header;
+
+class TelemetryEncoder
+{
+public:
+  // buffer must outlive the encoder, capacity includes the header
+  void begin(uint8_t *buffer, size_t capacity, uint16_t sequence);
+  // returns false, and leaves the frame untouched, if the sample does not fit
+  bool add(const struct_telemetry_sample &sample);
+  uint8_t getCount();
+  size_t getSize();
+
+private:
+  uint8_t *buffer;
+  size_t capacity;
+  size_t size;
+  struct_telemetry_sample previous;
+};
+
+class TelemetryDecoder
+{
+public:
+  // returns false if the data does not start with a telemetry header
+  bool begin(const uint8_t *data, size_t len);
+  bool next(struct_telemetry_sample &sample);
+  uint16_t getSequence();
+
+private:
+  const uint8_t *data;
+  size_t len;
+  size_t offset;
+  uint8_t remaining;
+  uint16_t sequence;
+  struct_telemetry_sample previous;
+};
+
+#endif
@@ -0,0 +1,191 @@
+#include <musicClock.h>
+
+#include <math.h>
+
+MusicClock::MusicClock()
+    : reference(0), changes(nullptr), count(0), next(0), start(0), anchor(0), anchorShow(0),
+      rate(1), mapRate(1), nudgeFactor(1), held(false), catching(false), catchUntil(0), tapped(false),
+      firstTap(0), firstTapBeat(0), lastTapBeat(0), version(0)
+{
+}
+
+void MusicClock::setTempoMap(float reference, const struct_tempo_change *changes, uint8_t count)
+{
+  this->reference = reference;
+  this->changes = changes;
+  this->count = reference > 0 ? count : 0;
+}
+
+void MusicClock::begin(uint32_t now, uint32_t position)
+{
+  start = now - position;
+  anchor = now;
+  anchorShow = now;
+  held = false;
+  catching = false;
+  tapped = false;
+
+  // the tempo at position, a seek is rare enough for a linear search
+  mapRate = 1;
+  next = 0;
+  while (next < count && changes[next].position <= position)
+  {
+    mapRate = changes[next].bpm / reference;
+    next++;
+  }
+  rate = reference > 0 ? mapRate * nudgeFactor : 1;
+  version++;
+}
+
+uint32_t MusicClock::showAt(uint32_t now)
+{
+  return anchorShow + (int32_t)lroundf((int32_t)(now - anchor) * rate);
+}
+
+void MusicClock::reanchor(uint32_t now, float rate)
+{
+  anchorShow = showAt(now);
+  anchor = now;
+  this->rate = rate;
+  version++;
+}
+
+uint32_t MusicClock::toShow(uint32_t now)
+{
+  if (catching && (int32_t)(now - catchUntil) >= 0)
+  {
+    catching = false;
+    reanchor(catchUntil, mapRate * nudgeFactor);
+  }
+
+  uint32_t show = showAt(now);
+  while (next < count && (int32_t)(show - start - changes[next].position) >= 0)
+  {
+    // continue from the change at its new tempo
+    uint32_t at = start + changes[next].position;
+    anchor += (int32_t)lroundf((int32_t)(at - anchorShow) / rate);
+    anchorShow = at;
+    mapRate = changes[next].bpm / reference;
+    rate = mapRate * nudgeFactor;
+    catching = false;
+    next++;
+    version++;
+    show = showAt(now);
+  }
+  return show;
+}
+
+void MusicClock::nudge(float bpm, uint32_t now)
+{
+  if (reference <= 0 || held)
+  {
+    return;
+  }
+  float tempo = reference * mapRate * nudgeFactor + bpm;
+  if (tempo <= 0)
+  {
+    return;
+  }
+  toShow(now);
+  nudgeFactor = tempo / (reference * mapRate);
+  catching = false;
+  reanchor(now, mapRate * nudgeFactor);
+}
+
+void MusicClock::tap(uint32_t now)
+{
+  if (reference <= 0 || held)
+  {
+    return;
+  }
+  uint32_t show = toShow(now);
+  float beat = 60000 / reference; // show ms
+  uint32_t position = show - start;
+  uint32_t nearest = lroundf(roundf(position / beat) * beat);
+
+  // a run of taps a few beats apart gives the tempo the musicians play at,
+  // measured from its first tap so the jitter of one tap averages out
+  float beats = roundf(((int32_t)(nearest - lastTapBeat)) / beat);
+  if (tapped && beats >= 1 && beats <= MAX_TAP_BEATS)
+  {
+    float runBeats = roundf(((int32_t)(nearest - firstTapBeat)) / beat);
+    int32_t interval = now - firstTap;
+    if (interval > 0)
+    {
+      nudgeFactor = runBeats * beat / interval / mapRate;
+    }
+  }
+  else
+  {
+    firstTap = now;
+    firstTapBeat = nearest;
+  }
+  tapped = true;
+  lastTapBeat = nearest;
+
+  // reach the beat after the nearest one in time with the music, rather than
+  // jumping to it
+  float tempoRate = mapRate * nudgeFactor;
+  uint32_t duration = lroundf(CATCH_UP_BEATS * beat / tempoRate);
+  uint32_t target = nearest + lroundf(CATCH_UP_BEATS * beat);
+  reanchor(now, (int32_t)(target - position) / (float)duration);
+  catching = true;
+  catchUntil = now + duration;
+}
+
+void MusicClock::resetNudge()
+{
+  nudgeFactor = 1;
+}
+
+void MusicClock::hold(uint32_t now, bool held)
+{
+  if (held == this->held)
+  {
+    return;
+  }
+  toShow(now);
+  this->held = held;
+  catching = false;
+  reanchor(now, held ? 0 : (reference > 0 ? mapRate * nudgeFactor : 1));
+}
+
+bool MusicClock::isHeld()
+{
+  return held;
+}
+
+void MusicClock::set(uint32_t now, uint32_t show, float rate)
+{
+  anchor = now;
+  anchorShow = show;
+  this->rate = rate;
+  catching = false;
+  count = 0;
+  version++;
+}
+
+float MusicClock::getTempo()
+{
+  return reference > 0 ? reference * rate : 0;
+}
+
+float MusicClock::getRate()
+{
+  return rate;
+}
+
+uint32_t MusicClock::getAnchor()
+{
+  return anchor;
+}
+
+uint32_t MusicClock::getAnchorShow()
+{
+  return anchorShow;
+}
+
+uint16_t MusicClock::getVersion()
+{
+  return version;
+}
@@ -0,0 +1,83 @@
+#ifndef MUSIC_CLOCK_H
+#define MUSIC_CLOCK_H
+
+#include <stdint.h>
+
+// From position on (ms into the music, at the reference tempo) the track
+// plays at bpm.
+typedef struct struct_tempo_change
+{
+  uint32_t position;
+  float bpm;
+} struct_tempo_change;
+
+// Maps millis() to show time, the clock a TimelinePlayer runs on, so keyframe
+// times are beats at a reference tempo rather than fixed ms. The mapping is
+// piecewise linear: the tempo map and the live adjustments only move the
+// anchor and change the rate, so toShow() is a multiply-add per tick.
+//
+// At begin() show time equals millis(), and stays equal as long as the
+// music plays at the reference tempo.
+class MusicClock
+{
+public:
+  static const uint16_t CATCH_UP_BEATS = 1; // a tap re-syncs over this many beats
+  static const uint16_t MAX_TAP_BEATS = 4;  // further apart starts a new run of taps
+
+  MusicClock();
+
+  // reference 0 = not music: the clock runs at 1 and ignores nudge and tap.
+  // changes must be sorted by position and outlive the clock.
+  void setTempoMap(float reference, const struct_tempo_change *changes = nullptr,
+                   uint8_t count = 0);
+  // the music is position ms in at now
+  void begin(uint32_t now, uint32_t position = 0);
+  // now must not go backwards, apart from around the anchor
+  uint32_t toShow(uint32_t now);
+
+  // live adjustments, kept from one begin() to the next
+  void nudge(float bpm, uint32_t now);
+  // the beat is at now: moves the show to the nearest beat over the next
+  // beat, and taps a beat or a few apart also set the tempo
+  void tap(uint32_t now);
+  void resetNudge();
+  // show time stands still while held, for any move
+  void hold(uint32_t now, bool held);
+  bool isHeld();
+
+  // as the remote's clock sent it, for followers without a tempo map
+  void set(uint32_t now, uint32_t show, float rate);
+
+  float getTempo(); // bpm played now, 0 when not music
+  float getRate();  // show ms per ms
+  uint32_t getAnchor();
+  uint32_t getAnchorShow();
+  // changes whenever the mapping does, to know when to send it
+  uint16_t getVersion();
+
+private:
+  float reference;
+  const struct_tempo_change *changes;
+  uint8_t count;
+  uint8_t next; // first change not reached
+
+  uint32_t start; // show time where the music is at 0
+  uint32_t anchor;
+  uint32_t anchorShow;
+  float rate;
+  float mapRate; // tempo map only
+  float nudgeFactor;
+  bool held;
+  bool catching;
+  uint32_t catchUntil;
+  bool tapped;
+  uint32_t firstTap;     // of the current run
+  uint32_t firstTapBeat; // ms into the music
+  uint32_t lastTapBeat;
+  uint16_t version;
+
+  uint32_t showAt(uint32_t now);
+  void reanchor(uint32_t now, float rate);
+};
+
+#endif
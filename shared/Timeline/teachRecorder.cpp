@@ -0,0 +1,321 @@
+#include <teachRecorder.h>
+#include <math.h>
+#include <stdlib.h>
+
+// a sample, 1 ms on and each leg within 7 counts, is a byte of two nibbles;
+// a high nibble of 8 marks the other tokens
+static const uint8_t TOKEN_REPEAT = 0x80;      // + n - 1, the last delta again n times, n <= 14
+static const uint8_t TOKEN_REPEAT_LONG = 0x8E; // varint n
+static const uint8_t TOKEN_SAMPLE = 0x8F;      // varint ms, zigzag varint right and left
+static const size_t MAX_SAMPLE_SIZE = 1 + 5 + 5 + 5;
+static const size_t MAX_REPEAT_SIZE = 1 + 5;
+
+static size_t putVarint(uint8_t *out, uint32_t v)
+{
+  size_t n = 0;
+  while (v >= 0x80)
+  {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+static uint32_t getVarint(const uint8_t *data, size_t &offset)
+{
+  uint32_t v = 0;
+  for (uint8_t shift = 0; shift < 35; shift += 7)
+  {
+    uint8_t b = data[offset++];
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80))
+    {
+      break;
+    }
+  }
+  return v;
+}
+
+static uint32_t zigzag(int32_t value)
+{
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t v)
+{
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// shortest way round, so a leg passing the sensor's zero does not jump a turn
+static int32_t countsDelta(uint16_t from, uint16_t to)
+{
+  int32_t delta = ((int32_t)to - from) & (TEACH_COUNTS - 1);
+  return delta >= TEACH_COUNTS / 2 ? delta - TEACH_COUNTS : delta;
+}
+
+static void setKeyframe(struct_keyframe &keyframe, uint32_t time, const float values[2], uint16_t kP)
+{
+  keyframe.time = time;
+  keyframe.rTarget = ((int32_t)values[0] % 360 + 360) % 360;
+  keyframe.lTarget = ((int32_t)values[1] % 360 + 360) % 360;
+  keyframe.kP = kP;
+  keyframe.interpolation = INTERP_LINEAR;
+  keyframe.reserved = 0;
+}
+
+// moves the anchor to where the segment ends, span ms on, on a line that fits
+// every sample since the anchor, as close to the last one as the doors allow
+static void endSegment(float anchor[2], float upper[2], float lower[2], float span,
+                       const float last[2])
+{
+  for (uint8_t j = 0; j < 2; j++)
+  {
+    float slope = fminf(fmaxf((last[j] - anchor[j]) / span, lower[j]), upper[j]);
+    anchor[j] = roundf(anchor[j] + slope * span);
+    upper[j] = INFINITY;
+    lower[j] = -INFINITY;
+  }
+}
+
+TeachRecorder::TeachRecorder(uint8_t *buffer, size_t capacity)
+    : buffer(buffer), capacity(capacity), size(0), full(true), samples(0), duration(0),
+      lastTime(0), repeats(0)
+{
+}
+
+void TeachRecorder::begin(uint32_t now, uint16_t rRaw, uint16_t lRaw)
+{
+  size = 0;
+  full = capacity < MAX_SAMPLE_SIZE + MAX_REPEAT_SIZE;
+  samples = 1;
+  duration = 0;
+  first[0] = last[0] = rRaw;
+  first[1] = last[1] = lRaw;
+  lastTime = now;
+  repeats = 0;
+}
+
+bool TeachRecorder::add(uint32_t now, uint16_t rRaw, uint16_t lRaw)
+{
+  if (full)
+  {
+    return false;
+  }
+
+  int32_t delta[3] = {(int32_t)(now - lastTime), countsDelta(last[0], rRaw),
+                      countsDelta(last[1], lRaw)};
+  if (samples > 1 && delta[0] == lastDelta[0] && delta[1] == lastDelta[1] &&
+      delta[2] == lastDelta[2])
+  {
+    repeats++; // the room for it is kept free
+  }
+  else
+  {
+    flush();
+    if (capacity - size < MAX_SAMPLE_SIZE + MAX_REPEAT_SIZE)
+    {
+      full = true;
+      return false;
+    }
+    if (delta[0] == 1 && abs(delta[1]) <= 7 && abs(delta[2]) <= 7)
+    {
+      buffer[size++] = (delta[1] & 0x0F) << 4 | (delta[2] & 0x0F);
+    }
+    else
+    {
+      buffer[size++] = TOKEN_SAMPLE;
+      size += putVarint(buffer + size, delta[0]);
+      size += putVarint(buffer + size, zigzag(delta[1]));
+      size += putVarint(buffer + size, zigzag(delta[2]));
+    }
+    lastDelta[0] = delta[0];
+    lastDelta[1] = delta[1];
+    lastDelta[2] = delta[2];
+  }
+
+  duration += delta[0];
+  last[0] = rRaw;
+  last[1] = lRaw;
+  lastTime = now;
+  samples++;
+  return true;
+}
+
+void TeachRecorder::end()
+{
+  flush();
+  full = true;
+}
+
+void TeachRecorder::flush()
+{
+  if (repeats > 14)
+  {
+    buffer[size++] = TOKEN_REPEAT_LONG;
+    size += putVarint(buffer + size, repeats);
+  }
+  else if (repeats)
+  {
+    buffer[size++] = TOKEN_REPEAT + repeats - 1;
+  }
+  repeats = 0;
+}
+
+uint16_t TeachRecorder::extract(const struct_teach_joint joints[2], float tolerance, uint16_t kP,
+                                struct_keyframe *keyframes, uint16_t capacity)
+{
+  if (!samples || tolerance <= 0.5f || !capacity || !full)
+  {
+    return 0; // not recorded, or still recording
+  }
+
+  // the line between two keyframes is within door of every sample, and
+  // rounding the end keyframe adds at most half a degree
+  float door = tolerance - 0.5f;
+
+  struct_teach_cursor cursor;
+  rewind(cursor);
+  float y[2];
+  float anchor[2];
+  for (uint8_t j = 0; j < 2; j++)
+  {
+    y[j] = fmodf(joints[j].offset + joints[j].scale * cursor.raw[j], 360);
+    y[j] += y[j] < 0 ? 360 : 0;
+    anchor[j] = roundf(y[j]);
+  }
+  // the samples only move relative to the first, without wrapping
+  float base[2] = {y[0] - joints[0].scale * cursor.raw[0],
+                   y[1] - joints[1].scale * cursor.raw[1]};
+
+  uint16_t count = 0;
+  setKeyframe(keyframes[count++], 0, anchor, kP);
+
+  uint32_t anchorTime = 0;
+  float upper[2] = {INFINITY, INFINITY};
+  float lower[2] = {-INFINITY, -INFINITY};
+  uint32_t previousTime = 0;
+  float previous[2] = {y[0], y[1]};
+
+  while (next(cursor))
+  {
+    uint32_t time = cursor.time;
+    y[0] = base[0] + joints[0].scale * cursor.raw[0];
+    y[1] = base[1] + joints[1].scale * cursor.raw[1];
+    if (time == anchorTime)
+    {
+      continue;
+    }
+
+    for (uint8_t attempt = 0; attempt < 2; attempt++)
+    {
+      float span = time - anchorTime;
+      float newUpper[2];
+      float newLower[2];
+      bool open = true;
+      for (uint8_t j = 0; j < 2; j++)
+      {
+        newUpper[j] = fminf(upper[j], (y[j] + door - anchor[j]) / span);
+        newLower[j] = fmaxf(lower[j], (y[j] - door - anchor[j]) / span);
+        open = open && newLower[j] <= newUpper[j];
+      }
+      if (open)
+      {
+        for (uint8_t j = 0; j < 2; j++)
+        {
+          upper[j] = newUpper[j];
+          lower[j] = newLower[j];
+        }
+        break;
+      }
+
+      // the door closed, the previous sample ends the segment
+      if (count == capacity)
+      {
+        return 0;
+      }
+      endSegment(anchor, upper, lower, previousTime - anchorTime, previous);
+      anchorTime = previousTime;
+      setKeyframe(keyframes[count++], anchorTime, anchor, kP);
+    }
+
+    previousTime = time;
+    previous[0] = y[0];
+    previous[1] = y[1];
+  }
+
+  if (previousTime != anchorTime)
+  {
+    if (count == capacity)
+    {
+      return 0;
+    }
+    endSegment(anchor, upper, lower, previousTime - anchorTime, previous);
+    setKeyframe(keyframes[count++], previousTime, anchor, kP);
+  }
+  return count;
+}
+
+void TeachRecorder::rewind(struct_teach_cursor &cursor)
+{
+  cursor.time = 0;
+  cursor.raw[0] = first[0];
+  cursor.raw[1] = first[1];
+  cursor.offset = 0;
+  cursor.repeats = 0;
+  cursor.delta[0] = cursor.delta[1] = cursor.delta[2] = 0;
+}
+
+bool TeachRecorder::next(struct_teach_cursor &cursor)
+{
+  if (!cursor.repeats)
+  {
+    if (cursor.offset >= size)
+    {
+      return false;
+    }
+    uint8_t token = buffer[cursor.offset++];
+    cursor.repeats = 1;
+    if (token >> 4 != 8)
+    {
+      cursor.delta[0] = 1;
+      cursor.delta[1] = (int8_t)(token & 0xF0) >> 4; // sign extended nibbles
+      cursor.delta[2] = (int8_t)(token << 4) >> 4;
+    }
+    else if (token == TOKEN_SAMPLE)
+    {
+      cursor.delta[0] = getVarint(buffer, cursor.offset);
+      cursor.delta[1] = unzigzag(getVarint(buffer, cursor.offset));
+      cursor.delta[2] = unzigzag(getVarint(buffer, cursor.offset));
+    }
+    else if (token == TOKEN_REPEAT_LONG)
+    {
+      cursor.repeats = getVarint(buffer, cursor.offset);
+    }
+    else
+    {
+      cursor.repeats = token - TOKEN_REPEAT + 1;
+    }
+  }
+
+  cursor.repeats--;
+  cursor.time += cursor.delta[0];
+  cursor.raw[0] += cursor.delta[1];
+  cursor.raw[1] += cursor.delta[2];
+  return true;
+}
+
+uint32_t TeachRecorder::getSamples()
+{
+  return samples;
+}
+
+uint32_t TeachRecorder::getDuration()
+{
+  return duration;
+}
+
+size_t TeachRecorder::getSize()
+{
+  return size;
+}
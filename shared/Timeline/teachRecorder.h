@@ -0,0 +1,84 @@
+#ifndef TEACH_RECORDER_H
+#define TEACH_RECORDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <timeline.h>
+
+// Records both encoders at control rate while the legs are moved by hand,
+// then turns the recording into keyframes.
+//
+// The raw counts are kept losslessly, delta and run-length encoded on the
+// fly: a sample 1 ms after the last that moved both legs by a few counts is
+// a byte, and a run of samples that moved the same (held still, or at a
+// steady speed) is one or two bytes for all of it.
+//
+// Keyframes come from a swinging door pass over the recording, which keeps a
+// segment going for as long as one straight line stays within the tolerance
+// of every sample on both legs. It streams, so the same recording can be
+// extracted again at another tolerance.
+
+const uint16_t TEACH_COUNTS = 4096; // per turn, the AS5600's
+
+// degrees = offset + scale * raw, wrapped to 0..360
+typedef struct struct_teach_joint
+{
+  float offset;
+  float scale; // negative for a mirrored joint
+} struct_teach_joint;
+
+// a place in a recording, see TeachRecorder::rewind()
+typedef struct struct_teach_cursor
+{
+  uint32_t time;    // ms since the first sample
+  int32_t raw[2];   // right, left counts, not wrapped: they go on past 4095 or below 0
+  size_t offset;    // into the recording
+  uint32_t repeats; // of delta, still to come
+  int32_t delta[3];
+} struct_teach_cursor;
+
+class TeachRecorder
+{
+public:
+  TeachRecorder(uint8_t *buffer, size_t capacity);
+
+  void begin(uint32_t now, uint16_t rRaw, uint16_t lRaw);
+  // returns false once the buffer is full, the recording then ends there
+  bool add(uint32_t now, uint16_t rRaw, uint16_t lRaw);
+  void end();
+
+  // linear keyframes that stay within tolerance degrees of every sample,
+  // including rounding to whole degrees; tolerance has to be above half a
+  // degree. Returns how many there are, 0 if they do not fit or there is no
+  // recording.
+  uint16_t extract(const struct_teach_joint joints[2], float tolerance, uint16_t kP,
+                   struct_keyframe *keyframes, uint16_t capacity);
+
+  // the samples of an ended recording as they were added: rewind() puts
+  // cursor on the first, next() moves it on and returns false after the last
+  void rewind(struct_teach_cursor &cursor);
+  bool next(struct_teach_cursor &cursor);
+
+  uint32_t getSamples();
+  uint32_t getDuration(); // ms
+  size_t getSize();       // bytes of the raw recording
+
+private:
+  uint8_t *buffer;
+  size_t capacity;
+  size_t size;
+  bool full;
+
+  uint32_t samples;
+  uint32_t duration;
+  uint16_t first[2];
+  uint16_t last[2];
+  uint32_t lastTime;
+
+  int32_t lastDelta[3]; // ms, right, left
+  uint32_t repeats;     // of lastDelta, not written yet
+
+  void flush();
+};
+
+#endif
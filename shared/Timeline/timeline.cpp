@@ -0,0 +1,268 @@
+#include <timeline.h>
+#include <timelineLibrary.h>
+
+TimelinePlayer::TimelinePlayer(TimelineLibrary &library, float targetScale)
+    : library(library), targetScale(targetScale), current(-1), startTime(0), cursor(0), hasOrigin(false), rampStart(0),
+      rampLength(0)
+{
+}
+
+void TimelinePlayer::start(int16_t index, uint32_t startTime)
+{
+  current = library.get(index, timeline) ? index : -1;
+  this->startTime = startTime;
+  cursor = 0;
+  hasOrigin = false;
+  rampLength = 0;
+}
+
+void TimelinePlayer::start(int16_t index, uint32_t startTime, const struct_timeline_state &from)
+{
+  start(index, startTime);
+  origin = from;
+  hasOrigin = true;
+}
+
+void TimelinePlayer::stop()
+{
+  current = -1;
+}
+
+void TimelinePlayer::seek(int16_t index, uint32_t position, uint32_t now,
+                          const struct_timeline_state &from, uint16_t rampMillis)
+{
+  current = library.get(index, timeline) ? index : -1;
+
+  // a position past the end is in a timeline further down the chain
+  while (current >= 0 && timeline.duration && timeline.next >= 0 && position >= timeline.duration)
+  {
+    if (timeline.next == current)
+    {
+      position %= timeline.duration; // a loop
+      break;
+    }
+    position -= timeline.duration;
+    current = library.get(timeline.next, timeline) ? timeline.next : -1;
+  }
+  if (current < 0)
+  {
+    return;
+  }
+
+  startTime = now - position;
+  cursor = findCursor(position);
+  origin = from;
+  hasOrigin = true;
+  rampFrom = from;
+  rampStart = now;
+  rampLength = rampMillis;
+}
+
+uint16_t TimelinePlayer::findCursor(uint32_t elapsed)
+{
+  // first keyframe after elapsed
+  uint16_t low = 0;
+  uint16_t high = timeline.count;
+  while (low < high)
+  {
+    uint16_t middle = (low + high) / 2;
+    if (timeline.keyframes[middle].time <= elapsed)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+bool TimelinePlayer::update(uint32_t now, struct_timeline_state &state)
+{
+  // a start time still ahead counts as not reached yet
+  if (current < 0 || (int32_t)(now - startTime) < 0)
+  {
+    return false;
+  }
+
+  // continue with the next timeline, keeping the phase of the chain exact
+  while (timeline.duration && timeline.next >= 0 && now - startTime >= timeline.duration)
+  {
+    startTime += timeline.duration;
+    current = timeline.next;
+    cursor = 0;
+    hasOrigin = false;
+    if (!library.get(current, timeline))
+    {
+      current = -1;
+      return false;
+    }
+  }
+
+  uint32_t elapsed = now - startTime;
+  while (cursor < timeline.count && timeline.keyframes[cursor].time <= elapsed)
+  {
+    cursor++;
+  }
+
+  bool approaching = cursor < timeline.count &&
+                     timeline.keyframes[cursor].interpolation != INTERP_STEP;
+  if (cursor == 0 && !(approaching && hasOrigin))
+  {
+    return false;
+  }
+
+  evaluate(elapsed, state);
+
+  if (rampLength)
+  {
+    // before rampStart, e.g. a seek with a lead time, holds the pose it came from
+    int32_t ramped = now - rampStart;
+    if (ramped >= rampLength)
+    {
+      rampLength = 0;
+    }
+    else
+    {
+      float u = ramped > 0 ? (float)ramped / rampLength : 0;
+      state.rTarget = interpolate(INTERP_EASE, rampFrom.rTarget, state.rTarget, u);
+      state.lTarget = interpolate(INTERP_EASE, rampFrom.lTarget, state.lTarget, u);
+      state.kP = interpolate(INTERP_EASE, rampFrom.kP, state.kP, u);
+    }
+  }
+  return true;
+}
+
+static float slope(const struct_keyframe &a, const struct_keyframe &b, uint8_t field)
+{
+  return (keyframeValue(b, field) - keyframeValue(a, field)) / (float)(b.time - a.time);
+}
+
+// Tangent at keyframe i in units per ms, from the weighted harmonic mean of
+// the neighbouring slopes (as in PCHIP). Zero at extremes and at the ends, so
+// a hermite segment never leaves the range of its two keyframes.
+static float tangent(const struct_timeline &timeline, uint16_t i, uint8_t field)
+{
+  if (i == 0 || i + 1 >= timeline.count)
+  {
+    return 0;
+  }
+
+  const struct_keyframe &a = timeline.keyframes[i - 1];
+  const struct_keyframe &b = timeline.keyframes[i];
+  const struct_keyframe &c = timeline.keyframes[i + 1];
+  if (b.time == a.time || c.time == b.time)
+  {
+    return 0;
+  }
+
+  float d0 = slope(a, b, field);
+  float d1 = slope(b, c, field);
+  if (d0 * d1 <= 0)
+  {
+    return 0;
+  }
+
+  float h0 = b.time - a.time;
+  float h1 = c.time - b.time;
+  float w0 = 2 * h1 + h0;
+  float w1 = h1 + 2 * h0;
+  return (w0 + w1) / (w0 / d0 + w1 / d1);
+}
+
+float TimelinePlayer::scale(uint8_t field)
+{
+  return field < 2 ? targetScale : 1;
+}
+
+void TimelinePlayer::evaluate(uint32_t elapsed, struct_timeline_state &state)
+{
+  float values[3];
+
+  if (cursor == timeline.count || timeline.keyframes[cursor].interpolation == INTERP_STEP)
+  {
+    // holding the last keyframe that has passed
+    const struct_keyframe &keyframe = timeline.keyframes[cursor - 1];
+    for (uint8_t field = 0; field < 3; field++)
+    {
+      values[field] = keyframeValue(keyframe, field) * scale(field);
+    }
+  }
+  else
+  {
+    const struct_keyframe &to = timeline.keyframes[cursor];
+    uint32_t fromTime = cursor ? timeline.keyframes[cursor - 1].time : 0;
+    float fromValues[3] = {origin.rTarget, origin.lTarget, origin.kP};
+    if (cursor)
+    {
+      for (uint8_t field = 0; field < 3; field++)
+      {
+        fromValues[field] = keyframeValue(timeline.keyframes[cursor - 1], field) * scale(field);
+      }
+    }
+
+    float span = to.time - fromTime;
+    float u = span > 0 ? (elapsed - fromTime) / span : 1;
+
+    for (uint8_t field = 0; field < 3; field++)
+    {
+      float a = fromValues[field];
+      float b = keyframeValue(to, field) * scale(field);
+
+      if (to.interpolation != INTERP_HERMITE)
+      {
+        values[field] = interpolate(to.interpolation, a, b, u);
+        continue;
+      }
+
+      float ma = cursor ? tangent(timeline, cursor - 1, field) * scale(field) * span : 0;
+      float mb = tangent(timeline, cursor, field) * scale(field) * span;
+      float u2 = u * u;
+      float u3 = u2 * u;
+      values[field] = a + (b - a) * (3 * u2 - 2 * u3) + ma * (u3 - 2 * u2 + u) + mb * (u3 - u2);
+    }
+  }
+
+  state.rTarget = values[0];
+  state.lTarget = values[1];
+  state.kP = values[2];
+}
+
+int16_t TimelinePlayer::getCurrent()
+{
+  return current;
+}
+
+uint32_t TimelinePlayer::getPosition(uint32_t now)
+{
+  return current >= 0 && (int32_t)(now - startTime) > 0 ? now - startTime : 0;
+}
+
+float keyframeValue(const struct_keyframe &keyframe, uint8_t field)
+{
+  switch (field)
+  {
+  case 0:
+    return keyframe.rTarget;
+  case 1:
+    return keyframe.lTarget;
+  default:
+    return keyframe.kP / 100.f;
+  }
+}
+
+float interpolate(uint8_t interpolation, float from, float to, float u)
+{
+  switch (interpolation)
+  {
+  case INTERP_STEP:
+    return u < 1 ? from : to;
+  case INTERP_EASE:
+    u = u * u * (3 - 2 * u);
+    break;
+  default:
+    break;
+  }
+  return from + (to - from) * u;
+}
@@ -0,0 +1,103 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdint.h>
+
+// A choreography is a table of keyframes sorted by time. The player keeps a
+// cursor into the table, so finding the current keyframe costs O(1) per tick
+// no matter how long the sequence is.
+
+// How a keyframe is approached from the one before it. Anything but step
+// starts moving at the previous keyframe's time and arrives at this one's.
+enum Interpolation : uint8_t
+{
+  INTERP_STEP,    // jump to the keyframe at its time
+  INTERP_LINEAR,  // constant speed
+  INTERP_HERMITE, // cubic through the neighbours, velocity continuous, never overshoots
+  INTERP_EASE,    // cubic ease-in/out, starts and stops at rest
+};
+
+typedef struct struct_keyframe
+{
+  uint32_t time;    // ms since the start of the timeline
+  uint16_t rTarget; // degrees
+  uint16_t lTarget; // degrees
+  uint16_t kP;      // hundredths
+  uint8_t interpolation;
+  uint8_t reserved;
+} struct_keyframe;
+
+typedef struct struct_timeline
+{
+  const char *name;
+  const struct_keyframe *keyframes;
+  uint16_t count;
+  uint32_t duration; // after this many ms continue with next, 0 = hold the last keyframe
+  int16_t next;      // index in the same library, -1 = none
+} struct_timeline;
+
+typedef struct struct_timeline_state
+{
+  float rTarget; // degrees, times the player's target scale
+  float lTarget; // degrees, times the player's target scale
+  float kP;
+} struct_timeline_state;
+
+#define KEYFRAME_COUNT(keyframes) (sizeof(keyframes) / sizeof(struct_keyframe))
+
+const uint16_t TIMELINE_SEEK_RAMP = 500; // ms from the current pose into a seek
+
+class TimelineLibrary;
+
+class TimelinePlayer
+{
+public:
+  // targetScale multiplies the keyframes' degrees, so the targets come out,
+  // and the poses passed in are, in whatever unit the caller controls in
+  TimelinePlayer(TimelineLibrary &library, float targetScale = 1);
+
+  void start(int16_t index, uint32_t startTime);
+  // as above, interpolating from the given pose if the first keyframe is not
+  // a step
+  void start(int16_t index, uint32_t startTime, const struct_timeline_state &from);
+  void stop();
+
+  // jumps to position ms into the timeline, or into the ones it continues
+  // with, using a binary search over the keyframes. The targets ease from
+  // the given pose into the timeline's over rampMillis, so the legs do not jerk.
+  void seek(int16_t index, uint32_t position, uint32_t now, const struct_timeline_state &from,
+            uint16_t rampMillis = TIMELINE_SEEK_RAMP);
+
+  // writes the state at now, returns false if nothing is playing or the start
+  // or first keyframe has not been reached yet (the previous pose is held until then)
+  bool update(uint32_t now, struct_timeline_state &state);
+
+  int16_t getCurrent();
+  // ms into the current timeline
+  uint32_t getPosition(uint32_t now);
+
+private:
+  TimelineLibrary &library;
+  float targetScale;
+  struct_timeline timeline; // copy of the current one
+  int16_t current;
+  uint32_t startTime;
+  uint16_t cursor;
+  bool hasOrigin;
+  struct_timeline_state origin;
+  uint32_t rampStart;
+  uint16_t rampLength; // 0 = not ramping
+  struct_timeline_state rampFrom;
+
+  uint16_t findCursor(uint32_t elapsed);
+  float scale(uint8_t field);
+  void evaluate(uint32_t elapsed, struct_timeline_state &state);
+};
+
+// value of one field of a keyframe: 0 = right, 1 = left, 2 = kP
+float keyframeValue(const struct_keyframe &keyframe, uint8_t field);
+
+// shapes a fraction 0..1 of a segment, for step, linear and ease
+float interpolate(uint8_t interpolation, float from, float to, float u);
+
+#endif
@@ -0,0 +1,177 @@
+#include <timelineLibrary.h>
+#include <string.h>
+
+uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc)
+{
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++)
+  {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+  }
+  return ~crc;
+}
+
+bool readTimelineImageHeader(const uint8_t *image, size_t len, struct_timeline_image_header &header)
+{
+  if (len < sizeof(header))
+  {
+    return false;
+  }
+  memcpy(&header, image, sizeof(header));
+  return header.magic == TIMELINE_IMAGE_MAGIC && header.version == TIMELINE_IMAGE_VERSION;
+}
+
+TimelineLibrary::TimelineLibrary() : timelines(nullptr), size(0), image(nullptr)
+{
+}
+
+TimelineLibrary::TimelineLibrary(const struct_timeline *timelines, uint16_t size)
+    : timelines(timelines), size(size), image(nullptr)
+{
+}
+
+bool TimelineLibrary::load(const uint8_t *image, size_t len)
+{
+  struct_timeline_image_header header;
+  if (!readTimelineImageHeader(image, len, header) || header.size > len)
+  {
+    return false;
+  }
+
+  // the counts come from the image, bound them by its length before they
+  // are multiplied, a 32 bit size_t would wrap
+  size_t entriesSize = header.timelineCount * sizeof(struct_timeline_image_entry);
+  if (entriesSize > len - sizeof(header) ||
+      header.keyframeCount > (len - sizeof(header) - entriesSize) / sizeof(struct_keyframe))
+  {
+    return false;
+  }
+
+  size_t expected = sizeof(header) + entriesSize + header.keyframeCount * sizeof(struct_keyframe);
+  if (header.size != expected ||
+      crc32(image + sizeof(header), header.size - sizeof(header)) != header.crc)
+  {
+    return false;
+  }
+
+  const struct_timeline_image_entry *entries =
+      (const struct_timeline_image_entry *)(image + sizeof(header));
+  for (uint16_t i = 0; i < header.timelineCount; i++)
+  {
+    const struct_timeline_image_entry &entry = entries[i];
+    if (entry.firstKeyframe > header.keyframeCount ||
+        entry.count > header.keyframeCount - entry.firstKeyframe ||
+        entry.next < -1 || entry.next >= (int16_t)header.timelineCount ||
+        memchr(entry.name, 0, TIMELINE_NAME_LEN) == nullptr)
+    {
+      return false;
+    }
+  }
+
+  this->image = image;
+  timelines = nullptr;
+  size = header.timelineCount;
+  return true;
+}
+
+void TimelineLibrary::clear()
+{
+  image = nullptr;
+  timelines = nullptr;
+  size = 0;
+}
+
+uint16_t TimelineLibrary::getSize()
+{
+  return size;
+}
+
+bool TimelineLibrary::get(int16_t index, struct_timeline &timeline)
+{
+  if (index < 0 || index >= size)
+  {
+    return false;
+  }
+
+  if (!image)
+  {
+    timeline = timelines[index];
+    return true;
+  }
+
+  const struct_timeline_image_entry *entries =
+      (const struct_timeline_image_entry *)(image + sizeof(struct_timeline_image_header));
+  const struct_keyframe *keyframes = (const struct_keyframe *)(entries + size);
+  const struct_timeline_image_entry &entry = entries[index];
+
+  timeline.name = entry.name;
+  timeline.keyframes = keyframes + entry.firstKeyframe;
+  timeline.count = entry.count;
+  timeline.duration = entry.duration;
+  timeline.next = entry.next;
+  return true;
+}
+
+int16_t TimelineLibrary::find(const char *name)
+{
+  struct_timeline timeline;
+  for (int16_t i = 0; i < size; i++)
+  {
+    if (get(i, timeline) && timeline.name && strcmp(timeline.name, name) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+size_t TimelineLibrary::encode(uint8_t *out, size_t capacity)
+{
+  struct_timeline_image_header header = {TIMELINE_IMAGE_MAGIC, TIMELINE_IMAGE_VERSION, size, 0, 0, 0};
+
+  struct_timeline timeline;
+  for (uint16_t i = 0; i < size; i++)
+  {
+    get(i, timeline);
+    header.keyframeCount += timeline.count;
+  }
+  header.size = sizeof(header) + size * sizeof(struct_timeline_image_entry) +
+                header.keyframeCount * sizeof(struct_keyframe);
+  if (header.size > capacity)
+  {
+    return 0;
+  }
+
+  struct_timeline_image_entry *entries = (struct_timeline_image_entry *)(out + sizeof(header));
+  struct_keyframe *keyframes = (struct_keyframe *)(entries + size);
+  uint32_t firstKeyframe = 0;
+
+  for (uint16_t i = 0; i < size; i++)
+  {
+    get(i, timeline);
+    struct_timeline_image_entry entry = {};
+    if (timeline.name)
+    {
+      strncpy(entry.name, timeline.name, TIMELINE_NAME_LEN - 1);
+    }
+    entry.firstKeyframe = firstKeyframe;
+    entry.duration = timeline.duration;
+    entry.count = timeline.count;
+    entry.next = timeline.next;
+    memcpy(&entries[i], &entry, sizeof(entry));
+
+    if (timeline.count)
+    {
+      memcpy(keyframes + firstKeyframe, timeline.keyframes, timeline.count * sizeof(struct_keyframe));
+      firstKeyframe += timeline.count;
+    }
+  }
+
+  header.crc = crc32(out + sizeof(header), header.size - sizeof(header));
+  memcpy(out, &header, sizeof(header));
+  return header.size;
+}
@@ -0,0 +1,70 @@
+#ifndef TIMELINE_LIBRARY_H
+#define TIMELINE_LIBRARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <timeline.h>
+
+// A set of timelines, indexed by number, either built-in arrays or a binary
+// image read in place (a buffer filled over the radio, a flash partition...).
+//
+// Image layout, little endian:
+//   struct_timeline_image_header
+//   struct_timeline_image_entry[timelineCount]
+//   struct_keyframe[keyframeCount]
+// crc is the CRC-32 of everything after the header.
+
+const uint32_t TIMELINE_IMAGE_MAGIC = 0x54524341; // "ACRT"
+const uint16_t TIMELINE_IMAGE_VERSION = 1;
+const uint8_t TIMELINE_NAME_LEN = 20;
+
+typedef struct struct_timeline_image_header
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t timelineCount;
+  uint32_t keyframeCount;
+  uint32_t size; // whole image, header included
+  uint32_t crc;
+} struct_timeline_image_header;
+
+typedef struct struct_timeline_image_entry
+{
+  char name[TIMELINE_NAME_LEN]; // zero terminated
+  uint32_t firstKeyframe;
+  uint32_t duration;
+  uint16_t count;
+  int16_t next;
+} struct_timeline_image_entry;
+
+class TimelineLibrary
+{
+public:
+  TimelineLibrary();
+  TimelineLibrary(const struct_timeline *timelines, uint16_t size);
+
+  // checks and uses the image in place, it has to be 4-byte aligned and stay
+  // unchanged; returns false, and keeps the previous contents, if it is malformed
+  bool load(const uint8_t *image, size_t len);
+  void clear();
+
+  uint16_t getSize();
+  bool get(int16_t index, struct_timeline &timeline);
+  int16_t find(const char *name);
+
+  // writes the library as an image, returns its size or 0 if it does not fit
+  size_t encode(uint8_t *out, size_t capacity);
+
+private:
+  const struct_timeline *timelines;
+  uint16_t size;
+  const uint8_t *image;
+};
+
+uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0);
+
+// header of an image, false if it is too short or not an image
+bool readTimelineImageHeader(const uint8_t *image, size_t len, struct_timeline_image_header &header);
+
+#endif
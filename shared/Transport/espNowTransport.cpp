@@ -0,0 +1,62 @@
+#ifdef ARDUINO
+
+#include <espNowTransport.h>
+#include <WiFi.h>
+
+TransportReceiveCallback EspNowTransport::receiveCallback = nullptr;
+TransportSendCallback EspNowTransport::sendCallback = nullptr;
+
+bool EspNowTransport::begin()
+{
+  WiFi.mode(WIFI_STA);
+  if (esp_now_init() != ESP_OK)
+  {
+    return false;
+  }
+
+  esp_now_register_send_cb(espNowSent);
+  esp_now_register_recv_cb(espNowReceive);
+  return true;
+}
+
+bool EspNowTransport::addPeer(const uint8_t *mac)
+{
+  esp_now_peer_info_t peerInfo = {};
+  memcpy(peerInfo.peer_addr, mac, TRANSPORT_MAC_LEN);
+  peerInfo.channel = 0;
+  peerInfo.encrypt = false;
+  return esp_now_add_peer(&peerInfo) == ESP_OK;
+}
+
+bool EspNowTransport::send(const uint8_t *mac, const uint8_t *data, size_t len)
+{
+  return esp_now_send(mac, data, len) == ESP_OK;
+}
+
+void EspNowTransport::onReceive(TransportReceiveCallback callback)
+{
+  receiveCallback = callback;
+}
+
+void EspNowTransport::onSent(TransportSendCallback callback)
+{
+  sendCallback = callback;
+}
+
+void EspNowTransport::espNowReceive(const uint8_t *mac, const uint8_t *data, int len)
+{
+  if (receiveCallback)
+  {
+    receiveCallback(mac, data, len);
+  }
+}
+
+void EspNowTransport::espNowSent(const uint8_t *mac, esp_now_send_status_t status)
+{
+  if (sendCallback)
+  {
+    sendCallback(mac, status == ESP_NOW_SEND_SUCCESS);
+  }
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef ESP_NOW_TRANSPORT_H
+#define ESP_NOW_TRANSPORT_H
+
+#ifdef ARDUINO
+
+#include <transport.h>
+#include <esp_now.h>
+
+// ESP-NOW has a single set of callbacks per chip, so only one of these
+// should exist.
+class EspNowTransport : public Transport
+{
+public:
+  bool begin() override;
+  bool addPeer(const uint8_t *mac) override;
+  bool send(const uint8_t *mac, const uint8_t *data, size_t len) override;
+  void onReceive(TransportReceiveCallback callback) override;
+  void onSent(TransportSendCallback callback) override;
+
+private:
+  static TransportReceiveCallback receiveCallback;
+  static TransportSendCallback sendCallback;
+
+  static void espNowReceive(const uint8_t *mac, const uint8_t *data, int len);
+  static void espNowSent(const uint8_t *mac, esp_now_send_status_t status);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+const uint8_t TRANSPORT_MAC_LEN = 6;
+const size_t TRANSPORT_MAX_DATA_LEN = 250; // same as ESP_NOW_MAX_DATA_LEN
+
+typedef void (*TransportReceiveCallback)(const uint8_t *mac, const uint8_t *data, int len);
+typedef void (*TransportSendCallback)(const uint8_t *mac, bool success);
+
+// Peer-to-peer datagram link between the leg and the remote. The firmwares
+// use EspNowTransport, the host tools UdpTransport.
+class Transport
+{
+public:
+  virtual ~Transport() {}
+
+  virtual bool begin() = 0;
+  virtual bool addPeer(const uint8_t *mac) = 0;
+  virtual bool send(const uint8_t *mac, const uint8_t *data, size_t len) = 0;
+
+  // callbacks may run on another task, keep them short
+  virtual void onReceive(TransportReceiveCallback callback) = 0;
+  virtual void onSent(TransportSendCallback callback) = 0;
+
+  // transports without their own task deliver callbacks from here
+  virtual void poll() {}
+};
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef ARDUINO
+
+#include <udpTransport.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+UdpTransport::UdpTransport(const uint8_t *ownMac, UdpImpairments impairments)
+    : impairments(impairments), socketFd(-1), sequence(0), hasLastSequence(false),
+      lastSequence(0), random(impairments.seed), receiveCallback(nullptr),
+      sendCallback(nullptr)
+{
+  memcpy(this->ownMac, ownMac, TRANSPORT_MAC_LEN);
+}
+
+UdpTransport::~UdpTransport()
+{
+  if (socketFd >= 0)
+  {
+    close(socketFd);
+  }
+}
+
+uint16_t UdpTransport::portFor(const uint8_t *mac)
+{
+  return BASE_PORT + ((mac[4] << 8 | mac[5]) % 10000);
+}
+
+uint64_t UdpTransport::nowMicros()
+{
+  using namespace std::chrono;
+  return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+bool UdpTransport::begin()
+{
+  socketFd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (socketFd < 0)
+  {
+    return false;
+  }
+
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(portFor(ownMac));
+  if (bind(socketFd, (sockaddr *)&address, sizeof(address)) != 0)
+  {
+    close(socketFd);
+    socketFd = -1;
+    return false;
+  }
+
+  fcntl(socketFd, F_SETFL, fcntl(socketFd, F_GETFL) | O_NONBLOCK);
+  return true;
+}
+
+bool UdpTransport::addPeer(const uint8_t *mac)
+{
+  if (!isPeer(mac))
+  {
+    peers.emplace_back(mac, mac + TRANSPORT_MAC_LEN);
+  }
+  return true;
+}
+
+bool UdpTransport::isPeer(const uint8_t *mac)
+{
+  for (const std::vector<uint8_t> &peer : peers)
+  {
+    if (memcmp(peer.data(), mac, TRANSPORT_MAC_LEN) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool UdpTransport::send(const uint8_t *mac, const uint8_t *data, size_t len)
+{
+  // same contract as esp_now_send: unknown peers and oversized packets fail
+  // right away, everything else reports through the sent callback
+  if (socketFd < 0 || !isPeer(mac) || len > TRANSPORT_MAX_DATA_LEN)
+  {
+    return false;
+  }
+
+  Header header;
+  memcpy(header.mac, ownMac, TRANSPORT_MAC_LEN);
+  header.len = len;
+  header.sequence = sequence++;
+  header.sentMicros = nowMicros();
+
+  Pending p;
+  memcpy(p.peer, mac, TRANSPORT_MAC_LEN);
+  p.packet.resize(sizeof(header) + len);
+  memcpy(p.packet.data(), &header, sizeof(header));
+  memcpy(p.packet.data() + sizeof(header), data, len);
+
+  std::uniform_real_distribution<double> percent(0, 100);
+  p.delivered = percent(random) >= impairments.lossPercent;
+  p.dueMicros = header.sentMicros + impairments.latencyMicros;
+  if (impairments.jitterMicros)
+  {
+    p.dueMicros += random() % impairments.jitterMicros;
+  }
+  if (percent(random) < impairments.reorderPercent)
+  {
+    p.dueMicros += impairments.reorderMicros;
+  }
+
+  stats.sent++;
+  if (!p.delivered)
+  {
+    stats.dropped++;
+  }
+  pending.push_back(std::move(p));
+  return true;
+}
+
+void UdpTransport::onReceive(TransportReceiveCallback callback)
+{
+  receiveCallback = callback;
+}
+
+void UdpTransport::onSent(TransportSendCallback callback)
+{
+  sendCallback = callback;
+}
+
+void UdpTransport::poll()
+{
+  flushPending();
+  receiveAll();
+}
+
+void UdpTransport::flushPending()
+{
+  uint64_t now = nowMicros();
+
+  // due packets leave in due-time order, which is where reordering happens
+  std::stable_sort(pending.begin(), pending.end(),
+                   [](const Pending &a, const Pending &b) { return a.dueMicros < b.dueMicros; });
+
+  size_t n = 0;
+  while (n < pending.size() && pending[n].dueMicros <= now)
+  {
+    Pending &p = pending[n];
+    if (p.delivered)
+    {
+      sockaddr_in address = {};
+      address.sin_family = AF_INET;
+      address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      address.sin_port = htons(portFor(p.peer));
+      sendto(socketFd, p.packet.data(), p.packet.size(), 0, (sockaddr *)&address, sizeof(address));
+    }
+    if (sendCallback)
+    {
+      sendCallback(p.peer, p.delivered);
+    }
+    n++;
+  }
+  pending.erase(pending.begin(), pending.begin() + n);
+}
+
+void UdpTransport::receiveAll()
+{
+  uint8_t buffer[sizeof(Header) + TRANSPORT_MAX_DATA_LEN];
+  ssize_t n;
+  while ((n = recv(socketFd, buffer, sizeof(buffer), 0)) > 0)
+  {
+    Header header;
+    if ((size_t)n < sizeof(header))
+    {
+      continue;
+    }
+    memcpy(&header, buffer, sizeof(header));
+    if (header.len != n - sizeof(header))
+    {
+      continue;
+    }
+
+    uint32_t latency = nowMicros() - header.sentMicros;
+    stats.received++;
+    stats.receivedBytes += header.len;
+    stats.latencyMicrosTotal += latency;
+    stats.latencyMicrosMax = std::max(stats.latencyMicrosMax, latency);
+
+    if (hasLastSequence)
+    {
+      int32_t diff = (int32_t)(header.sequence - lastSequence);
+      if (diff < 0)
+      {
+        stats.reordered++;
+        if (stats.missing)
+        {
+          stats.missing--; // counted as a gap when the later one arrived
+        }
+      }
+      else
+      {
+        stats.missing += diff - 1;
+        lastSequence = header.sequence;
+      }
+    }
+    else
+    {
+      lastSequence = header.sequence;
+      hasLastSequence = true;
+    }
+
+    if (receiveCallback)
+    {
+      receiveCallback(header.mac, buffer + sizeof(header), header.len);
+    }
+  }
+}
+
+const UdpStats &UdpTransport::getStats()
+{
+  return stats;
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef UDP_TRANSPORT_H
+#define UDP_TRANSPORT_H
+
+#ifndef ARDUINO
+
+#include <transport.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Stand-in for ESP-NOW between processes on one machine. Every MAC maps to a
+// loopback UDP port, and outgoing packets can be dropped, delayed, jittered
+// and reordered. Callbacks are delivered from poll().
+struct UdpImpairments
+{
+  double lossPercent = 0;
+  uint32_t latencyMicros = 0;
+  uint32_t jitterMicros = 0;  // uniform extra delay, reorders packets naturally
+  double reorderPercent = 0;  // chance a packet is held back behind the next ones
+  uint32_t reorderMicros = 3000;
+  uint32_t seed = 1;
+};
+
+struct UdpStats
+{
+  uint64_t sent = 0;
+  uint64_t dropped = 0;
+  uint64_t received = 0;
+  uint64_t receivedBytes = 0;
+  uint64_t reordered = 0;  // arrived with a lower sequence than one before
+  uint64_t missing = 0;    // sequence gaps seen by the receiver
+  uint64_t latencyMicrosTotal = 0;
+  uint32_t latencyMicrosMax = 0;
+};
+
+class UdpTransport : public Transport
+{
+public:
+  static const uint16_t BASE_PORT = 47000;
+
+  UdpTransport(const uint8_t *ownMac, UdpImpairments impairments = UdpImpairments());
+  ~UdpTransport();
+
+  bool begin() override;
+  bool addPeer(const uint8_t *mac) override;
+  bool send(const uint8_t *mac, const uint8_t *data, size_t len) override;
+  void onReceive(TransportReceiveCallback callback) override;
+  void onSent(TransportSendCallback callback) override;
+  void poll() override;
+
+  const UdpStats &getStats();
+
+  static uint16_t portFor(const uint8_t *mac);
+
+private:
+  struct Header
+  {
+    uint8_t mac[TRANSPORT_MAC_LEN];
+    uint16_t len;
+    uint32_t sequence;
+    uint64_t sentMicros;
+  };
+
+  struct Pending
+  {
+    uint64_t dueMicros;
+    uint8_t peer[TRANSPORT_MAC_LEN];
+    bool delivered;
+    std::vector<uint8_t> packet;
+  };
+
+  uint8_t ownMac[TRANSPORT_MAC_LEN];
+  UdpImpairments impairments;
+  UdpStats stats;
+  int socketFd;
+  uint32_t sequence;
+  bool hasLastSequence;
+  uint32_t lastSequence;
+  std::vector<Pending> pending;
+  std::vector<std::vector<uint8_t>> peers;
+  std::mt19937 random;
+  TransportReceiveCallback receiveCallback;
+  TransportSendCallback sendCallback;
+
+  static uint64_t nowMicros();
+  bool isPeer(const uint8_t *mac);
+  void flushPending();
+  void receiveAll();
+};
+
+#endif
+
+#endif